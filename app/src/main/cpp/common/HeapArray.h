@@ -160,7 +160,7 @@ public:
 	using const_reference = const T&;
 	using pointer = T*;
 	using const_pointer = const T*;
-	using this_type = DynamicHeapArray<T>;
+	using this_type = DynamicHeapArray<T, alignment>;
 
 	DynamicHeapArray()
 		: m_data(nullptr)
@@ -11,9 +11,13 @@
 #include "pcsx2/GS.h"
 #include "pcsx2/VMManager.h"
 #include "CDVD/CDVD.h"
+#include "CDVD/IsoFileFormats.h"
+#include "CDVD/IsoHasher.h"
 #include "PerformanceMetrics.h"
 #include "GameList.h"
+#include "GS/GSBlockBenchmark.h"
 #include "GS/GSPerfMon.h"
+#include "GSDumpBenchmark.h"
 #include "GSDumpReplayer.h"
 #include "ImGui/ImGuiManager.h"
 #include "common/Path.h"
@@ -1237,6 +1241,134 @@ Java_com_izzy2lost_psx2_NativeApp_runVMThread(JNIEnv *env, jclass clazz,
     return true;
 }
 
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_izzy2lost_psx2_NativeApp_runGSDumpBenchmark(JNIEnv *env, jclass clazz,
+                                                        jstring p_dump_dir, jstring p_output_dir,
+                                                        jstring p_baseline, jfloat p_threshold) {
+    GSDumpBenchmark::Options options;
+    options.dump_directory = GetJavaString(env, p_dump_dir);
+    options.output_directory = GetJavaString(env, p_output_dir);
+    options.baseline_path = GetJavaString(env, p_baseline);
+    options.threshold_percent = p_threshold;
+
+    if (VMManager::HasValidVM()) {
+        Console.Warning("VM still running from previous session, shutting down...");
+        VMManager::Shutdown(false);
+    }
+
+    if (!VMManager::Internal::CPUThreadInitialize()) {
+        Console.Error("CPUThreadInitialize failed");
+        VMManager::Internal::CPUThreadShutdown();
+        return false;
+    }
+
+    Error error;
+    const bool result = GSDumpBenchmark::Run(options, &error);
+    if (!result)
+        Console.ErrorFmt("GS dump benchmark failed: {}", error.GetDescription());
+
+    VMManager::Internal::CPUThreadShutdown();
+    return result;
+}
+
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_izzy2lost_psx2_NativeApp_runGSBlockBenchmark(JNIEnv *env, jclass clazz,
+                                                        jstring p_output_dir, jstring p_baseline, jfloat p_threshold) {
+    GSBlockBenchmarkOptions options;
+    options.output_directory = GetJavaString(env, p_output_dir);
+    options.baseline_path = GetJavaString(env, p_baseline);
+    options.threshold_percent = p_threshold;
+
+    Error error;
+    const bool result = MULTI_ISA_SELECT(RunGSBlockBenchmark)(options, &error);
+    if (!result)
+        Console.ErrorFmt("GS block benchmark failed: {}", error.GetDescription());
+
+    return result;
+}
+
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_izzy2lost_psx2_NativeApp_runCdvdTraceReplay(JNIEnv *env, jclass clazz,
+                                                        jstring p_iso_path, jstring p_trace_path) {
+    const std::string iso_path = GetJavaString(env, p_iso_path);
+    const std::string trace_path = GetJavaString(env, p_trace_path);
+
+    if (VMManager::HasValidVM()) {
+        Console.Warning("VM still running from previous session, shutting down...");
+        VMManager::Shutdown(false);
+    }
+
+    CDVDsys_SetFile(CDVD_SourceType::Iso, iso_path);
+    CDVDsys_ChangeSource(CDVD_SourceType::Iso);
+
+    Error error;
+    bool result = DoCDVDopen(&error, false);
+    if (result) {
+        result = DoCDVDreplayTrace(trace_path, &error);
+        DoCDVDclose();
+    }
+    if (!result)
+        Console.ErrorFmt("CDVD trace replay failed: {}", error.GetDescription());
+
+    return result;
+}
+
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_izzy2lost_psx2_NativeApp_convertIsoToZstd(JNIEnv *env, jclass clazz,
+                                                      jstring p_src_path, jstring p_dst_path, jint p_level) {
+    const std::string src_path = GetJavaString(env, p_src_path);
+    const std::string dst_path = GetJavaString(env, p_dst_path);
+
+    Error error;
+    const bool result = OutputIsoFile::ConvertToZstd(src_path, dst_path, p_level,
+                                                     ProgressCallback::NullProgressCallback, &error);
+    if (!result)
+        Console.ErrorFmt("Converting '{}' to zstd failed: {}", src_path, error.GetDescription());
+
+    return result;
+}
+
+// Hash several disc images at once, for verifying them against redump
+extern "C"
+JNIEXPORT jobjectArray JNICALL
+Java_com_izzy2lost_psx2_NativeApp_hashDiscImages(JNIEnv *env, jclass clazz, jobjectArray p_paths) {
+    std::vector<std::string> paths;
+    const jsize count = p_paths ? env->GetArrayLength(p_paths) : 0;
+    for (jsize i = 0; i < count; i++) {
+        jstring js = (jstring)env->GetObjectArrayElement(p_paths, i);
+        paths.push_back(GetJavaString(env, js));
+        env->DeleteLocalRef(js);
+    }
+
+    // Format: "path|track|type|size|md5" per track, or "path|error|message"
+    std::vector<std::string> lines;
+    for (const IsoHasher::FileHashes& file : IsoHasher::ComputeHashesForFiles(paths)) {
+        if (!file.success) {
+            lines.push_back(StringUtil::StdStringFromFormat("%s|error|%s", file.path.c_str(), file.error.c_str()));
+            continue;
+        }
+
+        for (const IsoHasher::Track& track : file.tracks) {
+            const std::string type(IsoHasher::GetTrackTypeString(track.type));
+            lines.push_back(StringUtil::StdStringFromFormat("%s|%u|%s|%llu|%s", file.path.c_str(), track.number,
+                type.c_str(), static_cast<unsigned long long>(track.size), track.hash.c_str()));
+        }
+    }
+
+    jobjectArray result = env->NewObjectArray(lines.size(), env->FindClass("java/lang/String"), nullptr);
+    for (size_t i = 0; i < lines.size(); i++) {
+        jstring str = env->NewStringUTF(lines[i].c_str());
+        env->SetObjectArrayElement(result, i, str);
+        env->DeleteLocalRef(str);
+    }
+
+    return result;
+}
+
 extern "C"
 JNIEXPORT void JNICALL
 Java_com_izzy2lost_psx2_NativeApp_pause(JNIEnv *env, jclass clazz) {
@@ -1259,6 +1391,29 @@ Java_com_izzy2lost_psx2_NativeApp_isPaused(JNIEnv *env, jclass clazz) {
     return VMManager::GetState() == VMState::Paused;
 }
 
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_izzy2lost_psx2_NativeApp_seekGSDump(JNIEnv *env, jclass clazz, jint p_frame) {
+    if (!GSDumpReplayer::IsReplayingDump() || p_frame < 0)
+        return false;
+
+    // Picked up by the replayer before its next packet, so this is safe from the UI thread.
+    GSDumpReplayer::SeekToFrame(static_cast<u32>(p_frame));
+    return true;
+}
+
+extern "C"
+JNIEXPORT jint JNICALL
+Java_com_izzy2lost_psx2_NativeApp_getGSDumpFrameNumber(JNIEnv *env, jclass clazz) {
+    return GSDumpReplayer::IsReplayingDump() ? static_cast<jint>(GSDumpReplayer::GetFrameNumber()) : -1;
+}
+
+extern "C"
+JNIEXPORT jint JNICALL
+Java_com_izzy2lost_psx2_NativeApp_getGSDumpFrameCount(JNIEnv *env, jclass clazz) {
+    return GSDumpReplayer::IsReplayingDump() ? static_cast<jint>(GSDumpReplayer::GetFrameCount()) : 0;
+}
+
 extern "C"
 JNIEXPORT void JNICALL
 Java_com_izzy2lost_psx2_NativeApp_shutdown(JNIEnv *env, jclass clazz) {
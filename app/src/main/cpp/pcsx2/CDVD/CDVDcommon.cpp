@@ -16,11 +16,15 @@
 #include "common/Path.h"
 #include "common/ProgressCallback.h"
 #include "common/StringUtil.h"
+#include "common/Timer.h"
 
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <ctype.h>
 #include <exception>
 #include <memory>
+#include <thread>
 #include <time.h>
 
 #include "fmt/format.h"
@@ -53,6 +57,10 @@ u32 lastLSN; // needed for block dumping
 
 static OutputIsoFile blockDumpFile;
 
+// Sectors requested by the game, one "<microseconds since open> <lsn> <mode>" line per read
+static std::FILE* s_trace_file = nullptr;
+static Common::Timer s_trace_timer;
+
 // Information about tracks on disc
 u8 strack;
 u8 etrack;
@@ -68,9 +76,8 @@ static void CheckNullCDVD()
 //////////////////////////////////////////////////////////////////////////////////////////
 // Disk Type detection stuff (from cdvdGigaherz)
 //
-static int CheckDiskTypeFS(int baseType)
+s32 DoCDVDcheckDiskTypeFS(IsoReader& isor, int baseType)
 {
-	IsoReader isor;
 	if (isor.Open())
 	{
 		std::vector<u8> data;
@@ -108,6 +115,40 @@ static int CheckDiskTypeFS(int baseType)
 	return CDVD_TYPE_ILLEGAL; // << Only for discs which aren't ps2 at all.
 }
 
+static int CheckDiskTypeFS(int baseType)
+{
+	IsoReader isor;
+	return DoCDVDcheckDiskTypeFS(isor, baseType);
+}
+
+// Anything longer than this can't be a CD.
+static constexpr u32 MAX_CD_SECTORS = 452849;
+
+// Horrible hack! in CD images position 166 and 171 have block size but not DVD's
+// It's not always 2048 however (can be 4096)
+// Test Impossible Mission if thia is changed.
+static bool IsCDVolumeDescriptor(const u8* pvd)
+{
+	return (*(u16*)(pvd + 166) == *(u16*)(pvd + 171));
+}
+
+s32 DoCDVDdetectIsoDiskType(InputIsoFile& iso, IsoReader& isor)
+{
+	int base_type = CDVD_TYPE_DETCTDVDS;
+	if (iso.GetBlockCount() <= MAX_CD_SECTORS)
+	{
+		u8 buffer[CD_FRAMESIZE_RAW];
+		if (iso.ReadSync(buffer, 16) < 0)
+			return CDVD_TYPE_ILLEGAL;
+
+		// ReadSync() puts the user data where it would be in a raw sector.
+		if (IsCDVolumeDescriptor(buffer + 24))
+			base_type = CDVD_TYPE_DETCTCD;
+	}
+
+	return DoCDVDcheckDiskTypeFS(isor, base_type);
+}
+
 static int FindDiskType(int mType)
 {
 	int dataTracks = 0;
@@ -127,7 +168,7 @@ static int FindDiskType(int mType)
 		cdvdTD td;
 
 		CDVD->getTD(0, &td);
-		if (td.lsn > 452849)
+		if (td.lsn > MAX_CD_SECTORS)
 		{
 			iCDType = CDVD_TYPE_DETCTDVDS;
 		}
@@ -137,11 +178,7 @@ static int FindDiskType(int mType)
 			{
 				//const cdVolDesc& volDesc = (cdVolDesc&)bleh;
 				//if(volDesc.rootToc.tocSize == 2048)
-
-				//Horrible hack! in CD images position 166 and 171 have block size but not DVD's
-				//It's not always 2048 however (can be 4096)
-				//Test Impossible Mission if thia is changed.
-				if (*(u16*)(bleh + 166) == *(u16*)(bleh + 171))
+				if (IsCDVolumeDescriptor(bleh))
 					iCDType = CDVD_TYPE_DETCTCD;
 				else
 					iCDType = CDVD_TYPE_DETCTDVDS;
@@ -333,7 +370,54 @@ void CDVDsys_ChangeSource(CDVD_SourceType type)
 	}
 }
 
-bool DoCDVDopen(Error* error)
+static void LoadFileExtents()
+{
+	// Only the layer 0 filesystem is walked, the second layer of dual layer discs just gets the regular readahead.
+	IsoReader isor;
+	std::vector<IsoReader::FileExtent> extents;
+	Error error;
+	if (!isor.Open(&error) || !isor.GetFileExtents(&extents, &error))
+	{
+		DevCon.Warning(fmt::format("CDVD: Not prefetching along files: {}", error.GetDescription()));
+		return;
+	}
+
+	DevCon.WriteLn(fmt::format("CDVD: Prefetching along {} files", extents.size()));
+	CDVD->setFileExtents(std::move(extents));
+}
+
+static void CloseTraceFile()
+{
+	if (s_trace_file)
+	{
+		std::fclose(s_trace_file);
+		s_trace_file = nullptr;
+	}
+}
+
+static void OpenTraceFile(const std::string& source)
+{
+	CloseTraceFile();
+
+	std::string title(Path::GetFileTitle(source));
+	if (title.empty())
+		title = "Untitled";
+
+	const std::string path = Path::Combine(EmuFolders::Logs, fmt::format("{}.cdvdtrace", title));
+	Error error;
+	s_trace_file = FileSystem::OpenCFile(path.c_str(), "wb", &error);
+	if (!s_trace_file)
+	{
+		Console.Error(fmt::format("CDVD: Failed to open sector trace '{}': {}", path, error.GetDescription()));
+		return;
+	}
+
+	Console.WriteLn(fmt::format("CDVD: Recording sector trace to '{}'", path));
+	std::fprintf(s_trace_file, "# %s\n", std::string(Path::GetFileName(source)).c_str());
+	s_trace_timer.Reset();
+}
+
+bool DoCDVDopen(Error* error, bool record_trace)
 {
 	CheckNullCDVD();
 
@@ -345,6 +429,12 @@ bool DoCDVDopen(Error* error)
 
 	int cdtype = DoCDVDdetectDiskType();
 
+	if (CDVD->setFileExtents && EmuConfig.CdvdPrefetchExtents && cdtype != CDVD_TYPE_NODISC)
+		LoadFileExtents();
+
+	if (record_trace && EmuConfig.CdvdTraceReads && cdtype != CDVD_TYPE_NODISC)
+		OpenTraceFile(m_SourceFilename[CurrentSourceType]);
+
 	if (!EmuConfig.CdvdDumpBlocks || (cdtype == CDVD_TYPE_NODISC))
 	{
 		blockDumpFile.Close();
@@ -418,6 +508,7 @@ void DoCDVDclose()
 	CheckNullCDVD();
 
 	blockDumpFile.Close();
+	CloseTraceFile();
 
 	CDVD->close();
 
@@ -470,6 +561,13 @@ s32 DoCDVDreadTrack(u32 lsn, int mode)
 
 	//DevCon.Warning("CDVD readTrack(lsn=%d,mode=%d)",params lsn, lastReadSize);
 	lastLSN = lsn;
+
+	if (s_trace_file)
+	{
+		std::fprintf(s_trace_file, "%llu %u %d\n",
+			static_cast<unsigned long long>(s_trace_timer.GetTimeNanoseconds() / 1000), lsn, mode);
+	}
+
 	return CDVD->readTrack(lsn, mode);
 }
 
@@ -514,6 +612,89 @@ void DoCDVDresetDiskTypeCache()
 	diskTypeCached = -1;
 }
 
+bool DoCDVDreplayTrace(const std::string& path, Error* error)
+{
+	CheckNullCDVD();
+
+	struct TraceRead
+	{
+		u64 time;
+		u32 lsn;
+		int mode;
+	};
+
+	std::optional<std::string> data = FileSystem::ReadFileToString(path.c_str());
+	if (!data.has_value())
+	{
+		Error::SetStringFmt(error, "Failed to read sector trace '{}'.", path);
+		return false;
+	}
+
+	std::vector<TraceRead> reads;
+	for (const std::string_view line : StringUtil::SplitString(data.value(), '\n'))
+	{
+		if (line.empty() || line[0] == '#')
+			continue;
+
+		unsigned long long time;
+		u32 lsn;
+		int mode;
+		if (std::sscanf(std::string(line).c_str(), "%llu %u %d", &time, &lsn, &mode) != 3 ||
+			mode < CDVD_MODE_2352 || mode > CDVD_MODE_2048)
+		{
+			Error::SetStringFmt(error, "Malformed sector trace line: {}", line);
+			return false;
+		}
+
+		reads.push_back({static_cast<u64>(time), lsn, mode});
+	}
+
+	if (reads.empty())
+	{
+		Error::SetStringFmt(error, "Sector trace '{}' is empty.", path);
+		return false;
+	}
+
+	// The replay's own reads aren't part of any recording.
+	CloseTraceFile();
+
+	// The time between reads is what prefetching gets to work with, so keep it, but don't wait on time
+	// the original run spent on the reads themselves.
+	std::vector<double> latencies;
+	latencies.reserve(reads.size());
+	u8 buffer[CD_FRAMESIZE_RAW];
+	u32 failed = 0;
+	Common::Timer::Value start = Common::Timer::GetCurrentValue();
+	const u64 first = reads.front().time;
+	for (const TraceRead& read : reads)
+	{
+		const Common::Timer::Value due = start + Common::Timer::ConvertNanosecondsToValue(static_cast<double>(read.time - first) * 1000.0);
+		const Common::Timer::Value now = Common::Timer::GetCurrentValue();
+		if (now < due)
+			std::this_thread::sleep_for(std::chrono::nanoseconds(static_cast<s64>(Common::Timer::ConvertValueToNanoseconds(due - now))));
+
+		const Common::Timer::Value read_start = Common::Timer::GetCurrentValue();
+		if (DoCDVDreadTrack(read.lsn, read.mode) != 0 || DoCDVDgetBuffer(buffer) != 0)
+			failed++;
+
+		const Common::Timer::Value read_time = Common::Timer::GetCurrentValue() - read_start;
+		latencies.push_back(Common::Timer::ConvertValueToMilliseconds(read_time));
+		start += read_time;
+	}
+
+	double total = 0.0;
+	for (const double latency : latencies)
+		total += latency;
+	std::sort(latencies.begin(), latencies.end());
+
+	Console.WriteLn(fmt::format("CDVD: Replayed {} reads from '{}', {} failed", reads.size(), Path::GetFileName(path), failed));
+	Console.WriteLn(fmt::format("CDVD:   total {:.2f} ms, mean {:.3f} ms, p50 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms",
+		total, total / latencies.size(), latencies[latencies.size() / 2], latencies[(latencies.size() * 99) / 100],
+		latencies.back()));
+
+	return failed == 0;
+}
+
 ////////////////////////////////////////////////////////
 //
 // CDVD null interface for Run BIOS menu
@@ -613,4 +794,5 @@ const CDVD_API CDVDapi_NoDisc =
 
 		NODISCreadSector,
 		NODISCgetDualInfo,
+		nullptr,
 };
@@ -3,10 +3,13 @@
 
 #pragma once
 
+#include "CDVD/IsoReader.h"
+
 #include "common/Pcsx2Defs.h"
 
 #include <array>
 #include <string>
+#include <vector>
 
 class Error;
 class ProgressCallback;
@@ -142,6 +145,9 @@ typedef s32 (*_CDVDgetDualInfo)(s32* dualType, u32* _layer1start);
 
 typedef void (*_CDVDnewDiskCB)(void (*callback)());
 
+// Tells the source where the files on the disc are, so it can prefetch along them.
+typedef void (*_CDVDsetFileExtents)(std::vector<IsoReader::FileExtent> extents);
+
 enum class CDVD_SourceType : uint8_t
 {
 	Iso, // use built in ISO api
@@ -172,6 +178,7 @@ struct CDVD_API
 	// special functions, not in external interface yet
 	_CDVDreadSector readSector;
 	_CDVDgetDualInfo getDualInfo;
+	_CDVDsetFileExtents setFileExtents; // optional
 };
 
 // ----------------------------------------------------------------------------
@@ -194,7 +201,8 @@ extern const std::string& CDVDsys_GetFile(CDVD_SourceType srctype);
 extern CDVD_SourceType CDVDsys_GetSourceType();
 extern void CDVDsys_ClearFiles();
 
-extern bool DoCDVDopen(Error* error);
+// record_trace is false when opening for a trace replay, since recording would truncate the trace.
+extern bool DoCDVDopen(Error* error, bool record_trace = true);
 extern bool DoCDVDprecache(ProgressCallback* progress, Error* error);
 extern void DoCDVDclose();
 extern s32 DoCDVDreadSector(u8* buffer, u32 lsn, int mode);
@@ -202,3 +210,15 @@ extern s32 DoCDVDreadTrack(u32 lsn, int mode);
 extern s32 DoCDVDgetBuffer(u8* buffer);
 extern s32 DoCDVDdetectDiskType();
 extern void DoCDVDresetDiskTypeCache();
+
+// Filesystem part of the disc type detection, baseType is CDVD_TYPE_DETCTCD or one of the DVD types.
+// Works on any IsoReader, so images can be identified without making them the active source.
+extern s32 DoCDVDcheckDiskTypeFS(IsoReader& isor, int baseType);
+
+// Same detection DoCDVDdetectDiskType() does for an ISO source, for images opened outside of it.
+// isor must read from iso.
+extern s32 DoCDVDdetectIsoDiskType(InputIsoFile& iso, IsoReader& isor);
+
+// Replays a sector trace recorded with CdvdTraceReads against the open source, keeping the recorded
+// timing, and logs how long the reads took. Open the source with DoCDVDopen(error, false) first.
+extern bool DoCDVDreplayTrace(const std::string& path, Error* error);
@@ -570,4 +570,5 @@ const CDVD_API CDVDapi_Disc =
 
 		DISCreadSector,
 		DISCgetDualInfo,
+		nullptr,
 };
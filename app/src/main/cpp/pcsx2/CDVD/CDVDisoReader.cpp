@@ -55,6 +55,11 @@ static bool ISOopen(std::string filename, Error* error)
 	return true;
 }
 
+static void ISOsetFileExtents(std::vector<IsoReader::FileExtent> extents)
+{
+	iso.SetFileExtents(std::move(extents));
+}
+
 static bool ISOprecache(ProgressCallback* progress, Error* error)
 {
 	return iso.Precache(progress, error);
@@ -420,4 +425,5 @@ const CDVD_API CDVDapi_Iso =
 
 		ISOreadSector,
 		ISOgetDualInfo,
+		ISOsetFileExtents,
 };
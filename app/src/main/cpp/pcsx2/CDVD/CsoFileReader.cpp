@@ -28,6 +28,7 @@ struct CsoHeader
 };
 
 static const u32 CSO_READ_BUFFER_SIZE = 256 * 1024;
+static const u32 CSO_DECOMPRESS_SLOTS = 4;
 
 CsoFileReader::CsoFileReader() = default;
 
@@ -103,7 +104,8 @@ bool CsoFileReader::Precache2(ProgressCallback* progress, Error* error)
 		return false;
 	}
 
-	m_readBuffer.reset();
+	for (u32 i = 0; i < CSO_DECOMPRESS_SLOTS; i++)
+		m_slots[i].readBuffer.reset();
 	std::fclose(m_src);
 	m_src = nullptr;
 	return true;
@@ -148,11 +150,11 @@ bool CsoFileReader::InitializeBuffers(Error* error)
 	// We might read a bit of alignment too, so be prepared.
 	if (m_frameSize + (1 << m_indexShift) < CSO_READ_BUFFER_SIZE)
 	{
-		m_readBuffer = std::make_unique<u8[]>(CSO_READ_BUFFER_SIZE);
+		m_readBufferSize = CSO_READ_BUFFER_SIZE;
 	}
 	else
 	{
-		m_readBuffer = std::make_unique<u8[]>(m_frameSize + (1 << m_indexShift));
+		m_readBufferSize = m_frameSize + (1 << m_indexShift);
 	}
 
 	const u32 indexSize = numFrames + 1;
@@ -163,14 +165,29 @@ bool CsoFileReader::InitializeBuffers(Error* error)
 		return false;
 	}
 
+	// The other slots are set up when a worker first uses them.
+	m_slots = std::make_unique<DecompressSlot[]>(CSO_DECOMPRESS_SLOTS);
+	if (!InitializeSlot(m_slots[0]))
+	{
+		Error::SetString(error, "Unable to initialize zlib for CSO decompression.");
+		return false;
+	}
+
+	return true;
+}
+
+bool CsoFileReader::InitializeSlot(DecompressSlot& slot)
+{
+	if (!slot.readBuffer && !m_file_cache)
+		slot.readBuffer = std::make_unique<u8[]>(m_readBufferSize);
+
 	// initialize zlib if not a ZSO
-	if (!m_uselz4)
+	if (!m_uselz4 && !slot.zstreamInitialized)
 	{
-		if (inflateInit2(&m_z_stream, -15) != Z_OK)
-		{
-			Error::SetString(error, "Unable to initialize zlib for CSO decompression.");
+		if (inflateInit2(&slot.zstream, -15) != Z_OK)
 			return false;
-		}
+
+		slot.zstreamInitialized = true;
 	}
 
 	return true;
@@ -187,10 +204,17 @@ void CsoFileReader::Close2()
 	}
 	if (m_file_cache)
 		m_file_cache.reset();
-	if (!m_uselz4)
-		inflateEnd(&m_z_stream);
 
-	m_readBuffer.reset();
+	if (m_slots)
+	{
+		for (u32 i = 0; i < CSO_DECOMPRESS_SLOTS; i++)
+		{
+			if (m_slots[i].zstreamInitialized)
+				inflateEnd(&m_slots[i].zstream);
+		}
+		m_slots.reset();
+	}
+
 	m_index.reset();
 }
 
@@ -216,10 +240,27 @@ ThreadedFileReader::Chunk CsoFileReader::ChunkForOffset(u64 offset)
 }
 
 int CsoFileReader::ReadChunk(void* dst, s64 chunkID)
+{
+	return DecompressChunk(dst, chunkID, 0);
+}
+
+u32 CsoFileReader::GetDecompressSlots() const
+{
+	return CSO_DECOMPRESS_SLOTS;
+}
+
+int CsoFileReader::DecompressChunk(void* dst, s64 chunkID, u32 slot_index)
 {
 	if (chunkID < 0)
 		return -1;
 
+	DecompressSlot& slot = m_slots[slot_index];
+	if (!InitializeSlot(slot))
+	{
+		Console.Error("Unable to initialize zlib for CSO decompression.");
+		return 0;
+	}
+
 	const u32 frame = chunkID;
 
 	// Grab the index data for the frame we're about to read.
@@ -244,6 +285,7 @@ int CsoFileReader::ReadChunk(void* dst, s64 chunkID)
 		}
 
 		// Just read directly, easy.
+		std::lock_guard<std::mutex> lock(m_src_mutex);
 		if (FileSystem::FSeek64(m_src, frameRawPos, SEEK_SET) != 0)
 		{
 			Console.Error("Unable to seek to uncompressed CSO data.");
@@ -267,13 +309,14 @@ int CsoFileReader::ReadChunk(void* dst, s64 chunkID)
 		}
 		else
 		{
+			std::lock_guard<std::mutex> lock(m_src_mutex);
 			if (FileSystem::FSeek64(m_src, frameRawPos, SEEK_SET) != 0)
 			{
 				Console.Error("Unable to seek to compressed CSO data.");
 				return 0;
 			}
-			readBuffer = m_readBuffer.get();
-			readRawBytes = fread(m_readBuffer.get(), 1, frameRawSize, m_src);
+			readBuffer = slot.readBuffer.get();
+			readRawBytes = fread(slot.readBuffer.get(), 1, frameRawSize, m_src);
 		}
 
 		bool success = false;
@@ -290,20 +333,20 @@ int CsoFileReader::ReadChunk(void* dst, s64 chunkID)
 		}
 		else
 		{
-			m_z_stream.next_in = readBuffer;
-			m_z_stream.avail_in = readRawBytes;
-			m_z_stream.next_out = static_cast<Bytef*>(dst);
-			m_z_stream.avail_out = m_frameSize;
+			slot.zstream.next_in = readBuffer;
+			slot.zstream.avail_in = readRawBytes;
+			slot.zstream.next_out = static_cast<Bytef*>(dst);
+			slot.zstream.avail_out = m_frameSize;
 
-			const int status = inflate(&m_z_stream, Z_FINISH);
-			success = (status == Z_STREAM_END && m_z_stream.total_out == m_frameSize);
+			const int status = inflate(&slot.zstream, Z_FINISH);
+			success = (status == Z_STREAM_END && slot.zstream.total_out == m_frameSize);
 		}
 
 		if (!success)
 			Console.Error(fmt::format("Unable to decompress CSO frame using {}", (m_uselz4)? "lz4":"zlib"));
 		
 		if (!m_uselz4)
-			inflateReset(&m_z_stream);
+			inflateReset(&slot.zstream);
 
 		return success ? m_frameSize : 0;
 	}
@@ -4,6 +4,8 @@
 #pragma once
 
 #include "ThreadedFileReader.h"
+#include <memory>
+#include <mutex>
 #include <zlib.h>
 
 struct CsoHeader;
@@ -22,30 +24,43 @@ public:
 
 	Chunk ChunkForOffset(u64 offset) override;
 	int ReadChunk(void* dst, s64 chunkID) override;
+	u32 GetDecompressSlots() const override;
+	int DecompressChunk(void* dst, s64 chunkID, u32 slot) override;
 
 	void Close2() override;
 
 	u32 GetBlockCount() const override;
 
 private:
+	/// Frames are independent, so every worker gets its own buffer and zlib stream
+	struct DecompressSlot
+	{
+		std::unique_ptr<u8[]> readBuffer;
+		z_stream zstream = {};
+		bool zstreamInitialized = false;
+	};
+
 	static bool ValidateHeader(const CsoHeader& hdr, Error* error);
 	bool ReadFileHeader(Error* error);
 	bool InitializeBuffers(Error* error);
 	int ReadFromFrame(u8* dest, u64 pos, int maxBytes);
 	bool DecompressFrame(Bytef* dst, u32 frame, u32 readBufferSize);
 	bool DecompressFrame(u32 frame, u32 readBufferSize);
+	bool InitializeSlot(DecompressSlot& slot);
 
 	u32 m_frameSize = 0;
 	u8 m_frameShift = 0;
 	u8 m_indexShift = 0;
 	bool m_uselz4 = false; // flag to enable LZ4 decompression (ZSO files)
-	std::unique_ptr<u8[]> m_readBuffer;
+	u32 m_readBufferSize = 0;
+	std::unique_ptr<DecompressSlot[]> m_slots;
 
 	std::unique_ptr<u32[]> m_index;
 	u64 m_totalSize = 0;
 	// The actual source cso file handle.
 	std::FILE* m_src = nullptr;
+	/// Held while seeking and reading `m_src`, decompression happens outside of it
+	std::mutex m_src_mutex;
 	std::unique_ptr<u8[]> m_file_cache;
 	size_t m_file_cache_size = 0;
-	z_stream m_z_stream = {};
 };
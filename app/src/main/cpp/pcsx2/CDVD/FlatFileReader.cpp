@@ -74,9 +74,10 @@ ThreadedFileReader::Chunk FlatFileReader::ChunkForOffset(u64 offset)
 	}
 	else
 	{
+		// The length has to be the whole chunk, it sizes the buffer ReadChunk() fills.
 		chunk.chunkID = offset / CHUNK_SIZE;
-		chunk.length = static_cast<u32>(std::min<u64>(m_file_size - offset, CHUNK_SIZE));
 		chunk.offset = static_cast<u64>(chunk.chunkID) * CHUNK_SIZE;
+		chunk.length = static_cast<u32>(std::min<u64>(m_file_size - chunk.offset, CHUNK_SIZE));
 	}
 
 	return chunk;
@@ -7,6 +7,7 @@
 #include "CDVD/FlatFileReader.h"
 #include "CDVD/GzippedFileReader.h"
 #include "CDVD/IsoFileFormats.h"
+#include "CDVD/ZstdFileReader.h"
 #include "Config.h"
 #include "Host.h"
 
@@ -18,6 +19,11 @@
 
 #include "fmt/format.h"
 
+#include <algorithm>
+
+// Sectors kept prefetched ahead of reads inside a file, the reader limits this further to what its cache can hold
+static constexpr u32 EXTENT_PREFETCH_SECTORS = 2048;
+
 static const char* nameFromType(int type)
 {
 	switch (type)
@@ -50,6 +56,9 @@ static std::unique_ptr<ThreadedFileReader> GetFileReader(const std::string& path
 	if (StringUtil::compareNoCase(extension, "gz"))
 		return std::make_unique<GzippedFileReader>();
 
+	if (StringUtil::compareNoCase(extension, "zst"))
+		return std::make_unique<ZstdFileReader>();
+
 	if (StringUtil::compareNoCase(extension, "dump"))
 		return std::make_unique<BlockdumpFileReader>();
 
@@ -87,6 +96,40 @@ void InputIsoFile::BeginRead2(uint lsn)
 
 	m_reader->BeginRead(m_readbuffer, m_read_lsn, 1);
 	m_read_inprogress = true;
+
+	if (!m_extents.empty())
+		PrefetchExtent(lsn);
+}
+
+void InputIsoFile::SetFileExtents(std::vector<IsoReader::FileExtent> extents)
+{
+	m_extents = std::move(extents);
+	m_prefetch_start = 0;
+	m_prefetch_end = 0;
+}
+
+void InputIsoFile::PrefetchExtent(uint lsn)
+{
+	// Games often stream several files at once, so "the next sectors" is a poor guess.
+	// Keep the cache filled along the file this sector belongs to instead, up to its end.
+	auto it = std::upper_bound(m_extents.begin(), m_extents.end(), lsn,
+		[](uint value, const IsoReader::FileExtent& extent) { return value < extent.lsn; });
+	if (it == m_extents.begin())
+		return;
+	--it;
+
+	const uint end = it->lsn + it->sectors;
+	if (lsn + 1 >= end)
+		return;
+
+	// Only top up once half of what was prefetched has been read.
+	if (lsn >= m_prefetch_start && lsn + EXTENT_PREFETCH_SECTORS / 2 < m_prefetch_end)
+		return;
+
+	const uint count = std::min<uint>(end - (lsn + 1), EXTENT_PREFETCH_SECTORS);
+	m_reader->Prefetch(lsn + 1, count);
+	m_prefetch_start = lsn;
+	m_prefetch_end = lsn + 1 + count;
 }
 
 int InputIsoFile::FinishRead3(u8* dst, uint mode)
@@ -187,6 +230,9 @@ void InputIsoFile::_init()
 	m_current_lsn = -1;
 	m_read_lsn = -1;
 	m_reader.reset();
+	m_extents.clear();
+	m_prefetch_start = 0;
+	m_prefetch_end = 0;
 }
 
 bool InputIsoFile::Open(std::string srcfile, Error* error)
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "CDVD/CDVD.h"
+#include "CDVD/IsoReader.h"
 #include "CDVD/ThreadedFileReader.h"
 #include <memory>
 #include <string>
@@ -50,6 +51,11 @@ protected:
 	uint m_read_lsn;
 	u8 m_readbuffer[CD_FRAMESIZE_RAW];
 
+	// Files on the disc, sorted by LSN, and the range last prefetched along one of them
+	std::vector<IsoReader::FileExtent> m_extents;
+	uint m_prefetch_start;
+	uint m_prefetch_end;
+
 public:
 	InputIsoFile();
 	~InputIsoFile();
@@ -59,6 +65,7 @@ public:
 	isoType GetType() const noexcept { return m_type; }
 	uint GetBlockCount() const noexcept { return m_blocks; }
 	int GetBlockOffset() const  noexcept { return m_blockofs; }
+	uint GetBlockSize() const noexcept { return m_blocksize; }
 
 	const std::string& GetFilename() const
 	{
@@ -70,6 +77,8 @@ public:
 	void Close();
 	bool Detect(bool readType = true);
 
+	void SetFileExtents(std::vector<IsoReader::FileExtent> extents);
+
 	int ReadSync(u8* dst, uint lsn);
 
 	void BeginRead2(uint lsn);
@@ -80,6 +89,7 @@ protected:
 
 	bool tryIsoType(u32 size, u32 offset, u32 blockofs);
 	void FindParts();
+	void PrefetchExtent(uint lsn);
 };
 
 class OutputIsoFile final
@@ -122,6 +132,11 @@ public:
 
 	void WriteSector(const u8* src, uint lsn);
 
+	/// Rewrites any image InputIsoFile can open as independent zstd frames followed by a seek table,
+	/// which ZstdFileReader can read back. Partial output is deleted on failure or cancellation.
+	static bool ConvertToZstd(const std::string& src, const std::string& dst, int level,
+		ProgressCallback* progress, Error* error);
+
 protected:
 	void _init();
 
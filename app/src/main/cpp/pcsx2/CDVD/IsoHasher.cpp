@@ -2,16 +2,32 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "CDVD/CDVDcommon.h"
+#include "CDVD/IsoFileFormats.h"
 #include "CDVD/IsoHasher.h"
+#include "CDVD/IsoReader.h"
 #include "Host.h"
 
 #include "common/Error.h"
 #include "common/MD5Digest.h"
 #include "common/StringUtil.h"
+#include "common/Timer.h"
 
 #include "fmt/format.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+// Sectors read per batch, and how many batches the reader can be ahead of the hash.
+static constexpr u32 HASH_BATCH_SECTORS = 256;
+static constexpr u32 HASH_READ_BUFFERS = 3;
+
+// Each image already uses two threads (read and hash), so don't go overboard.
+static constexpr u32 MAX_AUTO_HASH_THREADS = 4;
 
 IsoHasher::IsoHasher() = default;
 
@@ -39,14 +55,17 @@ bool IsoHasher::Open(std::string iso_path, Error* error)
 {
 	Close();
 
-	CDVDsys_SetFile(CDVD_SourceType::Iso, std::move(iso_path));
-	CDVDsys_ChangeSource(CDVD_SourceType::Iso);
-
-	m_is_open = DoCDVDopen(error);
+	// Reads go through our own image rather than the CDVD source, so several hashers can run at once.
+	m_iso = std::make_unique<InputIsoFile>();
+	m_is_open = m_iso->Open(std::move(iso_path), error);
 	if (!m_is_open)
+	{
+		m_iso.reset();
 		return false;
+	}
 
-	const s32 type = DoCDVDdetectDiskType();
+	IsoReader isor(m_iso.get());
+	const s32 type = DoCDVDdetectIsoDiskType(*m_iso, isor);
 	switch (type)
 	{
 		case CDVD_TYPE_PSCD:
@@ -65,38 +84,14 @@ bool IsoHasher::Open(std::string iso_path, Error* error)
 			return false;
 	}
 
-	cdvdTN tn;
-	if (CDVD->getTN(&tn) < 0)
-	{
-		Error::SetString(error, "Failed to get track count.");
-		return false;
-	}
-
-	for (u8 track = tn.strack; track <= tn.etrack; track++)
-	{
-		cdvdTD td, next_td;
-		if (CDVD->getTD(track, &td) < 0 || CDVD->getTD((track == tn.etrack) ? 0 : (track + 1), &next_td) < 0)
-		{
-			Error::SetString(error, fmt::format("Failed to get track range for {}", static_cast<unsigned>(track)));
-			return false;
-		}
-
-		// sanity check..
-		if (next_td.lsn < td.lsn)
-		{
-			Error::SetString(error,
-				fmt::format("Invalid track range for {} ({},{})", static_cast<unsigned>(track), td.lsn, next_td.lsn));
-			return false;
-		}
-
-		Track strack;
-		strack.number = track;
-		strack.type = td.type;
-		strack.start_lsn = td.lsn;
-		strack.sectors = next_td.lsn - td.lsn;
-		strack.size = static_cast<u64>(strack.sectors) * (m_is_cd ? 2352 : 2048);
-		m_tracks.push_back(std::move(strack));
-	}
+	// Images are always a single data track.
+	Track strack;
+	strack.number = 1;
+	strack.type = CDVD_MODE1_TRACK;
+	strack.start_lsn = 0;
+	strack.sectors = m_iso->GetBlockCount();
+	strack.size = static_cast<u64>(strack.sectors) * (m_is_cd ? 2352 : 2048);
+	m_tracks.push_back(std::move(strack));
 
 	return true;
 }
@@ -106,7 +101,7 @@ void IsoHasher::Close()
 	if (!m_is_open)
 		return;
 
-	DoCDVDclose();
+	m_iso.reset();
 	m_tracks.clear();
 	m_is_cd = false;
 	m_is_open = false;
@@ -143,33 +138,142 @@ void IsoHasher::ComputeHashes(ProgressCallback* callback)
 
 bool IsoHasher::ComputeTrackHash(Track& track, ProgressCallback* callback)
 {
-	// use 2048 byte reads for DVDs, otherwise 2352 raw.
-	const int read_mode = m_is_cd ? CDVD_MODE_2352 : CDVD_MODE_2048;
 	const u32 sector_size = m_is_cd ? 2352 : 2048;
-	std::vector<u8> sector_buffer(sector_size);
-
-	const u32 update_interval = std::max<u32>(track.sectors / 100u, 1u);
 	callback->SetFormattedStatusText("Computing hash for track %u...", track.number);
 	callback->SetProgressRange(track.sectors);
 
+	Common::Timer timer;
+	Common::Timer status_timer;
+	Error error;
+	const bool result = HashTrack(track, [&](u32 sectors_done) {
+		callback->SetProgressValue(sectors_done);
+		if (status_timer.GetTimeSeconds() >= 0.5)
+		{
+			const double mb = static_cast<double>(sectors_done) * sector_size / (1024.0 * 1024.0);
+			callback->SetFormattedStatusText("Computing hash for track %u (%.1f MB/s)...", track.number,
+				mb / std::max(timer.GetTimeSeconds(), 0.001));
+			status_timer.Reset();
+		}
+		return !callback->IsCancelled();
+	},
+		&error);
+
+	if (!result)
+	{
+		if (!callback->IsCancelled())
+			callback->DisplayFormattedModalError("%s", error.GetDescription().c_str());
+		return false;
+	}
+
+	callback->SetProgressValue(track.sectors);
+	return true;
+}
+
+bool IsoHasher::HashTrack(Track& track, const HashProgressFunction& progress, Error* error)
+{
+	// use 2048 byte reads for DVDs, otherwise 2352 raw.
+	const u32 sector_size = m_is_cd ? 2352 : 2048;
+	const u32 data_offset = m_is_cd ? 0 : 24;
+	const u32 num_batches = (track.sectors + HASH_BATCH_SECTORS - 1) / HASH_BATCH_SECTORS;
+
+	struct Batch
+	{
+		std::unique_ptr<u8[]> data;
+		u32 sectors = 0;
+		bool filled = false;
+	};
+
+	std::array<Batch, HASH_READ_BUFFERS> batches;
+	for (Batch& batch : batches)
+		batch.data = std::make_unique_for_overwrite<u8[]>(HASH_BATCH_SECTORS * sector_size);
+
+	std::mutex mutex;
+	std::condition_variable cv;
+	bool stop = false;
+	bool read_failed = false;
+	u32 failed_lsn = 0;
+
+	// Reading runs a few batches ahead of the MD5, so neither side waits on the other for long.
+	std::thread reader([&]() {
+		// Zeroed once, images without the sync/header bytes leave them alone.
+		u8 raw[CD_FRAMESIZE_RAW] = {};
+		for (u32 batch_index = 0; batch_index < num_batches; batch_index++)
+		{
+			Batch& batch = batches[batch_index % HASH_READ_BUFFERS];
+			{
+				std::unique_lock lock(mutex);
+				cv.wait(lock, [&]() { return stop || !batch.filled; });
+				if (stop)
+					return;
+			}
+
+			const u32 first_sector = batch_index * HASH_BATCH_SECTORS;
+			const u32 count = std::min(HASH_BATCH_SECTORS, track.sectors - first_sector);
+			for (u32 i = 0; i < count; i++)
+			{
+				const u32 lsn = track.start_lsn + first_sector + i;
+				if (m_iso->ReadSync(raw, lsn) < 0)
+				{
+					std::unique_lock lock(mutex);
+					read_failed = true;
+					failed_lsn = lsn;
+					cv.notify_all();
+					return;
+				}
+
+				std::memcpy(&batch.data[i * sector_size], raw + data_offset, sector_size);
+			}
+
+			{
+				std::unique_lock lock(mutex);
+				batch.sectors = count;
+				batch.filled = true;
+			}
+			cv.notify_all();
+		}
+	});
+
 	MD5Digest md5;
-	for (u32 i = 0; i < track.sectors; i++)
+	bool result = true;
+	for (u32 batch_index = 0; batch_index < num_batches; batch_index++)
 	{
-		if (callback->IsCancelled())
-			return false;
+		Batch& batch = batches[batch_index % HASH_READ_BUFFERS];
+		{
+			std::unique_lock lock(mutex);
+			cv.wait(lock, [&]() { return batch.filled || read_failed; });
+			if (!batch.filled)
+			{
+				Error::SetStringFmt(error, "Read error at LSN {}", failed_lsn);
+				result = false;
+				break;
+			}
+		}
+
+		md5.Update(batch.data.get(), batch.sectors * sector_size);
+		const u32 sectors_done = batch_index * HASH_BATCH_SECTORS + batch.sectors;
 
-		const u32 lsn = track.start_lsn + i;
-		if (DoCDVDreadSector(sector_buffer.data(), lsn, read_mode) != 0)
 		{
-			callback->DisplayFormattedModalError("Read error at LSN %u", lsn);
-			return false;
+			std::unique_lock lock(mutex);
+			batch.filled = false;
 		}
+		cv.notify_all();
 
-		md5.Update(sector_buffer.data(), sector_size);
+		if (!progress(sectors_done))
+		{
+			result = false;
+			break;
+		}
+	}
 
-		if ((i % update_interval) == 0)
-			callback->SetProgressValue(i);
+	{
+		std::unique_lock lock(mutex);
+		stop = true;
 	}
+	cv.notify_all();
+	reader.join();
+
+	if (!result)
+		return false;
 
 	u8 digest[16];
 	md5.Final(digest);
@@ -178,6 +282,106 @@ bool IsoHasher::ComputeTrackHash(Track& track, ProgressCallback* callback)
 			digest[0], digest[1], digest[2], digest[3], digest[4], digest[5], digest[6], digest[7], digest[8],
 			digest[9], digest[10], digest[11], digest[12], digest[13], digest[14], digest[15]);
 
-	callback->SetProgressValue(track.sectors);
 	return true;
 }
+
+std::vector<IsoHasher::FileHashes> IsoHasher::ComputeHashesForFiles(
+	const std::vector<std::string>& paths, u32 num_threads, ProgressCallback* callback)
+{
+	std::vector<FileHashes> results(paths.size());
+	if (paths.empty())
+		return results;
+
+	if (num_threads == 0)
+		num_threads = std::clamp<u32>(std::thread::hardware_concurrency(), 1, MAX_AUTO_HASH_THREADS);
+	num_threads = static_cast<u32>(std::min<size_t>(num_threads, paths.size()));
+
+	callback->SetCancellable(true);
+	callback->SetProgressRange(static_cast<u32>(paths.size()));
+	callback->SetProgressValue(0);
+
+	std::atomic<size_t> next_file{0};
+	std::atomic<u32> files_done{0};
+	std::atomic<u64> bytes_hashed{0};
+	std::atomic_bool cancelled{false};
+	std::mutex done_mutex;
+	std::condition_variable done_cv;
+
+	const auto worker = [&]() {
+		for (;;)
+		{
+			const size_t index = next_file.fetch_add(1, std::memory_order_relaxed);
+			if (index >= paths.size())
+				break;
+
+			FileHashes& result = results[index];
+			result.path = paths[index];
+			result.is_cd = false;
+			result.success = false;
+
+			Error error;
+			IsoHasher hasher;
+			if (!cancelled.load(std::memory_order_relaxed) && hasher.Open(paths[index], &error))
+			{
+				const u32 sector_size = hasher.IsCD() ? 2352 : 2048;
+				result.is_cd = hasher.IsCD();
+				result.success = true;
+				for (Track& track : hasher.m_tracks)
+				{
+					u32 last_sectors = 0;
+					if (!hasher.HashTrack(track, [&](u32 sectors_done) {
+						bytes_hashed.fetch_add(static_cast<u64>(sectors_done - last_sectors) * sector_size, std::memory_order_relaxed);
+						last_sectors = sectors_done;
+						return !cancelled.load(std::memory_order_relaxed);
+					},
+						&error))
+					{
+						result.success = false;
+						break;
+					}
+				}
+				result.tracks = hasher.GetTracks();
+			}
+
+			if (!result.success)
+				result.error = error.IsValid() ? error.GetDescription() : std::string("Cancelled.");
+
+			{
+				std::unique_lock lock(done_mutex);
+				files_done.fetch_add(1, std::memory_order_release);
+			}
+			done_cv.notify_one();
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(num_threads);
+	for (u32 i = 0; i < num_threads; i++)
+		threads.emplace_back(worker);
+
+	// Only this thread talks to the callback.
+	Common::Timer timer;
+	u32 reported = 0;
+	while (reported < paths.size())
+	{
+		{
+			std::unique_lock lock(done_mutex);
+			done_cv.wait_for(lock, std::chrono::milliseconds(100),
+				[&]() { return files_done.load(std::memory_order_acquire) != reported; });
+		}
+
+		if (callback->IsCancelled())
+			cancelled.store(true, std::memory_order_relaxed);
+
+		reported = files_done.load(std::memory_order_acquire);
+		const double mb = static_cast<double>(bytes_hashed.load(std::memory_order_relaxed)) / (1024.0 * 1024.0);
+		callback->SetFormattedStatusText("Hashed %u of %u images (%.1f MB/s)...", reported,
+			static_cast<u32>(paths.size()), mb / std::max(timer.GetTimeSeconds(), 0.001));
+		callback->SetProgressValue(reported);
+	}
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	return results;
+}
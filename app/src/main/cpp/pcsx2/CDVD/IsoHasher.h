@@ -6,10 +6,13 @@
 #include "common/Pcsx2Defs.h"
 #include "common/ProgressCallback.h"
 
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
 class Error;
+class InputIsoFile;
 
 class IsoHasher
 {
@@ -24,6 +27,15 @@ public:
 		std::string hash;
 	};
 
+	struct FileHashes
+	{
+		std::string path;
+		std::vector<Track> tracks;
+		std::string error;
+		bool is_cd;
+		bool success;
+	};
+
 public:
 	IsoHasher();
 	~IsoHasher();
@@ -40,9 +52,18 @@ public:
 
 	void ComputeHashes(ProgressCallback* callback = ProgressCallback::NullProgressCallback);
 
+	/// Hashes several images at once, one per worker thread. num_threads of 0 picks a count from the CPU.
+	static std::vector<FileHashes> ComputeHashesForFiles(const std::vector<std::string>& paths, u32 num_threads = 0,
+		ProgressCallback* callback = ProgressCallback::NullProgressCallback);
+
 private:
+	/// Called from the hashing thread with the number of sectors done so far, returns false to cancel.
+	using HashProgressFunction = std::function<bool(u32)>;
+
 	bool ComputeTrackHash(Track& track, ProgressCallback* callback);
+	bool HashTrack(Track& track, const HashProgressFunction& progress, Error* error);
 
+	std::unique_ptr<InputIsoFile> m_iso;
 	std::vector<Track> m_tracks;
 	bool m_is_open = false;
 	bool m_is_cd = false;
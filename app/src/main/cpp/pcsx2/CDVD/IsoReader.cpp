@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "CDVD/CDVDcommon.h"
+#include "CDVD/IsoFileFormats.h"
 #include "CDVD/IsoReader.h"
 
 #include "common/Assertions.h"
@@ -11,10 +12,17 @@
 
 #include "fmt/format.h"
 
+#include <algorithm>
 #include <cctype>
+#include <unordered_set>
 
 IsoReader::IsoReader() = default;
 
+IsoReader::IsoReader(InputIsoFile* source)
+	: m_source(source)
+{
+}
+
 IsoReader::~IsoReader() = default;
 
 std::string_view IsoReader::RemoveVersionIdentifierFromPath(const std::string_view path)
@@ -33,6 +41,20 @@ bool IsoReader::Open(Error* error)
 
 bool IsoReader::ReadSector(u8* buf, u32 lsn, Error* error)
 {
+	if (m_source)
+	{
+		// Same as CDVD_MODE_2048 reads through the ISO source, user data starts after sync+head+sub.
+		u8 raw[CD_FRAMESIZE_RAW];
+		if (m_source->ReadSync(raw, lsn) <= 0)
+		{
+			Error::SetString(error, fmt::format("Failed to read sector LSN #{}", lsn));
+			return false;
+		}
+
+		std::memcpy(buf, raw + 24, SECTOR_SIZE);
+		return true;
+	}
+
 	if (DoCDVDreadSector(buf, lsn, CDVD_MODE_2048) != 0)
 	{
 		Error::SetString(error, fmt::format("Failed to read sector LSN #{}", lsn));
@@ -306,3 +328,53 @@ bool IsoReader::ReadFile(const ISODirectoryEntry& de, std::vector<u8>* data, Err
 	data->resize(de.length_le);
 	return true;
 }
+
+bool IsoReader::GetFileExtents(std::vector<FileExtent>* extents, Error* error)
+{
+	extents->clear();
+
+	const ISODirectoryEntry* root_de = reinterpret_cast<const ISODirectoryEntry*>(m_pvd.root_directory_entry);
+	std::vector<std::pair<u32, u32>> directories = {{root_de->location_le, root_de->length_le}};
+
+	// Broken images can have directories pointing back at their parents.
+	std::unordered_set<u32> visited;
+
+	u8 sector_buffer[SECTOR_SIZE];
+	while (!directories.empty())
+	{
+		const auto [directory_record_lsn, directory_record_length] = directories.back();
+		directories.pop_back();
+		if (!visited.insert(directory_record_lsn).second)
+			continue;
+
+		const u32 num_sectors = (directory_record_length + (SECTOR_SIZE - 1)) / SECTOR_SIZE;
+		for (u32 i = 0; i < num_sectors; i++)
+		{
+			if (!ReadSector(sector_buffer, directory_record_lsn + i, error))
+				return false;
+
+			u32 sector_offset = 0;
+			while ((sector_offset + sizeof(ISODirectoryEntry)) < SECTOR_SIZE)
+			{
+				const ISODirectoryEntry* de = reinterpret_cast<const ISODirectoryEntry*>(&sector_buffer[sector_offset]);
+				if (de->entry_length < sizeof(ISODirectoryEntry))
+					break;
+
+				const std::string_view de_filename = GetDirectoryEntryFileName(sector_buffer, sector_offset);
+				sector_offset += de->entry_length;
+
+				if (de_filename.empty() || de_filename == "." || de_filename == "..")
+					continue;
+
+				if (de->flags & ISODirectoryEntryFlag_Directory)
+					directories.emplace_back(de->location_le, de->length_le);
+				else if (de->length_le > 0)
+					extents->push_back({de->location_le, static_cast<u32>((static_cast<u64>(de->length_le) + (SECTOR_SIZE - 1)) / SECTOR_SIZE)});
+			}
+		}
+	}
+
+	std::sort(extents->begin(), extents->end(),
+		[](const FileExtent& lhs, const FileExtent& rhs) { return lhs.lsn < rhs.lsn; });
+	return true;
+}
@@ -11,6 +11,7 @@
 #include <vector>
 
 class Error;
+class InputIsoFile;
 
 class IsoReader
 {
@@ -133,7 +134,15 @@ public:
 
 #pragma pack(pop)
 
+	struct FileExtent
+	{
+		u32 lsn;
+		u32 sectors;
+	};
+
 	IsoReader();
+	/// Reads from the given image instead of the active CDVD source, so it can be used from any thread.
+	explicit IsoReader(InputIsoFile* source);
 	~IsoReader();
 
 	static std::string_view RemoveVersionIdentifierFromPath(const std::string_view path);
@@ -153,6 +162,9 @@ public:
 	bool ReadFile(const std::string_view path, std::vector<u8>* data, Error* error = nullptr);
 	bool ReadFile(const ISODirectoryEntry& de, std::vector<u8>* data, Error* error = nullptr);
 
+	/// Walks the whole directory tree and returns where every file is on the disc, sorted by LSN.
+	bool GetFileExtents(std::vector<FileExtent>* extents, Error* error = nullptr);
+
 private:
 	static std::string_view GetDirectoryEntryFileName(const u8* sector, u32 de_sector_offset);
 
@@ -163,4 +175,5 @@ private:
 		u32 directory_record_lba, u32 directory_record_size, Error* error);
 
 	ISOPrimaryVolumeDescriptor m_pvd = {};
+	InputIsoFile* m_source = nullptr;
 };
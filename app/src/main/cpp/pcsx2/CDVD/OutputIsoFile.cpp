@@ -2,15 +2,30 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "CDVD/IsoFileFormats.h"
+#include "CDVD/ZstdFileReader.h"
 #include "Host.h"
 
 #include "common/Console.h"
+#include "common/Error.h"
 #include "common/FileSystem.h"
+#include "common/Path.h"
+#include "common/ProgressCallback.h"
+#include "common/ScopedGuard.h"
 #include "common/StringUtil.h"
 
 #include "fmt/format.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
 #include <errno.h>
+#include <mutex>
+#include <thread>
+#include <zstd.h>
+
+// Sectors per zstd frame. Bigger frames compress better, smaller ones make random reads cheaper.
+static constexpr u32 ZSTD_FRAME_SECTORS = 128;
+static constexpr u32 ZSTD_MAX_CONVERT_THREADS = 8;
 
 OutputIsoFile::OutputIsoFile()
 {
@@ -126,3 +141,208 @@ u32 OutputIsoFile::GetBlockSize() const
 {
 	return m_blocksize;
 }
+
+bool OutputIsoFile::ConvertToZstd(const std::string& src, const std::string& dst, int level,
+	ProgressCallback* progress, Error* error)
+{
+	InputIsoFile input;
+	if (!input.Open(src, error))
+		return false;
+
+	const u32 blocks = input.GetBlockCount();
+	const u32 blocksize = input.GetBlockSize();
+	const int blockofs = input.GetBlockOffset();
+	const u32 frame_size = ZSTD_FRAME_SECTORS * blocksize;
+	const u32 num_frames = (blocks + ZSTD_FRAME_SECTORS - 1) / ZSTD_FRAME_SECTORS;
+	const u32 num_threads = std::clamp(std::thread::hardware_concurrency(), 1u, ZSTD_MAX_CONVERT_THREADS);
+
+	FileSystem::ManagedCFilePtr fp = FileSystem::OpenManagedCFile(dst.c_str(), "wb", error);
+	if (!fp)
+		return false;
+
+	// Every thread compresses one frame of the batch, the batch is then written in order.
+	struct Job
+	{
+		std::unique_ptr<u8[]> raw;
+		std::unique_ptr<u8[]> compressed;
+		u32 raw_size;
+		size_t compressed_size;
+		ZSTD_CCtx* cctx;
+	};
+	const size_t bound = ZSTD_compressBound(frame_size);
+	std::vector<Job> jobs(num_threads);
+	ScopedGuard jobs_guard([&jobs]() {
+		for (Job& job : jobs)
+			ZSTD_freeCCtx(job.cctx);
+	});
+	for (Job& job : jobs)
+	{
+		job.raw = std::make_unique_for_overwrite<u8[]>(frame_size);
+		job.compressed = std::make_unique_for_overwrite<u8[]>(bound);
+		job.cctx = ZSTD_createCCtx();
+		if (!job.cctx ||
+			ZSTD_isError(ZSTD_CCtx_setParameter(job.cctx, ZSTD_c_compressionLevel, level)) ||
+			ZSTD_isError(ZSTD_CCtx_setParameter(job.cctx, ZSTD_c_checksumFlag, 1)))
+		{
+			Error::SetString(error, "Failed to create zstd compression context.");
+			return false;
+		}
+	}
+
+	const auto compress = [](Job& job) {
+		job.compressed_size = ZSTD_compress2(job.cctx, job.compressed.get(), ZSTD_compressBound(job.raw_size),
+			job.raw.get(), job.raw_size);
+	};
+
+	// The workers live for the whole conversion, worker i compresses jobs[i] of every batch while
+	// this thread does jobs[0]. Declared after jobs_guard, so they're joined before the contexts go.
+	std::mutex pool_mutex;
+	std::condition_variable work_cv;
+	std::condition_variable done_cv;
+	u32 batch_generation = 0;
+	u32 batch_size = 0;
+	u32 batch_pending = 0;
+	bool pool_shutdown = false;
+	std::vector<std::thread> workers;
+	ScopedGuard workers_guard([&]() {
+		{
+			std::unique_lock lock(pool_mutex);
+			pool_shutdown = true;
+		}
+		work_cv.notify_all();
+		for (std::thread& worker : workers)
+			worker.join();
+	});
+	workers.reserve(num_threads - 1);
+	for (u32 i = 1; i < num_threads; i++)
+	{
+		workers.emplace_back([&, i]() {
+			u32 seen_generation = 0;
+			std::unique_lock lock(pool_mutex);
+			for (;;)
+			{
+				work_cv.wait(lock, [&]() { return pool_shutdown || batch_generation != seen_generation; });
+				if (pool_shutdown)
+					break;
+
+				seen_generation = batch_generation;
+				if (i >= batch_size)
+					continue;
+
+				lock.unlock();
+				compress(jobs[i]);
+				lock.lock();
+
+				if (--batch_pending == 0)
+					done_cv.notify_one();
+			}
+		});
+	}
+
+	progress->SetStatusText(fmt::format("Compressing {}...", Path::GetFileName(src)).c_str());
+	progress->SetProgressRange(num_frames);
+
+	// Seek table entries are compressed and decompressed size, without the optional checksum,
+	// since every frame carries its own.
+	std::vector<u32> table;
+	table.reserve(num_frames * 2);
+
+	bool success = true;
+	u8 sector[CD_FRAMESIZE_RAW];
+	for (u32 frame = 0; frame < num_frames && success;)
+	{
+		if (progress->IsCancelled())
+		{
+			Error::SetString(error, "Operation was cancelled.");
+			success = false;
+			break;
+		}
+
+		const u32 batch = std::min(num_threads, num_frames - frame);
+		for (u32 i = 0; i < batch && success; i++)
+		{
+			Job& job = jobs[i];
+			const u32 first = (frame + i) * ZSTD_FRAME_SECTORS;
+			const u32 count = std::min(ZSTD_FRAME_SECTORS, blocks - first);
+			for (u32 j = 0; j < count; j++)
+			{
+				if (input.ReadSync(sector, first + j) < 0)
+				{
+					Error::SetStringFmt(error, "Failed to read sector {}.", first + j);
+					success = false;
+					break;
+				}
+				std::memcpy(&job.raw[j * blocksize], sector + blockofs, blocksize);
+			}
+			job.raw_size = count * blocksize;
+		}
+		if (!success)
+			break;
+
+		{
+			std::unique_lock lock(pool_mutex);
+			batch_size = batch;
+			batch_pending = batch - 1;
+			batch_generation++;
+		}
+		work_cv.notify_all();
+		compress(jobs[0]);
+		{
+			std::unique_lock lock(pool_mutex);
+			done_cv.wait(lock, [&]() { return batch_pending == 0; });
+		}
+
+		for (u32 i = 0; i < batch; i++)
+		{
+			const Job& job = jobs[i];
+			if (ZSTD_isError(job.compressed_size))
+			{
+				Error::SetStringFmt(error, "Failed to compress frame {}: {}", frame + i, ZSTD_getErrorName(job.compressed_size));
+				success = false;
+				break;
+			}
+			if (std::fwrite(job.compressed.get(), job.compressed_size, 1, fp.get()) != 1)
+			{
+				Error::SetErrno(error, "fwrite() failed: ", errno);
+				success = false;
+				break;
+			}
+
+			table.push_back(static_cast<u32>(job.compressed_size));
+			table.push_back(job.raw_size);
+		}
+
+		frame += batch;
+		progress->SetProgressValue(frame);
+	}
+
+	if (success)
+	{
+		const u32 table_size = static_cast<u32>(table.size() * sizeof(u32));
+		const u32 header[2] = {ZstdFileReader::SKIPPABLE_MAGIC, table_size + ZstdFileReader::SEEK_TABLE_FOOTER_SIZE};
+		u8 footer[ZstdFileReader::SEEK_TABLE_FOOTER_SIZE];
+		std::memcpy(&footer[0], &num_frames, sizeof(num_frames));
+		footer[4] = 0;
+		const u32 magic = ZstdFileReader::SEEKABLE_MAGIC;
+		std::memcpy(&footer[5], &magic, sizeof(magic));
+
+		if (std::fwrite(header, sizeof(header), 1, fp.get()) != 1 ||
+			(table_size > 0 && std::fwrite(table.data(), table_size, 1, fp.get()) != 1) ||
+			std::fwrite(footer, sizeof(footer), 1, fp.get()) != 1 ||
+			std::fflush(fp.get()) != 0)
+		{
+			Error::SetErrno(error, "Failed to write seek table: ", errno);
+			success = false;
+		}
+	}
+
+	fp.reset();
+	if (!success)
+	{
+		FileSystem::DeleteFilePath(dst.c_str());
+		return false;
+	}
+
+	Console.WriteLn(fmt::format("(OutputIsoFile::ConvertToZstd) Wrote {} frames of {} sectors to '{}'", num_frames, ZSTD_FRAME_SECTORS, dst));
+	return true;
+}
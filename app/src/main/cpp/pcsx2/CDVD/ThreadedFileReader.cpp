@@ -2,21 +2,30 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "ThreadedFileReader.h"
+#include "Config.h"
 #include "Host.h"
 
+#include "common/Console.h"
 #include "common/Error.h"
 #include "common/HostSys.h"
 #include "common/Path.h"
 #include "common/ProgressCallback.h"
 #include "common/SmallString.h"
 #include "common/Threading.h"
+#include "common/Timer.h"
 
+#include <algorithm>
 #include <cstring>
 
 // Make sure buffer size is bigger than the cutoff where PCSX2 emulates a seek
 // If buffers are smaller than that, we can't keep up with linear reads
 static constexpr u32 MINIMUM_SIZE = 128 * 1024;
 
+// Keep the cache useful even if somebody configures it smaller than a couple of chunks.
+static constexpr u32 MINIMUM_CACHE_ENTRIES = 8;
+static constexpr u32 DEFAULT_CACHE_SIZE_MB = 16;
+static constexpr u32 MAXIMUM_AUTO_WORKERS = 4;
+
 ThreadedFileReader::ThreadedFileReader()
 {
 	m_readThread = std::thread([](ThreadedFileReader* r){ r->Loop(); }, this);
@@ -28,9 +37,9 @@ ThreadedFileReader::~ThreadedFileReader()
 	(void)std::lock_guard<std::mutex>{m_mtx};
 	m_condition.notify_one();
 	m_readThread.join();
-	for (auto& buffer : m_buffer)
-		if (buffer.ptr)
-			free(buffer.ptr);
+	StopWorkers();
+	for (CacheEntry& entry : m_cache)
+		free(entry.ptr);
 }
 
 size_t ThreadedFileReader::CopyBlocks(void* dst, const void* src, size_t size) const
@@ -70,7 +79,6 @@ void ThreadedFileReader::Loop()
 		u64 requestOffset;
 		u32 requestSize;
 
-		bool ok = true;
 		m_running = true;
 
 		for (;;)
@@ -81,7 +89,7 @@ void ThreadedFileReader::Loop()
 			lock.unlock();
 
 			if (ptr)
-				ok = Decompress(ptr, requestOffset, requestSize);
+				Decompress(ptr, requestOffset, requestSize);
 
 			// There's a potential for a race here when doing synchronous reads. Basically, another request can come in,
 			// after we release the lock, but before we store null to indicate we're finished. So, we do a compare-exchange
@@ -96,39 +104,6 @@ void ThreadedFileReader::Loop()
 			break;
 		}
 
-		if (ok)
-		{
-			// Readahead
-			Chunk chunk = ChunkForOffset(requestOffset + requestSize);
-			if (chunk.chunkID >= 0)
-			{
-				int buffersFilled = 0;
-				Buffer* buf = GetBlockPtr(chunk);
-				// Cancel readahead if a new request comes in
-				while (buf && !m_requestPtr.load(std::memory_order_acquire))
-				{
-					u32 bufsize = buf->size.load(std::memory_order_relaxed);
-					chunk = ChunkForOffset(buf->offset + bufsize);
-					if (chunk.chunkID < 0)
-						break;
-					if (buf->offset + bufsize != chunk.offset || chunk.length + bufsize > buf->cap)
-					{
-						buffersFilled++;
-						if (buffersFilled >= 2)
-							break;
-						buf = GetBlockPtr(chunk);
-					}
-					else
-					{
-						int amt = ReadChunk(static_cast<char*>(buf->ptr) + bufsize, chunk.chunkID);
-						if (amt <= 0)
-							break;
-						buf->size.store(bufsize + amt, std::memory_order_release);
-					}
-				}
-			}
-		}
-
 		lock.lock();
 		if (requestSize == m_requestSize && requestOffset == m_requestOffset && !m_requestPtr)
 		{
@@ -141,44 +116,325 @@ void ThreadedFileReader::Loop()
 	}
 }
 
-ThreadedFileReader::Buffer* ThreadedFileReader::GetBlockPtr(const Chunk& block)
+void ThreadedFileReader::WorkerLoop(u32 slot)
 {
-	for (int i = 0; i < static_cast<int>(std::size(m_buffer)); i++)
+	Threading::SetNameOfCurrentThread(TinyString::from_format("ISO Decompress {}", slot).c_str());
+
+	std::unique_lock<std::mutex> lock(m_cacheMtx);
+
+	while (true)
 	{
-		u32 size = m_buffer[i].size.load(std::memory_order_relaxed);
-		u64 offset = m_buffer[i].offset;
-		if (size && offset <= block.offset && offset + size >= block.offset + block.length)
-		{
-			m_nextBuffer = (i + 1) % std::size(m_buffer);
-			return m_buffer + i;
-		}
+		while (m_queue.empty() && !m_workersQuit)
+			m_workCondition.wait(lock);
+
+		if (m_workersQuit)
+			return;
+
+		const u32 index = m_queue.front();
+		m_queue.pop_front();
+
+		CacheEntry& entry = m_cache[index];
+		entry.state = CacheState::Busy;
+		const s64 chunkID = entry.chunkID;
+		void* ptr = entry.ptr;
+		lock.unlock();
+
+		const Common::Timer::Value start = Common::Timer::GetCurrentValue();
+		const int amt = (m_workerSlots > 1) ? DecompressChunk(ptr, chunkID, slot) : ReadChunk(ptr, chunkID);
+		const Common::Timer::Value time = Common::Timer::GetCurrentValue() - start;
+
+		lock.lock();
+		entry.size = static_cast<u32>(std::max(amt, 0));
+		entry.state = (amt > 0) ? CacheState::Ready : CacheState::Failed;
+		LruPushBack(index);
+		m_stats.decompressedBytes += entry.size;
+		m_stats.decompressSeconds += Common::Timer::ConvertValueToSeconds(time);
+		m_readyCondition.notify_all();
+	}
+}
+
+void ThreadedFileReader::StartWorkers(const std::unique_lock<std::mutex>& cacheLock)
+{
+	if (!m_workers.empty())
+		return;
+
+	// Size the cache in chunks of the opened file, they're all the same size except maybe the last one.
+	const Chunk first = ChunkForOffset(0);
+	const u32 chunkSize = std::max<u32>(first.length, 1);
+	const u32 cacheSize = (EmuConfig.CdvdCacheSize > 0) ? static_cast<u32>(EmuConfig.CdvdCacheSize) : DEFAULT_CACHE_SIZE_MB;
+	const u32 entries = std::max<u32>(static_cast<u32>((static_cast<u64>(cacheSize) * _1mb) / chunkSize), MINIMUM_CACHE_ENTRIES);
+
+	for (size_t i = entries; i < m_cache.size(); i++)
+		free(m_cache[i].ptr);
+	m_cache.resize(entries);
+	m_cacheMap.clear();
+	m_queue.clear();
+	m_lruHead = INVALID_ENTRY;
+	m_lruTail = INVALID_ENTRY;
+	for (u32 i = 0; i < entries; i++)
+	{
+		m_cache[i].chunkID = -1;
+		m_cache[i].size = 0;
+		m_cache[i].waiters = 0;
+		m_cache[i].state = CacheState::Empty;
+		LruPushBack(i);
+	}
+
+	// Decompressing is what takes the time, so only formats which can do several chunks at once get more than one worker.
+	m_workerSlots = std::max<u32>(GetDecompressSlots(), 1);
+	u32 workers = (EmuConfig.CdvdDecompressThreads > 0) ? static_cast<u32>(EmuConfig.CdvdDecompressThreads) :
+	                                                         std::clamp<u32>(std::thread::hardware_concurrency() / 2, 1, MAXIMUM_AUTO_WORKERS);
+	workers = std::min(workers, m_workerSlots);
+
+	m_workersQuit = false;
+	for (u32 i = 0; i < workers; i++)
+		m_workers.emplace_back([this, i]() { WorkerLoop(i); });
+}
+
+void ThreadedFileReader::StopWorkers()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_cacheMtx);
+		m_workersQuit = true;
+	}
+	m_workCondition.notify_all();
+
+	for (std::thread& worker : m_workers)
+		worker.join();
+	m_workers.clear();
+
+	std::unique_lock<std::mutex> lock(m_cacheMtx);
+	m_workersQuit = false;
+	m_queue.clear();
+	m_cacheMap.clear();
+	m_lruHead = INVALID_ENTRY;
+	m_lruTail = INVALID_ENTRY;
+	for (u32 i = 0; i < static_cast<u32>(m_cache.size()); i++)
+	{
+		m_cache[i].chunkID = -1;
+		m_cache[i].size = 0;
+		m_cache[i].waiters = 0;
+		m_cache[i].state = CacheState::Empty;
+		LruPushBack(i);
 	}
+	m_readahead = 0;
+	m_lastReadEnd = 0;
+}
+
+void ThreadedFileReader::LruRemove(u32 index)
+{
+	CacheEntry& entry = m_cache[index];
+	if (entry.prev != INVALID_ENTRY)
+		m_cache[entry.prev].next = entry.next;
+	else
+		m_lruHead = entry.next;
+	if (entry.next != INVALID_ENTRY)
+		m_cache[entry.next].prev = entry.prev;
+	else
+		m_lruTail = entry.prev;
+	entry.prev = INVALID_ENTRY;
+	entry.next = INVALID_ENTRY;
+}
+
+void ThreadedFileReader::LruPushBack(u32 index)
+{
+	CacheEntry& entry = m_cache[index];
+	entry.prev = m_lruTail;
+	entry.next = INVALID_ENTRY;
+	if (m_lruTail != INVALID_ENTRY)
+		m_cache[m_lruTail].next = index;
+	else
+		m_lruHead = index;
+	m_lruTail = index;
+}
 
-	Buffer& buf = m_buffer[m_nextBuffer];
+u32 ThreadedFileReader::AllocateEntry(const Chunk& chunk)
+{
+	u32 index = m_lruHead;
+	while (index != INVALID_ENTRY && m_cache[index].waiters > 0)
+		index = m_cache[index].next;
+	if (index == INVALID_ENTRY)
+		return INVALID_ENTRY;
+
+	CacheEntry& entry = m_cache[index];
+	LruRemove(index);
+	if (entry.chunkID >= 0)
+		m_cacheMap.erase(entry.chunkID);
+
+	const u32 size = std::max(chunk.length, 1u);
+	if (entry.cap < size)
+	{
+		entry.ptr = static_cast<u8*>(realloc(entry.ptr, size));
+		entry.cap = size;
+	}
+
+	entry.chunkID = chunk.chunkID;
+	entry.offset = chunk.offset;
+	entry.size = 0;
+	entry.state = CacheState::Queued;
+	m_cacheMap.emplace(chunk.chunkID, index);
+	return index;
+}
+
+void ThreadedFileReader::QueueChunks(u64 offset, u32 size, bool readahead, const std::unique_lock<std::mutex>& cacheLock)
+{
+	StartWorkers(cacheLock);
+
+	const u64 end = offset + size;
+	auto front = m_queue.begin();
+	bool queued = false;
+	while (offset < end)
 	{
-		// This can be called from both the read thread threads in ReadSync
-		// Calls from ReadSync are done with the lock already held to keep the read thread out
-		// Therefore we should only lock on the read thread
-		std::unique_lock<std::mutex> lock(m_mtx, std::defer_lock);
-		if (std::this_thread::get_id() == m_readThread.get_id())
-			lock.lock();
-		u32 size = std::max(block.length, MINIMUM_SIZE);
-		if (buf.cap < size)
+		const Chunk chunk = ChunkForOffset(offset);
+		if (chunk.chunkID < 0 || chunk.length == 0)
+			break;
+
+		// A reader with a bad chunk layout would otherwise spin here with the cache locked.
+		const u64 next_offset = chunk.offset + chunk.length;
+		if (next_offset <= offset)
 		{
-			buf.ptr = realloc(buf.ptr, size);
-			buf.cap = size;
+			Console.Error("ThreadedFileReader: Chunk %lld doesn't advance past offset %llu", static_cast<long long>(chunk.chunkID),
+				static_cast<unsigned long long>(offset));
+			break;
+		}
+		offset = next_offset;
+
+		if (m_cacheMap.find(chunk.chunkID) != m_cacheMap.end())
+			continue;
+
+		const u32 index = AllocateEntry(chunk);
+		if (index == INVALID_ENTRY)
+			break;
+
+		if (readahead)
+		{
+			m_queue.push_back(index);
+			m_stats.prefetched++;
+		}
+		else
+		{
+			// In front of any readahead, but still in order.
+			front = m_queue.insert(front, index) + 1;
 		}
-		buf.size.store(0, std::memory_order_relaxed);
+		queued = true;
 	}
-	int size = ReadChunk(buf.ptr, block.chunkID);
-	if (size > 0)
+
+	if (queued)
+		m_workCondition.notify_all();
+}
+
+ThreadedFileReader::CacheEntry* ThreadedFileReader::WaitForChunk(const Chunk& chunk, std::unique_lock<std::mutex>& cacheLock)
+{
+	StartWorkers(cacheLock);
+
+	bool requested = false;
+	bool counted = false;
+	for (;;)
 	{
-		buf.offset = block.offset;
-		buf.size.store(size, std::memory_order_release);
-		m_nextBuffer = (m_nextBuffer + 1) % std::size(m_buffer);
-		return &buf;
+		auto it = m_cacheMap.find(chunk.chunkID);
+		if (it == m_cacheMap.end())
+		{
+			// Failed last time we asked for it, give up.
+			if (requested)
+				return nullptr;
+
+			const u32 index = AllocateEntry(chunk);
+			if (index == INVALID_ENTRY)
+			{
+				// Everything is being decompressed, wait for some of it to finish.
+				m_readyCondition.wait(cacheLock);
+				continue;
+			}
+
+			m_queue.push_front(index);
+			m_workCondition.notify_one();
+			requested = true;
+			continue;
+		}
+
+		const u32 index = it->second;
+		CacheEntry& entry = m_cache[index];
+		if (!counted)
+		{
+			if (entry.state == CacheState::Ready)
+				m_stats.hits++;
+			else
+				m_stats.misses++;
+			counted = true;
+		}
+
+		switch (entry.state)
+		{
+			case CacheState::Ready:
+				LruRemove(index);
+				LruPushBack(index);
+				return &entry;
+
+			case CacheState::Failed:
+				// Readahead may have failed for reasons which don't apply any more, try once more.
+				m_cacheMap.erase(it);
+				entry.chunkID = -1;
+				entry.state = CacheState::Empty;
+				if (requested)
+					return nullptr;
+				continue;
+
+			case CacheState::Queued:
+				// Somebody needs it now, move it in front of the readahead.
+				if (!requested)
+				{
+					auto qit = std::find(m_queue.begin(), m_queue.end(), index);
+					if (qit != m_queue.end())
+					{
+						m_queue.erase(qit);
+						m_queue.push_front(index);
+					}
+					requested = true;
+				}
+				[[fallthrough]];
+
+			case CacheState::Busy:
+			default:
+				requested = true;
+				entry.waiters++;
+				m_readyCondition.wait(cacheLock);
+				entry.waiters--;
+				continue;
+		}
 	}
-	return nullptr;
+}
+
+u32 ThreadedFileReader::MaxReadahead()
+{
+	return std::max<u32>(
+		static_cast<u32>(std::min<u64>(static_cast<u64>(m_cache.size()) * ChunkForOffset(0).length / 2, UINT32_MAX)), MINIMUM_SIZE);
+}
+
+void ThreadedFileReader::Readahead(u64 offset, u32 size)
+{
+	const u64 end = offset + size;
+
+	std::unique_lock<std::mutex> lock(m_cacheMtx);
+
+	// The window doubles for every read continuing where the last one stopped (or skipping a little ahead),
+	// and starts over on a seek. It never goes past half the cache, so readahead can't evict itself.
+	const u32 maxReadahead = MaxReadahead();
+	if (offset >= m_lastReadEnd && offset - m_lastReadEnd <= std::max(m_readahead, MINIMUM_SIZE) && m_readahead > 0)
+		m_readahead = std::min(m_readahead * 2, maxReadahead);
+	else
+		m_readahead = MINIMUM_SIZE;
+	m_lastReadEnd = end;
+
+	QueueChunks(end, m_readahead, true, lock);
+}
+
+void ThreadedFileReader::Prefetch(u32 sector, u32 count)
+{
+	const u32 blocksize = InternalBlockSize();
+
+	std::unique_lock<std::mutex> lock(m_cacheMtx);
+	const u32 size = static_cast<u32>(std::min<u64>(static_cast<u64>(count) * blocksize, MaxReadahead()));
+	QueueChunks(static_cast<u64>(sector) * blocksize + m_dataoffset, size, true, lock);
 }
 
 bool ThreadedFileReader::Decompress(void* target, u64 begin, u32 size)
@@ -186,35 +442,32 @@ bool ThreadedFileReader::Decompress(void* target, u64 begin, u32 size)
 	char* write = static_cast<char*>(target);
 	u32 remaining = size;
 	u64 off = begin;
+
+	std::unique_lock<std::mutex> lock(m_cacheMtx);
+
+	// Queue the whole request at once so the workers can get on with all of it in parallel.
+	QueueChunks(begin, size, false, lock);
+
 	while (remaining)
 	{
 		if (m_requestCancelled.load(std::memory_order_relaxed))
 			return false;
 
-		Chunk chunk = ChunkForOffset(off);
-		if (m_internalBlockSize || chunk.offset != off || chunk.length > remaining)
-		{
-			Buffer* buf = GetBlockPtr(chunk);
-			if (!buf)
-				return false;
-			u32 bufoff = off - buf->offset;
-			u32 bufsize = buf->size.load(std::memory_order_relaxed);
-			if (bufsize <= bufoff)
-				return false;
-			u32 len = std::min(bufsize - bufoff, remaining);
-			write += CopyBlocks(write, static_cast<char*>(buf->ptr) + bufoff, len);
-			remaining -= len;
-			off += len;
-		}
-		else
-		{
-			int amt = ReadChunk(write, chunk.chunkID);
-			if (amt < static_cast<int>(chunk.length))
-				return false;
-			write += chunk.length;
-			remaining -= chunk.length;
-			off += chunk.length;
-		}
+		const Chunk chunk = ChunkForOffset(off);
+		if (chunk.chunkID < 0)
+			return false;
+
+		const CacheEntry* entry = WaitForChunk(chunk, lock);
+		if (!entry)
+			return false;
+
+		const u32 bufoff = static_cast<u32>(off - entry->offset);
+		if (entry->size <= bufoff)
+			return false;
+		const u32 len = std::min(entry->size - bufoff, remaining);
+		write += CopyBlocks(write, entry->ptr + bufoff, len);
+		remaining -= len;
+		off += len;
 	}
 	m_amtRead += write - static_cast<char*>(target);
 	return true;
@@ -222,33 +475,43 @@ bool ThreadedFileReader::Decompress(void* target, u64 begin, u32 size)
 
 bool ThreadedFileReader::TryCachedRead(void*& buffer, u64& offset, u32& size, const std::lock_guard<std::mutex>&)
 {
-	// Run through twice so that if m_buffer[1] contains the first half and m_buffer[0] contains the second half it still works
 	m_amtRead = 0;
-	u64 end = 0;
-	bool allDone = false;
-	for (int i = 0; i < static_cast<int>(std::size(m_buffer) * 2); i++)
+
+	std::unique_lock<std::mutex> lock(m_cacheMtx);
+	while (size > 0)
 	{
-		Buffer& buf = m_buffer[i % std::size(m_buffer)];
-		u32 bufsize = buf.size.load(std::memory_order_acquire);
-		if (!bufsize)
-			continue;
-		if (buf.offset <= offset && buf.offset + bufsize > offset)
-		{
-			u32 off = offset - buf.offset;
-			u32 cpysize = std::min(size, bufsize - off);
-			size_t read = CopyBlocks(buffer, static_cast<char*>(buf.ptr) + off, cpysize);
-			m_amtRead += read;
-			size -= cpysize;
-			offset += cpysize;
-			buffer = static_cast<char*>(buffer) + read;
-			if (size == 0)
-				end = buf.offset + bufsize;
-		}
-		// Do buffers contain the current and next block?
-		if (end > 0 && buf.offset == end)
-			allDone = true;
+		const Chunk chunk = ChunkForOffset(offset);
+		if (chunk.chunkID < 0)
+			break;
+
+		auto it = m_cacheMap.find(chunk.chunkID);
+		if (it == m_cacheMap.end() || m_cache[it->second].state != CacheState::Ready)
+			break;
+
+		CacheEntry& entry = m_cache[it->second];
+		const u32 off = static_cast<u32>(offset - entry.offset);
+		if (entry.size <= off)
+			break;
+
+		const u32 cpysize = std::min(size, entry.size - off);
+		const size_t read = CopyBlocks(buffer, entry.ptr + off, cpysize);
+		m_amtRead += read;
+		size -= cpysize;
+		offset += cpysize;
+		buffer = static_cast<char*>(buffer) + read;
+
+		LruRemove(it->second);
+		LruPushBack(it->second);
+		m_stats.hits++;
 	}
-	return allDone;
+
+	return (size == 0);
+}
+
+ThreadedFileReader::CacheStats ThreadedFileReader::GetCacheStats()
+{
+	std::unique_lock<std::mutex> lock(m_cacheMtx);
+	return m_stats;
 }
 
 bool ThreadedFileReader::Precache(ProgressCallback* progress, Error* error)
@@ -286,6 +549,10 @@ bool ThreadedFileReader::CheckAvailableMemoryForPrecaching(u64 required_size, Er
 bool ThreadedFileReader::Open(std::string filename, Error* error)
 {
 	CancelAndWaitUntilStopped();
+	{
+		std::unique_lock<std::mutex> lock(m_cacheMtx);
+		m_stats = {};
+	}
 	return Open2(std::move(filename), error);
 }
 
@@ -296,37 +563,24 @@ int ThreadedFileReader::ReadSync(void* pBuffer, u32 sector, u32 count)
 	u32 size = count * blocksize;
 	{
 		std::lock_guard<std::mutex> l(m_mtx);
-		if (TryCachedRead(pBuffer, offset, size, l))
+		const bool cached = TryCachedRead(pBuffer, offset, size, l);
+		Readahead((u64)sector * (u64)blocksize + m_dataoffset, count * blocksize);
+		if (cached)
 			return m_amtRead;
 
-		if (size > 0 && !m_running)
+		if (!m_running)
 		{
 			// Don't wait for read thread to start back up
 			if (Decompress(pBuffer, offset, size))
-			{
-				offset += size;
-				size = 0;
-			}
+				return m_amtRead;
 		}
 
-		if (size == 0)
-		{
-			// For readahead
-			m_requestOffset = offset - 1;
-			m_requestSize = 1;
-			m_requestPtr.store(nullptr, std::memory_order_relaxed);
-		}
-		else
-		{
-			m_requestOffset = offset;
-			m_requestSize = size;
-			m_requestPtr.store(pBuffer, std::memory_order_relaxed);
-		}
+		m_requestOffset = offset;
+		m_requestSize = size;
+		m_requestPtr.store(pBuffer, std::memory_order_relaxed);
 		m_requestCancelled.store(false, std::memory_order_relaxed);
 	}
 	m_condition.notify_one();
-	if (size == 0)
-		return m_amtRead;
 	return FinishRead();
 }
 
@@ -341,6 +595,9 @@ void ThreadedFileReader::CancelAndWaitUntilStopped(void)
 
 	while (m_running)
 		m_condition.wait(lock);
+
+	// The format may change its decompression state after this, so nothing can be left running.
+	StopWorkers();
 }
 
 void ThreadedFileReader::BeginRead(void* pBuffer, u32 sector, u32 count)
@@ -350,21 +607,14 @@ void ThreadedFileReader::BeginRead(void* pBuffer, u32 sector, u32 count)
 	u32 size = count * blocksize;
 	{
 		std::lock_guard<std::mutex> l(m_mtx);
-		if (TryCachedRead(pBuffer, offset, size, l))
+		const bool cached = TryCachedRead(pBuffer, offset, size, l);
+		Readahead((u64)sector * (u64)blocksize + m_dataoffset, count * blocksize);
+		if (cached)
 			return;
-		if (size == 0)
-		{
-			// For readahead
-			m_requestOffset = offset - 1;
-			m_requestSize = 1;
-			m_requestPtr.store(nullptr, std::memory_order_relaxed);
-		}
-		else
-		{
-			m_requestOffset = offset;
-			m_requestSize = size;
-			m_requestPtr.store(pBuffer, std::memory_order_relaxed);
-		}
+
+		m_requestOffset = offset;
+		m_requestSize = size;
+		m_requestPtr.store(pBuffer, std::memory_order_relaxed);
 		m_requestCancelled.store(false, std::memory_order_relaxed);
 	}
 	m_condition.notify_one();
@@ -393,8 +643,15 @@ void ThreadedFileReader::CancelRead(void)
 void ThreadedFileReader::Close(void)
 {
 	CancelAndWaitUntilStopped();
-	for (auto& buf : m_buffer)
-		buf.size.store(0, std::memory_order_relaxed);
+
+	const CacheStats stats = GetCacheStats();
+	if (stats.hits + stats.misses > 0)
+	{
+		DEV_LOG("ISO cache: {} hits, {} misses, {} chunks read ahead, {:.1f} MB/s decompressed.",
+			stats.hits, stats.misses, stats.prefetched,
+			(stats.decompressSeconds > 0.0) ? (static_cast<double>(stats.decompressedBytes) / _1mb / stats.decompressSeconds) : 0.0);
+	}
+
 	Close2();
 }
 
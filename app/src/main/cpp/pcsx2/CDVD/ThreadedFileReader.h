@@ -9,15 +9,31 @@
 #include <mutex>
 #include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <unordered_map>
+#include <vector>
 
 class Error;
 class ProgressCallback;
 
 /// A file reader for use with compressed formats
 /// Calls decompression code on a separate thread to make a synchronous decompression API async
+/// Decompressed chunks are kept in an LRU cache, which a small pool of workers fills ahead of sequential reads
 class ThreadedFileReader
 {
 	ThreadedFileReader(ThreadedFileReader&&) = delete;
+public:
+	struct CacheStats
+	{
+		u64 hits;
+		u64 misses;
+		/// Chunks decompressed by readahead
+		u64 prefetched;
+		u64 decompressedBytes;
+		/// Combined time the workers spent decompressing, in seconds
+		double decompressSeconds;
+	};
+
 protected:
 	std::string m_filename;
 
@@ -41,6 +57,11 @@ protected:
 	virtual Chunk ChunkForOffset(u64 offset) = 0;
 	/// Synchronously read the given block into `dst`
 	virtual int ReadChunk(void* dst, s64 chunkID) = 0;
+	/// Number of chunks the format can decompress at the same time
+	/// Formats returning more than one get their chunks through DecompressChunk() from several workers
+	virtual u32 GetDecompressSlots() const { return 1; }
+	/// ReadChunk() which may be called concurrently, as long as every call uses a different `slot`
+	virtual int DecompressChunk(void* dst, s64 chunkID, u32 slot) { return ReadChunk(dst, chunkID); }
 	/// AsyncFileReader open but ThreadedFileReader needs prep work first
 	virtual bool Open2(std::string filename, Error* error) = 0;
 	/// AsyncFileReader precache but ThreadedFileReader needs prep work first
@@ -65,17 +86,6 @@ private:
 	/// Used to cancel requests early
 	/// Note: It might take a while for the cancellation request to be noticed, wait until `m_requestPtr` is cleared to ensure it's not being written to
 	std::atomic<bool> m_requestCancelled{false};
-	struct Buffer
-	{
-		void* ptr = nullptr;
-		u64 offset = 0;
-		std::atomic<u32> size{0};
-		u32 cap = 0;
-	};
-	/// 2 buffers for readahead (current block, next block)
-	Buffer m_buffer[2];
-	u32 m_nextBuffer = 0;
-
 	std::thread m_readThread;
 	std::mutex m_mtx;
 	std::condition_variable m_condition;
@@ -85,6 +95,52 @@ private:
 	/// View while holding `m_mtx`.  If false, you may touch decompression functions from other threads
 	bool m_running = false;
 
+	enum class CacheState : u8
+	{
+		Empty,
+		Queued,
+		Busy,
+		Ready,
+		Failed,
+	};
+	struct CacheEntry
+	{
+		s64 chunkID = -1;
+		u64 offset = 0;
+		u8* ptr = nullptr;
+		u32 cap = 0;
+		u32 size = 0;
+		/// Readers waiting for this entry, it can't be evicted before they're done
+		u32 waiters = 0;
+		/// LRU list links, only entries which are not queued or busy are in the list
+		u32 prev = INVALID_ENTRY;
+		u32 next = INVALID_ENTRY;
+		CacheState state = CacheState::Empty;
+	};
+	static constexpr u32 INVALID_ENTRY = 0xFFFFFFFFu;
+
+	/// Everything below is protected by `m_cacheMtx`, which may be taken while holding `m_mtx` but not the other way around
+	std::mutex m_cacheMtx;
+	/// Signalled when work is queued for the workers
+	std::condition_variable m_workCondition;
+	/// Signalled when a worker finished a chunk
+	std::condition_variable m_readyCondition;
+	std::vector<CacheEntry> m_cache;
+	std::unordered_map<s64, u32> m_cacheMap;
+	u32 m_lruHead = INVALID_ENTRY;
+	u32 m_lruTail = INVALID_ENTRY;
+	/// Entries waiting for a worker, chunks somebody is waiting for go to the front
+	std::deque<u32> m_queue;
+	std::vector<std::thread> m_workers;
+	u32 m_workerSlots = 1;
+	bool m_workersQuit = false;
+
+	/// Readahead window in bytes, grows while reads stay sequential
+	u32 m_readahead = 0;
+	u64 m_lastReadEnd = 0;
+
+	CacheStats m_stats = {};
+
 	/// Get the internal block size
 	u32 InternalBlockSize() const { return m_internalBlockSize ? m_internalBlockSize : m_blocksize; }
 	/// memcpy from internal to external blocks
@@ -94,9 +150,27 @@ private:
 
 	/// Main loop of read thread
 	void Loop();
-
-	/// Load the given block into one of the `m_buffer` buffers if necessary and return a pointer to its contents if successful
-	Buffer* GetBlockPtr(const Chunk& block);
+	/// Main loop of a decompression worker
+	void WorkerLoop(u32 slot);
+
+	/// Sizes the cache and starts the workers if they aren't running
+	void StartWorkers(const std::unique_lock<std::mutex>& cacheLock);
+	/// Waits for the workers to exit and empties the cache
+	void StopWorkers();
+	void LruRemove(u32 index);
+	void LruPushBack(u32 index);
+	/// Takes the least recently used entry which nobody is waiting for, for the given chunk
+	/// Returns INVALID_ENTRY if everything is queued or in use
+	u32 AllocateEntry(const Chunk& chunk);
+	/// Queues every chunk from `offset` to `offset + size` which isn't cached yet, readahead goes behind everything else
+	/// Stops early if the cache has no room left
+	void QueueChunks(u64 offset, u32 size, bool readahead, const std::unique_lock<std::mutex>& cacheLock);
+	/// Returns the cache entry of the given chunk once it's decompressed, or null on failure
+	CacheEntry* WaitForChunk(const Chunk& chunk, std::unique_lock<std::mutex>& cacheLock);
+	/// Largest readahead or prefetch, in bytes
+	u32 MaxReadahead();
+	/// Grows or resets the readahead window depending on how `offset` follows the previous read, and queues it
+	void Readahead(u64 offset, u32 size);
 	/// Decompress from offset to size into
 	bool Decompress(void* ptr, u64 offset, u32 size);
 	/// Cancel any inflight read and wait until the thread is no longer doing anything
@@ -114,6 +188,8 @@ public:
 
 	virtual u32 GetBlockCount() const = 0;
 
+	/// Counters since the file was opened, for sizing the cache and worker count
+	CacheStats GetCacheStats();
 
 	bool Open(std::string filename, Error* error);
 	bool Precache(ProgressCallback* progress, Error* error);
@@ -121,6 +197,9 @@ public:
 	void BeginRead(void* pBuffer, u32 sector, u32 count);
 	int FinishRead();
 	void CancelRead();
+	/// Queues the given sectors for decompression behind any pending reads, without waiting for them
+	/// Limited to what the readahead window may grow to, so it can't push out the chunks it's prefetching
+	void Prefetch(u32 sector, u32 count);
 	void Close();
 	void SetBlockSize(u32 bytes);
 	void SetDataOffset(u32 bytes);
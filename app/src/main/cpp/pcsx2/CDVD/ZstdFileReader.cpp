@@ -0,0 +1,283 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "CDVD/ZstdFileReader.h"
+
+#include "common/Assertions.h"
+#include "common/Console.h"
+#include "common/FileSystem.h"
+#include "common/Error.h"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <cstring>
+#include <zstd.h>
+
+static constexpr u32 ZSTD_DECOMPRESS_SLOTS = 4;
+
+template <typename T>
+static T ReadLE(const u8* ptr)
+{
+	T value;
+	std::memcpy(&value, ptr, sizeof(value));
+	return value;
+}
+
+ZstdFileReader::ZstdFileReader() = default;
+
+ZstdFileReader::~ZstdFileReader()
+{
+	pxAssert(!m_src);
+}
+
+bool ZstdFileReader::Open2(std::string filename, Error* error)
+{
+	Close2();
+	m_filename = std::move(filename);
+	m_src = FileSystem::OpenCFile(m_filename.c_str(), "rb", error);
+
+	if (!m_src || !ReadSeekTable(error))
+	{
+		Close2();
+		return false;
+	}
+
+	// The other slots are set up when a worker first uses them.
+	m_slots = std::make_unique<DecompressSlot[]>(ZSTD_DECOMPRESS_SLOTS);
+	if (!InitializeSlot(m_slots[0]))
+	{
+		Error::SetString(error, "Unable to create zstd decompression context.");
+		Close2();
+		return false;
+	}
+
+	return true;
+}
+
+bool ZstdFileReader::ReadSeekTable(Error* error)
+{
+	const s64 file_size = FileSystem::FSize64(m_src);
+	if (file_size < SEEK_TABLE_FOOTER_SIZE + 8)
+	{
+		Error::SetString(error, "File is too small to be a seekable zstd image.");
+		return false;
+	}
+
+	u8 footer[SEEK_TABLE_FOOTER_SIZE];
+	if (FileSystem::FSeek64(m_src, file_size - SEEK_TABLE_FOOTER_SIZE, SEEK_SET) != 0 ||
+		std::fread(footer, sizeof(footer), 1, m_src) != 1)
+	{
+		Error::SetString(error, "Failed to read seek table footer.");
+		return false;
+	}
+
+	const u32 num_frames = ReadLE<u32>(&footer[0]);
+	const u8 descriptor = footer[4];
+	if (ReadLE<u32>(&footer[5]) != SEEKABLE_MAGIC)
+	{
+		Error::SetString(error, "File is not a seekable zstd image, it has no seek table.");
+		return false;
+	}
+	if ((descriptor & 0x7C) != 0)
+	{
+		Error::SetString(error, "Seek table descriptor has reserved bits set.");
+		return false;
+	}
+
+	const u32 entry_size = (descriptor & SEEK_TABLE_CHECKSUM_FLAG) ? 12 : 8;
+	const u64 table_size = static_cast<u64>(num_frames) * entry_size;
+	if (num_frames == 0 || table_size + SEEK_TABLE_FOOTER_SIZE + 8 > static_cast<u64>(file_size))
+	{
+		Error::SetStringFmt(error, "Seek table with {} frames does not fit in the file.", num_frames);
+		return false;
+	}
+
+	// The table is stored in a skippable frame, so plain zstd tools still see a valid stream.
+	const u64 table_frame_offset = static_cast<u64>(file_size) - SEEK_TABLE_FOOTER_SIZE - table_size - 8;
+	std::vector<u8> table(table_size + 8);
+	if (FileSystem::FSeek64(m_src, table_frame_offset, SEEK_SET) != 0 ||
+		std::fread(table.data(), table.size(), 1, m_src) != 1)
+	{
+		Error::SetString(error, "Failed to read seek table.");
+		return false;
+	}
+	if (ReadLE<u32>(&table[0]) != SKIPPABLE_MAGIC || ReadLE<u32>(&table[4]) != table_size + SEEK_TABLE_FOOTER_SIZE)
+	{
+		Error::SetString(error, "Seek table frame header is corrupted.");
+		return false;
+	}
+
+	m_frames.resize(num_frames);
+	m_maxCompressedSize = 0;
+	u64 compressed_offset = 0;
+	u64 offset = 0;
+	for (u32 i = 0; i < num_frames; i++)
+	{
+		const u8* entry = &table[8 + static_cast<size_t>(i) * entry_size];
+		Frame& frame = m_frames[i];
+		frame.compressedOffset = compressed_offset;
+		frame.offset = offset;
+		frame.compressedSize = ReadLE<u32>(&entry[0]);
+		frame.size = ReadLE<u32>(&entry[4]);
+
+		if (frame.size == 0 || frame.size > MAX_FRAME_SIZE || frame.compressedSize == 0)
+		{
+			Error::SetStringFmt(error, "Frame {} has an unsupported size ({} bytes, {} compressed).",
+				i, frame.size, frame.compressedSize);
+			return false;
+		}
+
+		compressed_offset += frame.compressedSize;
+		offset += frame.size;
+		m_maxCompressedSize = std::max(m_maxCompressedSize, frame.compressedSize);
+	}
+
+	if (compressed_offset > table_frame_offset)
+	{
+		Error::SetString(error, "Seek table references data past the end of the file.");
+		return false;
+	}
+
+	m_totalSize = offset;
+	return true;
+}
+
+bool ZstdFileReader::Precache2(ProgressCallback* progress, Error* error)
+{
+	if (!m_src)
+		return false;
+
+	const s64 size = FileSystem::FSize64(m_src);
+	if (size < 0 || !CheckAvailableMemoryForPrecaching(static_cast<u64>(size), error))
+		return false;
+
+	m_file_cache_size = static_cast<size_t>(size);
+	m_file_cache = std::make_unique_for_overwrite<u8[]>(m_file_cache_size);
+	if (FileSystem::FSeek64(m_src, 0, SEEK_SET) != 0 ||
+		FileSystem::ReadFileWithProgress(
+			m_src, m_file_cache.get(), m_file_cache_size, progress, error) != m_file_cache_size)
+	{
+		m_file_cache.reset();
+		return false;
+	}
+
+	for (u32 i = 0; i < ZSTD_DECOMPRESS_SLOTS; i++)
+		m_slots[i].readBuffer.reset();
+	std::fclose(m_src);
+	m_src = nullptr;
+	return true;
+}
+
+bool ZstdFileReader::InitializeSlot(DecompressSlot& slot)
+{
+	if (!slot.readBuffer && !m_file_cache)
+		slot.readBuffer = std::make_unique_for_overwrite<u8[]>(m_maxCompressedSize);
+
+	if (!slot.dctx)
+		slot.dctx = ZSTD_createDCtx();
+
+	return slot.dctx != nullptr;
+}
+
+void ZstdFileReader::Close2()
+{
+	m_filename.clear();
+
+	if (m_src)
+	{
+		std::fclose(m_src);
+		m_src = nullptr;
+	}
+	if (m_file_cache)
+		m_file_cache.reset();
+
+	if (m_slots)
+	{
+		for (u32 i = 0; i < ZSTD_DECOMPRESS_SLOTS; i++)
+			ZSTD_freeDCtx(m_slots[i].dctx);
+		m_slots.reset();
+	}
+
+	m_frames.clear();
+	m_maxCompressedSize = 0;
+	m_totalSize = 0;
+}
+
+u32 ZstdFileReader::GetBlockCount() const
+{
+	return static_cast<u32>((m_totalSize - m_dataoffset) / m_blocksize);
+}
+
+ThreadedFileReader::Chunk ZstdFileReader::ChunkForOffset(u64 offset)
+{
+	Chunk chunk = {0};
+	if (offset >= m_totalSize)
+	{
+		chunk.chunkID = -1;
+	}
+	else
+	{
+		// Converters usually write equally sized frames, but the format doesn't require it.
+		const auto it = std::upper_bound(m_frames.begin(), m_frames.end(), offset,
+			[](u64 value, const Frame& frame) { return value < frame.offset; });
+		chunk.chunkID = static_cast<s64>(it - m_frames.begin()) - 1;
+		chunk.offset = m_frames[chunk.chunkID].offset;
+		chunk.length = m_frames[chunk.chunkID].size;
+	}
+	return chunk;
+}
+
+int ZstdFileReader::ReadChunk(void* dst, s64 chunkID)
+{
+	return DecompressChunk(dst, chunkID, 0);
+}
+
+u32 ZstdFileReader::GetDecompressSlots() const
+{
+	return ZSTD_DECOMPRESS_SLOTS;
+}
+
+int ZstdFileReader::DecompressChunk(void* dst, s64 chunkID, u32 slot_index)
+{
+	if (chunkID < 0 || static_cast<u64>(chunkID) >= m_frames.size())
+		return -1;
+
+	DecompressSlot& slot = m_slots[slot_index];
+	if (!InitializeSlot(slot))
+	{
+		Console.Error("Unable to create zstd decompression context.");
+		return 0;
+	}
+
+	const Frame& frame = m_frames[chunkID];
+	const u8* src;
+	if (m_file_cache)
+	{
+		if (frame.compressedOffset + frame.compressedSize > m_file_cache_size)
+			return 0;
+
+		src = &m_file_cache[frame.compressedOffset];
+	}
+	else
+	{
+		std::lock_guard<std::mutex> lock(m_src_mutex);
+		if (FileSystem::FSeek64(m_src, frame.compressedOffset, SEEK_SET) != 0 ||
+			std::fread(slot.readBuffer.get(), frame.compressedSize, 1, m_src) != 1)
+		{
+			Console.Error(fmt::format("Unable to read zstd frame {}.", chunkID));
+			return 0;
+		}
+		src = slot.readBuffer.get();
+	}
+
+	const size_t result = ZSTD_decompressDCtx(slot.dctx, dst, frame.size, src, frame.compressedSize);
+	if (ZSTD_isError(result) || result != frame.size)
+	{
+		Console.Error(fmt::format("Unable to decompress zstd frame {}: {}", chunkID,
+			ZSTD_isError(result) ? ZSTD_getErrorName(result) : "size mismatch"));
+		return 0;
+	}
+
+	return static_cast<int>(frame.size);
+}
@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "ThreadedFileReader.h"
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+typedef struct ZSTD_DCtx_s ZSTD_DCtx;
+
+/// Reads images made of independent zstd frames followed by a seek table, as described in
+/// https://github.com/facebook/zstd/blob/dev/contrib/seekable_format/zstd_seekable_compression_format.md
+class ZstdFileReader final : public ThreadedFileReader
+{
+	DeclareNoncopyableObject(ZstdFileReader);
+
+public:
+	static constexpr u32 SKIPPABLE_MAGIC = 0x184D2A5E;
+	static constexpr u32 SEEKABLE_MAGIC = 0x8F92EAB1;
+	static constexpr u32 SEEK_TABLE_FOOTER_SIZE = 9;
+	static constexpr u8 SEEK_TABLE_CHECKSUM_FLAG = 0x80;
+	/// Largest frame we're willing to decompress, the format itself allows up to 4GB
+	static constexpr u32 MAX_FRAME_SIZE = 16 * 1024 * 1024;
+
+	ZstdFileReader();
+	~ZstdFileReader() override;
+
+	bool Open2(std::string filename, Error* error) override;
+
+	bool Precache2(ProgressCallback* progress, Error* error) override;
+
+	Chunk ChunkForOffset(u64 offset) override;
+	int ReadChunk(void* dst, s64 chunkID) override;
+	u32 GetDecompressSlots() const override;
+	int DecompressChunk(void* dst, s64 chunkID, u32 slot) override;
+
+	void Close2() override;
+
+	u32 GetBlockCount() const override;
+
+private:
+	struct Frame
+	{
+		u64 compressedOffset;
+		u64 offset;
+		u32 compressedSize;
+		u32 size;
+	};
+
+	/// Frames are independent, so every worker gets its own buffer and decompression context
+	struct DecompressSlot
+	{
+		std::unique_ptr<u8[]> readBuffer;
+		ZSTD_DCtx* dctx = nullptr;
+	};
+
+	bool ReadSeekTable(Error* error);
+	bool InitializeSlot(DecompressSlot& slot);
+
+	std::vector<Frame> m_frames;
+	std::unique_ptr<DecompressSlot[]> m_slots;
+	u32 m_maxCompressedSize = 0;
+	u64 m_totalSize = 0;
+
+	std::FILE* m_src = nullptr;
+	/// Held while seeking and reading `m_src`, decompression happens outside of it
+	std::mutex m_src_mutex;
+	std::unique_ptr<u8[]> m_file_cache;
+	size_t m_file_cache_size = 0;
+};
@@ -371,6 +371,7 @@ enum class GSDumpCompressionMethod : u8
 	Uncompressed,
 	LZMA,
 	Zstandard,
+	ZstandardChunked,
 };
 
 enum class SavestateCompressionMethod : u8
@@ -617,6 +618,26 @@ struct Pcsx2Config
 			EnableFastmem : 1;
 		bool
 			PauseOnTLBMiss : 1;
+		bool
+			EnableEEBlockCache : 1;
+		bool
+			EnableEETieredCompile : 1;
+		bool
+			EnableEEReturnStack : 1;
+		bool
+			EnableEETraceFormation : 1;
+		bool
+			EnableEERegisterPinning : 1;
+		bool
+			EnableFastmemFaultHistory : 1;
+		bool
+			EnableVUProgramCache : 1;
+		bool
+			EnableIOPFastmem : 1;
+		bool
+			EnableIOPRegisterLiveness : 1;
+		bool
+			EnableJITCounters : 1;
 		BITFIELD_END
 
 		RecompilerOptions();
@@ -724,6 +745,9 @@ struct Pcsx2Config
 					HWSpinCPUForReadbacks : 1,
 					GPUPaletteConversion : 1,
 					AutoFlushSW : 1,
+					SWTileBinning : 1,
+					SWDrawPipeline : 1,
+					SWCoarseZ : 1,
 					PreloadFrameWithGSData : 1,
 					Mipmap : 1,
 					HWMipmap : 1,
@@ -1053,6 +1077,7 @@ struct Pcsx2Config
 			WaitLoop : 1, // enables constant loop detection and fast-forwarding
 			vuFlagHack : 1, // microVU specific flag hack
 			vuThread : 1, // Enable Threaded VU1
+			vuThreadPipeline : 1, // Run VU1 programs on a second thread while MTVU keeps unpacking (MTVU only)
 			vu1Instant : 1; // Enable Instant VU1 (Without MTVU only)
 		BITFIELD_END
 
@@ -1263,6 +1288,8 @@ struct Pcsx2Config
 		CdvdVerboseReads : 1, // enables cdvd read activity verbosely dumped to the console
 		CdvdDumpBlocks : 1, // enables cdvd block dumping
 		CdvdPrecache : 1, // enables cdvd precaching of compressed images
+		CdvdPrefetchExtents : 1, // prefetches along the file being read, using the disc's directory
+		CdvdTraceReads : 1, // records the sectors the game reads, for replaying as a benchmark
 		EnablePatches : 1, // enables patch detection and application
 		EnableCheats : 1, // enables cheat detection and application
 		EnablePINE : 1, // enables inter-process communication
@@ -1313,6 +1340,9 @@ struct Pcsx2Config
 
 	int PINESlot;
 
+	int CdvdCacheSize; // decompressed chunk cache of compressed images, in MB
+	int CdvdDecompressThreads; // 0 = automatic
+
 	int RtcYear;
 	int RtcMonth;
 	int RtcDay;
@@ -1406,6 +1436,7 @@ namespace EmuFolders
 
 //#ifdef _M_X86 // TODO(Stenzek): Remove me once EE/VU/IOP recs are added.
 #define THREAD_VU1 (EmuConfig.Cpu.Recompiler.EnableVU1 && EmuConfig.Speedhacks.vuThread)
+#define THREAD_VU1_PIPELINE (THREAD_VU1 && EmuConfig.Speedhacks.vuThreadPipeline)
 //#else
 //#define THREAD_VU1 false
 //#endif
@@ -1414,6 +1445,16 @@ namespace EmuFolders
 #define CHECK_CACHE (EmuConfig.Cpu.Recompiler.EnableEECache)
 #define CHECK_IOPREC (EmuConfig.Cpu.Recompiler.EnableIOP)
 #define CHECK_FASTMEM (EmuConfig.Cpu.Recompiler.EnableEE && EmuConfig.Cpu.Recompiler.EnableFastmem)
+#define CHECK_EEBLOCKCACHE (EmuConfig.Cpu.Recompiler.EnableEE && EmuConfig.Cpu.Recompiler.EnableEEBlockCache)
+#define CHECK_EETIEREDCOMPILE (EmuConfig.Cpu.Recompiler.EnableEE && EmuConfig.Cpu.Recompiler.EnableEETieredCompile)
+#define CHECK_EERETURNSTACK (EmuConfig.Cpu.Recompiler.EnableEE && EmuConfig.Cpu.Recompiler.EnableEEReturnStack)
+#define CHECK_EETRACEFORMATION (EmuConfig.Cpu.Recompiler.EnableEE && EmuConfig.Cpu.Recompiler.EnableEETraceFormation)
+#define CHECK_EEREGPINNING (EmuConfig.Cpu.Recompiler.EnableEE && EmuConfig.Cpu.Recompiler.EnableEERegisterPinning)
+#define CHECK_FASTMEMFAULTHISTORY (CHECK_FASTMEM && EmuConfig.Cpu.Recompiler.EnableFastmemFaultHistory)
+#define CHECK_VUPROGCACHE (EmuConfig.Cpu.Recompiler.EnableVUProgramCache)
+#define CHECK_JITCOUNTERS (EmuConfig.Cpu.Recompiler.EnableJITCounters)
+#define CHECK_IOPFASTMEM (EmuConfig.Cpu.Recompiler.EnableIOP && EmuConfig.Cpu.Recompiler.EnableIOPFastmem)
+#define CHECK_IOPREGLIVENESS (EmuConfig.Cpu.Recompiler.EnableIOP && EmuConfig.Cpu.Recompiler.EnableIOPRegisterLiveness)
 #define CHECK_EXTRAMEM (memGetExtraMemMode())
 
 //------------ SPECIAL GAME FIXES!!! ---------------
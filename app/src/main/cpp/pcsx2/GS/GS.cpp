@@ -534,6 +534,9 @@ void GSGameChanged()
 	if (GSIsHardwareRenderer())
 		GSTextureReplacements::GameChanged();
 
+	if (g_gs_renderer)
+		g_gs_renderer->GameChanged();
+
 	if (!VMManager::HasValidVM() && GSCapture::IsCapturing())
 		GSCapture::EndCapture();
 }
@@ -693,13 +696,18 @@ void GSgetStats(SmallStringBase& info)
 			prefix = '\0';
 		}
 
-		info.format("{} SW | {} SP | {} P | {} D | {:.2f} S | {:.2f} U | {:.2f} {}pps",
+		const double tex_lookups = pm.Get(GSPerfMon::TextureLookups);
+		const double tex_hit_rate = (tex_lookups > 0.0) ? (pm.Get(GSPerfMon::TextureHits) * 100.0 / tex_lookups) : 0.0;
+
+		info.format("{} SW | {} SP | {} P | {} D | {:.2f} S | {:.2f} U | {:.0f}% TH | {} CE | {:.2f} {}pps",
 			api_name,
 			(int)pm.Get(GSPerfMon::SyncPoint),
 			(int)pm.Get(GSPerfMon::Prim),
 			(int)pm.Get(GSPerfMon::Draw),
 			pm.Get(GSPerfMon::Swizzle) / 1024,
 			pm.Get(GSPerfMon::Unswizzle) / 1024,
+			tex_hit_rate,
+			(int)std::ceil(pm.Get(GSPerfMon::CLUTExpands)),
 			pps,prefix);
 	}
 	else if (GSCurrentRenderer == GSRendererType::Null)
@@ -789,7 +797,10 @@ void GSUpdateConfig(const Pcsx2Config::GSOptions& new_config)
 
 	// Options which aren't using the global struct yet, so we need to recreate all GS objects.
 	if (GSConfig.SWExtraThreads != old_config.SWExtraThreads ||
-		GSConfig.SWExtraThreadsHeight != old_config.SWExtraThreadsHeight)
+		GSConfig.SWExtraThreadsHeight != old_config.SWExtraThreadsHeight ||
+		GSConfig.SWTileBinning != old_config.SWTileBinning ||
+		GSConfig.SWDrawPipeline != old_config.SWDrawPipeline ||
+		GSConfig.SWCoarseZ != old_config.SWCoarseZ)
 	{
 		if (!GSreopen(false, true, GSConfig.Renderer, &old_config))
 			pxFailRel("Failed to do quick GS reopen");
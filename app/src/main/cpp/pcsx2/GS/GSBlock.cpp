@@ -22,3 +22,50 @@ constinit const GSVector4i GSBlock::m_uw8hmask0(0, 0, 0, 0, 1, 1, 1, 1, 8, 8, 8,
 constinit const GSVector4i GSBlock::m_uw8hmask1(2, 2, 2, 2, 3, 3, 3, 3, 10, 10, 10, 10, 11, 11, 11, 11);
 constinit const GSVector4i GSBlock::m_uw8hmask2(4, 4, 4, 4, 5, 5, 5, 5, 12, 12, 12, 12, 13, 13, 13, 13);
 constinit const GSVector4i GSBlock::m_uw8hmask3(6, 6, 6, 6, 7, 7, 7, 7, 14, 14, 14, 14, 15, 15, 15, 15);
+
+#if GS_BLOCK_NEON_TBL
+
+// Byte permutations of a whole 64 byte column, so each output vector is a single 4 register tbl.
+// Taken from the generic GSVector4i paths, the second row of the 8 bit tables is for odd columns.
+alignas(16) constinit const u8 GSBlock::m_neon_r16tbl[64] = {
+	0, 1, 4, 5, 16, 17, 20, 21, 32, 33, 36, 37, 48, 49, 52, 53,
+	2, 3, 6, 7, 18, 19, 22, 23, 34, 35, 38, 39, 50, 51, 54, 55,
+	8, 9, 12, 13, 24, 25, 28, 29, 40, 41, 44, 45, 56, 57, 60, 61,
+	10, 11, 14, 15, 26, 27, 30, 31, 42, 43, 46, 47, 58, 59, 62, 63,
+};
+alignas(16) constinit const u8 GSBlock::m_neon_w16tbl[64] = {
+	0, 1, 16, 17, 2, 3, 18, 19, 32, 33, 48, 49, 34, 35, 50, 51,
+	4, 5, 20, 21, 6, 7, 22, 23, 36, 37, 52, 53, 38, 39, 54, 55,
+	8, 9, 24, 25, 10, 11, 26, 27, 40, 41, 56, 57, 42, 43, 58, 59,
+	12, 13, 28, 29, 14, 15, 30, 31, 44, 45, 60, 61, 46, 47, 62, 63,
+};
+alignas(16) constinit const u8 GSBlock::m_neon_r8tbl[2][64] = {
+	{
+		0, 4, 16, 20, 32, 36, 48, 52, 2, 6, 18, 22, 34, 38, 50, 54,
+		8, 12, 24, 28, 40, 44, 56, 60, 10, 14, 26, 30, 42, 46, 58, 62,
+		33, 37, 49, 53, 1, 5, 17, 21, 35, 39, 51, 55, 3, 7, 19, 23,
+		41, 45, 57, 61, 9, 13, 25, 29, 43, 47, 59, 63, 11, 15, 27, 31,
+	},
+	{
+		32, 36, 48, 52, 0, 4, 16, 20, 34, 38, 50, 54, 2, 6, 18, 22,
+		40, 44, 56, 60, 8, 12, 24, 28, 42, 46, 58, 62, 10, 14, 26, 30,
+		1, 5, 17, 21, 33, 37, 49, 53, 3, 7, 19, 23, 35, 39, 51, 55,
+		9, 13, 25, 29, 41, 45, 57, 61, 11, 15, 27, 31, 43, 47, 59, 63,
+	},
+};
+alignas(16) constinit const u8 GSBlock::m_neon_w8tbl[2][64] = {
+	{
+		0, 36, 8, 44, 1, 37, 9, 45, 16, 52, 24, 60, 17, 53, 25, 61,
+		2, 38, 10, 46, 3, 39, 11, 47, 18, 54, 26, 62, 19, 55, 27, 63,
+		4, 32, 12, 40, 5, 33, 13, 41, 20, 48, 28, 56, 21, 49, 29, 57,
+		6, 34, 14, 42, 7, 35, 15, 43, 22, 50, 30, 58, 23, 51, 31, 59,
+	},
+	{
+		4, 32, 12, 40, 5, 33, 13, 41, 20, 48, 28, 56, 21, 49, 29, 57,
+		6, 34, 14, 42, 7, 35, 15, 43, 22, 50, 30, 58, 23, 51, 31, 59,
+		0, 36, 8, 44, 1, 37, 9, 45, 16, 52, 24, 60, 17, 53, 25, 61,
+		2, 38, 10, 46, 3, 39, 11, 47, 18, 54, 26, 62, 19, 55, 27, 63,
+	},
+};
+
+#endif
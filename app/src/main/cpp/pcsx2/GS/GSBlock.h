@@ -8,6 +8,14 @@
 #include "GSVector.h"
 #include "MultiISA.h"
 
+// The arm64 column kernels permute a whole column with one tbl per output vector. Set to 0 to build the
+// generic GSVector4i path instead, e.g. to record a GSBlockBenchmark baseline to compare against.
+#if defined(_M_ARM64)
+#define GS_BLOCK_NEON_TBL 1
+#else
+#define GS_BLOCK_NEON_TBL 0
+#endif
+
 MULTI_ISA_UNSHARED_START
 
 class GSBlock
@@ -30,6 +38,24 @@ class GSBlock
 	static const GSVector4i m_uw8hmask2;
 	static const GSVector4i m_uw8hmask3;
 
+#if GS_BLOCK_NEON_TBL
+	alignas(16) static const u8 m_neon_r16tbl[64];
+	alignas(16) static const u8 m_neon_w16tbl[64];
+	alignas(16) static const u8 m_neon_r8tbl[2][64];
+	alignas(16) static const u8 m_neon_w8tbl[2][64];
+
+	// Permutes the 64 bytes in v by tbl, one tbl4 per 16 bytes of output.
+	__forceinline static void Permute64(const uint8x16x4_t& v, const u8* RESTRICT tbl, u8* RESTRICT d0, u8* RESTRICT d1, u8* RESTRICT d2, u8* RESTRICT d3)
+	{
+		const uint8x16x4_t t = vld1q_u8_x4(tbl);
+
+		vst1q_u8(d0, vqtbl4q_u8(v, t.val[0]));
+		vst1q_u8(d1, vqtbl4q_u8(v, t.val[1]));
+		vst1q_u8(d2, vqtbl4q_u8(v, t.val[2]));
+		vst1q_u8(d3, vqtbl4q_u8(v, t.val[3]));
+	}
+#endif
+
 #if _M_SSE >= 0x501
 	// Equvialent of `a = *s0; b = *s1; sw128(a, b);`
 	// Loads in two halves instead to reduce shuffle instructions
@@ -128,6 +154,14 @@ public:
 		((GSVector8i*)dst)[i * 2 + 0] = v0;
 		((GSVector8i*)dst)[i * 2 + 1] = v1;
 
+#elif GS_BLOCK_NEON_TBL
+
+		const uint8x16x4_t v = {{vld1q_u8(&s0[0]), vld1q_u8(&s0[16]), vld1q_u8(&s1[0]), vld1q_u8(&s1[16])}};
+
+		u8* RESTRICT d = &dst[i * 64];
+
+		Permute64(v, m_neon_w16tbl, &d[0], &d[16], &d[32], &d[48]);
+
 #else
 
 		GSVector4i v0, v1, v2, v3;
@@ -203,6 +237,19 @@ public:
 			((GSVector8i*)dst)[i * 2 + 1] = v2;
 		}
 
+#elif GS_BLOCK_NEON_TBL
+
+		const uint8x16x4_t v = {{
+			vld1q_u8(&src[srcpitch * 0]),
+			vld1q_u8(&src[srcpitch * 1]),
+			vld1q_u8(&src[srcpitch * 2]),
+			vld1q_u8(&src[srcpitch * 3]),
+		}};
+
+		u8* RESTRICT d = &dst[i * 64];
+
+		Permute64(v, m_neon_w8tbl[i & 1], &d[0], &d[16], &d[32], &d[48]);
+
 #else
 
 		GSVector4i v0 = GSVector4i::load<alignment != 0>(&src[srcpitch * 0]);
@@ -450,6 +497,15 @@ public:
 		GSVector8::store<true>(&dst[dstpitch * 0], v0.xzxz(v1));
 		GSVector8::store<true>(&dst[dstpitch * 1], v0.ywyw(v1));
 
+#elif GS_BLOCK_NEON_TBL
+
+		const uint8x16x4_t v = vld1q_u8_x4(&src[i * 64]);
+
+		u8* RESTRICT d0 = &dst[dstpitch * 0];
+		u8* RESTRICT d1 = &dst[dstpitch * 1];
+
+		Permute64(v, m_neon_r16tbl, &d0[0], &d0[16], &d1[0], &d1[16]);
+
 #else
 
 		const GSVector4i* s = (const GSVector4i*)src;
@@ -508,6 +564,12 @@ public:
 		GSVector8i::storel(&dst[dstpitch * 2], v1);
 		GSVector8i::storeh(&dst[dstpitch * 3], v1);
 
+#elif GS_BLOCK_NEON_TBL
+
+		const uint8x16x4_t v = vld1q_u8_x4(&src[i * 64]);
+
+		Permute64(v, m_neon_r8tbl[i & 1], &dst[dstpitch * 0], &dst[dstpitch * 1], &dst[dstpitch * 2], &dst[dstpitch * 3]);
+
 #else
 
 		const GSVector4i* s = (const GSVector4i*)src;
@@ -0,0 +1,188 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "GS/GSBlock.h"
+#include "GS/GSBlockBenchmark.h"
+
+#include "common/Console.h"
+#include "common/Error.h"
+#include "common/FileSystem.h"
+#include "common/HeapArray.h"
+#include "common/Path.h"
+#include "common/Timer.h"
+
+#include "ryml_std.hpp"
+#include "ryml.hpp"
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+MULTI_ISA_UNSHARED_IMPL;
+
+namespace
+{
+	struct Kernel
+	{
+		const char* name;
+		const char* formats;
+		void (*fn)(u8* RESTRICT block, u8* RESTRICT linear);
+	};
+
+	struct Result
+	{
+		const Kernel* kernel;
+		double gbps;
+	};
+
+	// 256KB of swizzled blocks stays in L2 on most cores, so this measures the kernels and not DRAM.
+	// Each block gets a 16 row rectangle of linear data, which fits the widest and tallest kernels.
+	constexpr u32 BLOCK_COUNT = 1024;
+	constexpr int LINEAR_PITCH = 64;
+	constexpr u32 LINEAR_BLOCK_SIZE = LINEAR_PITCH * 16;
+	constexpr u32 RUNS = 3;
+	constexpr double MIN_RUN_SECONDS = 0.05;
+
+	const Kernel s_kernels[] = {
+		{"WriteBlock32", "PSMCT32 PSMZ32", [](u8* RESTRICT b, u8* RESTRICT l) { GSBlock::WriteBlock32<32, 0xffffffff>(b, l, LINEAR_PITCH); }},
+		{"WriteBlock24", "PSMCT24 PSMZ24", [](u8* RESTRICT b, u8* RESTRICT l) { GSBlock::WriteBlock32<32, 0x00ffffff>(b, l, LINEAR_PITCH); }},
+		{"WriteBlock16", "PSMCT16 PSMCT16S PSMZ16 PSMZ16S", [](u8* RESTRICT b, u8* RESTRICT l) { GSBlock::WriteBlock16<32>(b, l, LINEAR_PITCH); }},
+		{"WriteBlock8", "PSMT8", [](u8* RESTRICT b, u8* RESTRICT l) { GSBlock::WriteBlock8<32>(b, l, LINEAR_PITCH); }},
+		{"WriteBlock4", "PSMT4", [](u8* RESTRICT b, u8* RESTRICT l) { GSBlock::WriteBlock4<32>(b, l, LINEAR_PITCH); }},
+		{"UnpackAndWriteBlock8H", "PSMT8H", [](u8* RESTRICT b, u8* RESTRICT l) { GSBlock::UnpackAndWriteBlock8H(l, LINEAR_PITCH, b); }},
+		{"UnpackAndWriteBlock4HL", "PSMT4HL", [](u8* RESTRICT b, u8* RESTRICT l) { GSBlock::UnpackAndWriteBlock4HL(l, LINEAR_PITCH, b); }},
+		{"UnpackAndWriteBlock4HH", "PSMT4HH", [](u8* RESTRICT b, u8* RESTRICT l) { GSBlock::UnpackAndWriteBlock4HH(l, LINEAR_PITCH, b); }},
+		{"ReadBlock32", "PSMCT32 PSMCT24 PSMZ32 PSMZ24", [](u8* RESTRICT b, u8* RESTRICT l) { GSBlock::ReadBlock32(b, l, LINEAR_PITCH); }},
+		{"ReadBlock16", "PSMCT16 PSMCT16S PSMZ16 PSMZ16S", [](u8* RESTRICT b, u8* RESTRICT l) { GSBlock::ReadBlock16(b, l, LINEAR_PITCH); }},
+		{"ReadBlock8", "PSMT8", [](u8* RESTRICT b, u8* RESTRICT l) { GSBlock::ReadBlock8(b, l, LINEAR_PITCH); }},
+		{"ReadBlock4", "PSMT4", [](u8* RESTRICT b, u8* RESTRICT l) { GSBlock::ReadBlock4(b, l, LINEAR_PITCH); }},
+		{"ReadBlock4P", "PSMT4", [](u8* RESTRICT b, u8* RESTRICT l) { GSBlock::ReadBlock4P(b, l, LINEAR_PITCH); }},
+		{"ReadBlock8HP", "PSMT8H", [](u8* RESTRICT b, u8* RESTRICT l) { GSBlock::ReadBlock8HP(b, l, LINEAR_PITCH); }},
+		{"ReadBlock4HLP", "PSMT4HL", [](u8* RESTRICT b, u8* RESTRICT l) { GSBlock::ReadBlock4HLP(b, l, LINEAR_PITCH); }},
+		{"ReadBlock4HHP", "PSMT4HH", [](u8* RESTRICT b, u8* RESTRICT l) { GSBlock::ReadBlock4HHP(b, l, LINEAR_PITCH); }},
+	};
+} // namespace
+
+// Best of a few runs, in GB of swizzled block data per second
+static double MeasureKernel(const Kernel& kernel, u8* blocks, u8* linear)
+{
+	const auto pass = [&]() {
+		for (u32 i = 0; i < BLOCK_COUNT; i++)
+			kernel.fn(&blocks[i * 256], &linear[i * LINEAR_BLOCK_SIZE]);
+	};
+
+	pass(); // warm up the caches
+
+	double best = 0.0;
+	for (u32 run = 0; run < RUNS; run++)
+	{
+		u32 passes = 0;
+		Common::Timer timer;
+		do
+		{
+			pass();
+			passes++;
+		} while (timer.GetTimeSeconds() < MIN_RUN_SECONDS);
+
+		const double bytes = static_cast<double>(passes) * BLOCK_COUNT * 256;
+		best = std::max(best, bytes / timer.GetTimeSeconds() / 1e9);
+	}
+
+	return best;
+}
+
+static bool CompareWithBaseline(const GSBlockBenchmarkOptions& options, const std::vector<Result>& results, Error* error)
+{
+	const std::optional<std::string> buf = FileSystem::ReadFileToString(options.baseline_path.c_str());
+	if (!buf.has_value())
+	{
+		Error::SetString(error, fmt::format("Failed to read baseline '{}'", options.baseline_path));
+		return false;
+	}
+
+	const ryml::Tree tree = ryml::parse_in_arena(c4::to_csubstr(buf.value()));
+	const ryml::ConstNodeRef root = tree.rootref();
+	if (!root.is_map() || !root.has_child("results"))
+	{
+		Error::SetString(error, fmt::format("'{}' is not a block benchmark summary", options.baseline_path));
+		return false;
+	}
+
+	u32 regressions = 0;
+	for (const Result& r : results)
+	{
+		for (const ryml::ConstNodeRef& n : root["results"].children())
+		{
+			if (!n.has_child("kernel") || !n.has_child("gbps") || n["kernel"].val() != c4::to_csubstr(r.kernel->name))
+				continue;
+
+			double base_gbps = 0.0;
+			n["gbps"] >> base_gbps;
+			if (base_gbps <= 0.0)
+				break;
+
+			const double change = (r.gbps - base_gbps) * 100.0 / base_gbps;
+			if (-change > options.threshold_percent)
+			{
+				Console.ErrorFmt("(GSBlockBenchmark) {}: {:.2f} GB/s vs {:.2f} GB/s baseline, {:+.1f}%",
+					r.kernel->name, r.gbps, base_gbps, change);
+				regressions++;
+			}
+			else
+			{
+				Console.WriteLnFmt("(GSBlockBenchmark) {}: {:.2f} GB/s vs {:.2f} GB/s baseline, {:+.1f}%",
+					r.kernel->name, r.gbps, base_gbps, change);
+			}
+			break;
+		}
+	}
+
+	if (regressions > 0)
+	{
+		Error::SetString(error, fmt::format("{} kernels regressed by more than {}%", regressions, options.threshold_percent));
+		return false;
+	}
+
+	return true;
+}
+
+bool CURRENT_ISA::RunGSBlockBenchmark(const GSBlockBenchmarkOptions& options, Error* error)
+{
+	if (!FileSystem::EnsureDirectoryExists(options.output_directory.c_str(), true, error))
+		return false;
+
+	DynamicHeapArray<u8, 64> blocks(BLOCK_COUNT * 256);
+	DynamicHeapArray<u8, 64> linear(BLOCK_COUNT * LINEAR_BLOCK_SIZE);
+	for (size_t i = 0; i < blocks.size(); i++)
+		blocks[i] = static_cast<u8>(i * 7);
+	for (size_t i = 0; i < linear.size(); i++)
+		linear[i] = static_cast<u8>(i * 13);
+
+	std::vector<Result> results;
+	for (const Kernel& kernel : s_kernels)
+	{
+		const double gbps = MeasureKernel(kernel, blocks.data(), linear.data());
+		Console.WriteLnFmt("(GSBlockBenchmark) {:<24} {:>8.2f} GB/s  [{}]", kernel.name, gbps, kernel.formats);
+		results.push_back({&kernel, gbps});
+	}
+
+	std::string json;
+	fmt::format_to(std::back_inserter(json), "{{\n\t\"threshold_percent\": {},\n\t\"neon_tbl\": {},\n\t\"results\": [\n",
+		options.threshold_percent, GS_BLOCK_NEON_TBL);
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		fmt::format_to(std::back_inserter(json), "\t\t{{\"kernel\": \"{}\", \"formats\": \"{}\", \"gbps\": {:.3f}}}{}\n",
+			results[i].kernel->name, results[i].kernel->formats, results[i].gbps, (i + 1 < results.size()) ? "," : "");
+	}
+	json += "\t]\n}\n";
+
+	const std::string json_path = Path::Combine(options.output_directory, "gsblock_summary.json");
+	if (!FileSystem::WriteStringToFile(json_path.c_str(), json))
+		Console.ErrorFmt("(GSBlockBenchmark) Failed to write results to '{}'", json_path);
+
+	if (!options.baseline_path.empty() && !CompareWithBaseline(options, results, error))
+		return false;
+
+	return true;
+}
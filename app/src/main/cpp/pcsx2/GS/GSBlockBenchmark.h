@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "GS/MultiISA.h"
+
+#include <string>
+
+class Error;
+
+struct GSBlockBenchmarkOptions
+{
+	std::string output_directory;
+
+	/// Summary JSON from an earlier run, e.g. one built with GS_BLOCK_NEON_TBL set to 0. Kernels whose
+	/// throughput dropped by more than threshold_percent are reported as regressions.
+	std::string baseline_path;
+	float threshold_percent = 5.0f;
+};
+
+/// Measures the GB/s of every GSBlock read and write kernel on cache resident blocks and writes
+/// gsblock_summary.json to the output directory. Returns false on failure or regression.
+MULTI_ISA_DEF(bool RunGSBlockBenchmark(const GSBlockBenchmarkOptions& options, Error* error);)
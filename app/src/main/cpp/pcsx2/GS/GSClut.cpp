@@ -5,6 +5,7 @@
 #include "GS/GSExtra.h"
 #include "GS/GSLocalMemory.h"
 #include "GS/GSGL.h"
+#include "GS/GSPerfMon.h"
 #include "GS/GSUtil.h"
 #include "GS/Renderers/Common/GSDevice.h"
 #include "GS/Renderers/Common/GSRenderer.h"
@@ -23,6 +24,11 @@ GSClut::GSClut(GSLocalMemory* mem)
 	m_write.dirty = 1;
 	m_read.dirty = true;
 
+	m_palette_cache = static_cast<PaletteCacheEntry*>(_aligned_malloc(sizeof(PaletteCacheEntry) * PALETTE_CACHE_SIZE, VECTOR_ALIGNMENT));
+	if (!m_palette_cache)
+		pxFailRel("Failed to allocate palette cache.");
+	std::memset(m_palette_cache, 0, sizeof(PaletteCacheEntry) * PALETTE_CACHE_SIZE);
+
 	for (int i = 0; i < 16; i++)
 	{
 		for (int j = 0; j < 64; j++)
@@ -95,6 +101,7 @@ GSClut::~GSClut()
 	delete m_gpu_clut4;
 	delete m_gpu_clut8;
 
+	_aligned_free(m_palette_cache);
 	_aligned_free(m_clut);
 }
 
@@ -134,6 +141,13 @@ void GSClut::Reset()
 	m_write.dirty = 1;
 	m_read = {};
 	m_read.dirty = true;
+
+	// palettes may be pointing into the cache
+	m_buff32 = reinterpret_cast<u32*>(reinterpret_cast<u8*>(m_clut) + 2048);
+	m_buff64 = reinterpret_cast<u64*>(reinterpret_cast<u8*>(m_clut) + 4096);
+	for (u32 i = 0; i < PALETTE_CACHE_SIZE; i++)
+		m_palette_cache[i].valid = false;
+	m_palette_cache_age = 0;
 }
 
 bool GSClut::InvalidateRange(u32 start_block, u32 end_block, bool is_draw)
@@ -360,55 +374,160 @@ void GSClut::Read(const GIFRegTEX0& TEX0)
 }
 #endif
 
-void GSClut::Read32(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA)
+bool GSClut::LookupPalette(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA)
 {
-	if (m_read.IsDirty(TEX0, TEXA))
+	constexpr u64 texa24_mask = 0x80FFull; // AEM TA0
+	constexpr u64 texa16_mask = 0xFF000080FFull; // TA1 AEM TA0
+
+	// gather the CLUT words Read32() is going to expand
+	alignas(VECTOR_ALIGNMENT) u16 src[512];
+	u32 src_size;
+	u64 texa;
+	const u32 pal = GSLocalMemory::m_psm[TEX0.PSM].pal;
+	const bool is_8bit = (pal == 256);
+	if (pal == 0)
 	{
-		m_read.TEX0 = TEX0;
-		m_read.TEXA = TEXA;
-		m_read.dirty = false;
-		m_read.adirty = true;
+		// nothing gets expanded for these
+		m_read.entry = nullptr;
+		return true;
+	}
+	else if (TEX0.CPSM == PSMCT32 || TEX0.CPSM == PSMCT24)
+	{
+		const u32 offset = is_8bit ? 0 : ((TEX0.CSA & 15) << 4);
+		src_size = is_8bit ? 256 : 16;
+		std::memcpy(&src[0], &m_clut[offset], src_size * sizeof(u16));
+		std::memcpy(&src[src_size], &m_clut[offset + 256], src_size * sizeof(u16));
+		src_size *= 2;
+		texa = (TEX0.CPSM == PSMCT24) ? (TEXA.U64 & texa24_mask) : 0;
+	}
+	else if (TEX0.CPSM == PSMCT16 || TEX0.CPSM == PSMCT16S)
+	{
+		src_size = is_8bit ? 256 : 16;
+		std::memcpy(&src[0], &m_clut[TEX0.CSA << 4], src_size * sizeof(u16));
+		texa = TEXA.U64 & texa16_mask;
+	}
+	else
+	{
+		// nothing gets expanded for these
+		m_read.entry = nullptr;
+		return true;
+	}
 
-		u16* clut = m_clut;
+	// the CBP doesn't matter, the same palette loaded from somewhere else can share the entry
+	const u64 key = TEX0.CPSM | (static_cast<u64>(is_8bit) << 4) | (static_cast<u64>(TEX0.CSA) << 5) | (texa << 16);
 
-		if (TEX0.CPSM == PSMCT32 || TEX0.CPSM == PSMCT24)
+	u64 h = 0xcbf29ce484222325ull ^ src_size;
+	for (u32 i = 0; i < src_size; i += 4)
+	{
+		u64 v;
+		std::memcpy(&v, &src[i], sizeof(v));
+		h = (h ^ v) * 0x100000001b3ull;
+	}
+	const u32 hash = static_cast<u32>(h ^ (h >> 32));
+
+	PaletteCacheEntry* victim = &m_palette_cache[0];
+	for (u32 i = 0; i < PALETTE_CACHE_SIZE; i++)
+	{
+		PaletteCacheEntry* entry = &m_palette_cache[i];
+		if (!entry->valid)
 		{
-			switch (TEX0.PSM)
-			{
-				case PSMT8:
-				case PSMT8H:
-					ReadCLUT_T32_I8(clut, m_buff32, (TEX0.CSA & 15) << 4);
-					break;
-				case PSMT4:
-				case PSMT4HL:
-				case PSMT4HH:
-					clut += (TEX0.CSA & 15) << 4;
-					// TODO: merge these functions
-					ReadCLUT_T32_I4(clut, m_buff32);
-					ExpandCLUT64_T32_I8(m_buff32, (u64*)m_buff64); // sw renderer does not need m_buff64 anymore
-					break;
-			}
+			victim = entry;
+			continue;
 		}
-		else if (TEX0.CPSM == PSMCT16 || TEX0.CPSM == PSMCT16S)
+
+		if (entry->key == key && entry->hash == hash && entry->src_size == src_size &&
+			std::memcmp(entry->src, src, src_size * sizeof(u16)) == 0)
 		{
-			switch (TEX0.PSM)
+			entry->age = ++m_palette_cache_age;
+			m_buff32 = entry->buff32;
+			m_buff64 = entry->buff64;
+			m_read.entry = entry;
+			if (entry->alpha_valid)
 			{
-				case PSMT8:
-				case PSMT8H:
-					clut += TEX0.CSA << 4;
-					Expand16(clut, m_buff32, 256, TEXA);
-					break;
-				case PSMT4:
-				case PSMT4HL:
-				case PSMT4HH:
-					clut += TEX0.CSA << 4;
-					// TODO: merge these functions
-					Expand16(clut, m_buff32, 16, TEXA);
-					ExpandCLUT64_T32_I8(m_buff32, (u64*)m_buff64); // sw renderer does not need m_buff64 anymore
-					break;
+				m_read.amin = entry->amin;
+				m_read.amax = entry->amax;
+				m_read.adirty = false;
 			}
+
+			g_perfmon.Put(GSPerfMon::CLUTHits, 1);
+			return true;
 		}
 
+		if (victim->valid && entry->age < victim->age)
+			victim = entry;
+	}
+
+	// expand straight into the entry we're replacing
+	victim->key = key;
+	victim->hash = hash;
+	victim->age = ++m_palette_cache_age;
+	victim->src_size = src_size;
+	victim->valid = true;
+	victim->alpha_valid = false;
+	std::memcpy(victim->src, src, src_size * sizeof(u16));
+	m_buff32 = victim->buff32;
+	m_buff64 = victim->buff64;
+	m_read.entry = victim;
+
+	g_perfmon.Put(GSPerfMon::CLUTExpands, 1);
+	return false;
+}
+
+void GSClut::ExpandPalette(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA)
+{
+	u16* clut = m_clut;
+
+	if (TEX0.CPSM == PSMCT32 || TEX0.CPSM == PSMCT24)
+	{
+		switch (TEX0.PSM)
+		{
+			case PSMT8:
+			case PSMT8H:
+				ReadCLUT_T32_I8(clut, m_buff32, (TEX0.CSA & 15) << 4);
+				break;
+			case PSMT4:
+			case PSMT4HL:
+			case PSMT4HH:
+				clut += (TEX0.CSA & 15) << 4;
+				// TODO: merge these functions
+				ReadCLUT_T32_I4(clut, m_buff32);
+				ExpandCLUT64_T32_I8(m_buff32, (u64*)m_buff64); // sw renderer does not need m_buff64 anymore
+				break;
+		}
+	}
+	else if (TEX0.CPSM == PSMCT16 || TEX0.CPSM == PSMCT16S)
+	{
+		switch (TEX0.PSM)
+		{
+			case PSMT8:
+			case PSMT8H:
+				clut += TEX0.CSA << 4;
+				Expand16(clut, m_buff32, 256, TEXA);
+				break;
+			case PSMT4:
+			case PSMT4HL:
+			case PSMT4HH:
+				clut += TEX0.CSA << 4;
+				// TODO: merge these functions
+				Expand16(clut, m_buff32, 16, TEXA);
+				ExpandCLUT64_T32_I8(m_buff32, (u64*)m_buff64); // sw renderer does not need m_buff64 anymore
+				break;
+		}
+	}
+}
+
+void GSClut::Read32(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA)
+{
+	if (m_read.IsDirty(TEX0, TEXA))
+	{
+		m_read.TEX0 = TEX0;
+		m_read.TEXA = TEXA;
+		m_read.dirty = false;
+		m_read.adirty = true;
+
+		if (!LookupPalette(TEX0, TEXA))
+			ExpandPalette(TEX0, TEXA);
+
 		m_current_gpu_clut = nullptr;
 		if (GSConfig.UserHacks_GPUTargetCLUTMode != GSGPUTargetCLUTMode::Disabled)
 		{
@@ -520,6 +639,13 @@ void GSClut::GetAlphaMinMax32(int& amin_out, int& amax_out)
 			m_read.amin = v0.min_i16(v1).extract16<0>();
 			m_read.amax = v0.max_i16(v1).extract16<1>();
 		}
+
+		if (m_read.entry)
+		{
+			m_read.entry->amin = m_read.amin;
+			m_read.entry->amax = m_read.amax;
+			m_read.entry->alpha_valid = true;
+		}
 	}
 
 	amin_out = m_read.amin;
@@ -634,6 +760,14 @@ void GSClut::ReadCLUT_T32_I8(const u16* RESTRICT clut, u32* RESTRICT dst, int of
 
 __forceinline void GSClut::ReadCLUT_T32_I4(const u16* RESTRICT clut, u32* RESTRICT dst)
 {
+#if defined(_M_ARM64)
+
+	// interleave the low and high halves as they're stored
+	vst2q_u16(reinterpret_cast<u16*>(&dst[0]), uint16x8x2_t{vld1q_u16(&clut[0]), vld1q_u16(&clut[256])});
+	vst2q_u16(reinterpret_cast<u16*>(&dst[8]), uint16x8x2_t{vld1q_u16(&clut[8]), vld1q_u16(&clut[264])});
+
+#else
+
 	GSVector4i* s = (GSVector4i*)clut;
 	GSVector4i* d = (GSVector4i*)dst;
 
@@ -648,6 +782,8 @@ __forceinline void GSClut::ReadCLUT_T32_I4(const u16* RESTRICT clut, u32* RESTRI
 	d[1] = v1;
 	d[2] = v2;
 	d[3] = v3;
+
+#endif
 }
 
 #if 0
@@ -731,6 +867,27 @@ __forceinline void GSClut::ReadCLUT_T16_I4(const u16* RESTRICT clut, u32* RESTRI
 
 void GSClut::ExpandCLUT64_T32_I8(const u32* RESTRICT src, u64* RESTRICT dst)
 {
+#if defined(_M_ARM64)
+
+	const uint32x4_t s0 = vld1q_u32(&src[0]);
+	const uint32x4_t s1 = vld1q_u32(&src[4]);
+	const uint32x4_t s2 = vld1q_u32(&src[8]);
+	const uint32x4_t s3 = vld1q_u32(&src[12]);
+
+	// dst[i * 16 + j] = src[i] << 32 | src[j]
+	for (int i = 0; i < 16; i++)
+	{
+		const uint32x4_t hi = vdupq_n_u32(src[i]);
+		u32* d = reinterpret_cast<u32*>(&dst[i * 16]);
+
+		vst2q_u32(&d[0], uint32x4x2_t{s0, hi});
+		vst2q_u32(&d[8], uint32x4x2_t{s1, hi});
+		vst2q_u32(&d[16], uint32x4x2_t{s2, hi});
+		vst2q_u32(&d[24], uint32x4x2_t{s3, hi});
+	}
+
+#else
+
 	GSVector4i* s = (GSVector4i*)src;
 	GSVector4i* d = (GSVector4i*)dst;
 
@@ -743,6 +900,8 @@ void GSClut::ExpandCLUT64_T32_I8(const u32* RESTRICT src, u64* RESTRICT dst)
 	ExpandCLUT64_T32(s1, s0, s1, s2, s3, &d[32]);
 	ExpandCLUT64_T32(s2, s0, s1, s2, s3, &d[64]);
 	ExpandCLUT64_T32(s3, s0, s1, s2, s3, &d[96]);
+
+#endif
 }
 
 __forceinline void GSClut::ExpandCLUT64_T32(const GSVector4i& hi, const GSVector4i& lo0, const GSVector4i& lo1, const GSVector4i& lo2, const GSVector4i& lo3, GSVector4i* dst)
@@ -825,6 +984,35 @@ void GSClut::Expand16(const u16* RESTRICT src, u32* RESTRICT dst, int w, const G
 {
 	pxAssert((w & 7) == 0);
 
+#if defined(_M_ARM64)
+
+	// widen 8 colours at a time, the alpha is picked on the 16-bit lanes and shifted into place while widening
+	const uint32x4_t rm = vdupq_n_u32(0x001f);
+	const uint32x4_t gm = vdupq_n_u32(0x03e0);
+	const uint32x4_t bm = vdupq_n_u32(0x7c00);
+	const uint16x8_t TA0 = vdupq_n_u16(static_cast<u16>(TEXA.TA0 << 8));
+	const uint16x8_t TA1 = vdupq_n_u16(static_cast<u16>(TEXA.TA1 << 8));
+
+	const auto expand = [&rm, &gm, &bm](uint32x4_t c, uint32x4_t a) {
+		const uint32x4_t r = vshlq_n_u32(vandq_u32(c, rm), 3);
+		const uint32x4_t g = vshlq_n_u32(vandq_u32(c, gm), 6);
+		const uint32x4_t b = vshlq_n_u32(vandq_u32(c, bm), 9);
+		return vorrq_u32(vorrq_u32(r, g), vorrq_u32(b, a));
+	};
+
+	for (int i = 0; i < w; i += 8)
+	{
+		const uint16x8_t c = vld1q_u16(&src[i]);
+		uint16x8_t a = vbslq_u16(vcltzq_s16(vreinterpretq_s16_u16(c)), TA1, TA0);
+		if (TEXA.AEM)
+			a = vbicq_u16(a, vceqzq_u16(c));
+
+		vst1q_u32(&dst[i + 0], expand(vmovl_u16(vget_low_u16(c)), vshll_n_u16(vget_low_u16(a), 16)));
+		vst1q_u32(&dst[i + 4], expand(vmovl_high_u16(c), vshll_high_n_u16(a, 16)));
+	}
+
+#else
+
 	const GSVector4i rm = m_rm;
 	const GSVector4i gm = m_gm;
 	const GSVector4i bm = m_bm;
@@ -859,6 +1047,8 @@ void GSClut::Expand16(const u16* RESTRICT src, u32* RESTRICT dst, int w, const G
 			d[i * 2 + 1] = ((ch & rm) << 3) | ((ch & gm) << 6) | ((ch & bm) << 9) | TA0.blend8(TA1, ch.sra16<15>()).andnot(ch == GSVector4i::zero());
 		}
 	}
+
+#endif
 }
 
 bool GSClut::WriteState::IsDirty(const GIFRegTEX0& TEX0, const GIFRegTEXCLUT& TEXCLUT)
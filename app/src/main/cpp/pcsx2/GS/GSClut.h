@@ -35,6 +35,27 @@ class alignas(32) GSClut final : public GSAlignedClass<32>
 		bool IsDirty(const GIFRegTEX0& TEX0, const GIFRegTEXCLUT& TEXCLUT);
 	} m_write = {};
 
+	// Expanded palettes, keyed by everything Read32() depends on. The CLUT words they were expanded from
+	// are kept too, so a hash collision can't return the wrong colours.
+	struct alignas(32) PaletteCacheEntry
+	{
+		u64 key;
+		u32 hash;
+		u32 age;
+		u32 src_size;
+		bool valid;
+		bool alpha_valid;
+		int amin, amax;
+		u16 src[512];
+		u32 buff32[256];
+		u64 buff64[256];
+	};
+
+	static constexpr u32 PALETTE_CACHE_SIZE = 16;
+
+	PaletteCacheEntry* m_palette_cache = nullptr;
+	u32 m_palette_cache_age = 0;
+
 	struct alignas(32) ReadState
 	{
 		GIFRegTEX0 TEX0;
@@ -42,6 +63,7 @@ class alignas(32) GSClut final : public GSAlignedClass<32>
 		bool dirty;
 		bool adirty;
 		int amin, amax;
+		PaletteCacheEntry* entry;
 		bool IsDirty(const GIFRegTEX0& TEX0);
 		bool IsDirty(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA);
 	} m_read = {};
@@ -92,6 +114,9 @@ private:
 
 	static void Expand16(const u16* RESTRICT src, u32* RESTRICT dst, int w, const GIFRegTEXA& TEXA);
 
+	void ExpandPalette(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA);
+	bool LookupPalette(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA);
+
 public:
 	GSClut(GSLocalMemory* mem);
 	~GSClut();
@@ -10,12 +10,18 @@
 #include "common/FileSystem.h"
 #include "common/HeapArray.h"
 #include "common/ScopedGuard.h"
+#include "common/Threading.h"
 
 #include <7zCrc.h>
 #include <XzCrc64.h>
 #include <XzEnc.h>
 #include <zstd.h>
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 GSDumpBase::GSDumpBase(std::string fn)
 	: m_filename(std::move(fn))
 	, m_frames(0)
@@ -100,6 +106,8 @@ bool GSDumpBase::VSync(int field, bool last, const GSPrivRegSet* regs)
 	AppendRawData(1);
 	AppendRawData(static_cast<u8>(field));
 
+	OnVSync();
+
 	if (last)
 		m_extra_frames--;
 
@@ -425,3 +433,252 @@ std::unique_ptr<GSDumpBase> GSDumpBase::CreateZstDump(
 		screenshot_width, screenshot_height, screenshot_pixels,
 		fd, regs);
 }
+
+//////////////////////////////////////////////////////////////////////
+// GSDumpZstChunked implementation
+//////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	class GSDumpZstChunked final : public GsDumpBuffered
+	{
+		// a chunk is cut at the first vsync past either limit, a keyframe follows every few chunks
+		static constexpr size_t CHUNK_SIZE = 8 * _1mb;
+		static constexpr u32 CHUNK_FRAMES = 60;
+		static constexpr u32 KEYFRAME_CHUNKS = 5;
+
+		// chunks waiting for the compression thread before the GS thread has to wait for it
+		static constexpr size_t MAX_PENDING_JOBS = 2;
+
+		struct Job
+		{
+			DynamicHeapArray<u8, 64> data;
+			size_t size;
+			GSPrivRegSet regs; // keyframes only
+			u32 first_frame;
+			u32 type;
+		};
+
+		// only touched by the GS thread
+		u32 m_frame = 0;
+		u32 m_chunk_first_frame = 0;
+		u32 m_chunks_since_keyframe = 0;
+		bool m_needs_keyframe = false;
+
+		// only touched by the compression thread once it has been started
+		ZSTD_CCtx* m_cctx;
+		std::vector<u8> m_out_buff;
+		std::vector<u8> m_keyframe_buff;
+		std::vector<GSDumpChunkedEntry> m_index;
+		u64 m_file_offset = 0;
+
+		std::thread m_thread;
+		std::mutex m_mutex;
+		std::condition_variable m_work_cv;
+		std::condition_variable m_done_cv;
+		std::deque<Job> m_jobs;
+		std::vector<DynamicHeapArray<u8, 64>> m_free_buffers;
+		bool m_shutdown = false;
+
+		void OnVSync() override;
+		void FlushChunk();
+		void QueueJob(Job job);
+		void ThreadProc();
+		void CompressJob(Job& job);
+
+	public:
+		GSDumpZstChunked(const std::string& fn, const std::string& serial, u32 crc,
+			u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
+			const freezeData& fd, const GSPrivRegSet* regs);
+		~GSDumpZstChunked() override;
+
+		bool NeedsKeyframe() const override;
+		void AddKeyframe(DynamicHeapArray<u8, 64> state, const GSPrivRegSet* regs) override;
+	};
+
+	GSDumpZstChunked::GSDumpZstChunked(const std::string& fn, const std::string& serial, u32 crc,
+		u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
+		const freezeData& fd, const GSPrivRegSet* regs)
+		: GsDumpBuffered(fn + ".gs.zsc")
+	{
+		m_cctx = ZSTD_createCCtx();
+		ZSTD_CCtx_setParameter(m_cctx, ZSTD_c_compressionLevel, 6);
+
+		const GSDumpChunkedHeader header = {GSDumpChunkedHeader::MAGIC, GSDumpChunkedHeader::VERSION};
+		Write(&header, sizeof(header));
+		m_file_offset = sizeof(header);
+
+		m_thread = std::thread(&GSDumpZstChunked::ThreadProc, this);
+
+		AddKeyframe(DynamicHeapArray<u8, 64>(fd.data, static_cast<size_t>(fd.size)), regs);
+		AddHeader(serial, crc, screenshot_width, screenshot_height, screenshot_pixels, fd, regs);
+	}
+
+	GSDumpZstChunked::~GSDumpZstChunked()
+	{
+		FlushChunk();
+
+		{
+			std::unique_lock lock(m_mutex);
+			m_shutdown = true;
+		}
+		m_work_cv.notify_one();
+		m_thread.join();
+
+		GSDumpChunkedFooter footer = {};
+		footer.index_offset = m_file_offset;
+		footer.index_count = static_cast<u32>(m_index.size());
+		footer.frame_count = m_frame;
+		footer.magic = GSDumpChunkedHeader::MAGIC;
+		Write(m_index.data(), m_index.size() * sizeof(GSDumpChunkedEntry));
+		Write(&footer, sizeof(footer));
+
+		ZSTD_freeCCtx(m_cctx);
+	}
+
+	bool GSDumpZstChunked::NeedsKeyframe() const
+	{
+		return m_needs_keyframe;
+	}
+
+	void GSDumpZstChunked::AddKeyframe(DynamicHeapArray<u8, 64> state, const GSPrivRegSet* regs)
+	{
+		// only valid on a chunk boundary, which is where NeedsKeyframe() asks for it
+		pxAssert(m_buffer_size == 0);
+
+		Job job;
+		job.size = state.size();
+		job.data = std::move(state);
+		job.regs = *regs;
+		job.first_frame = m_frame;
+		job.type = GSDumpChunkedEntry::TYPE_KEYFRAME;
+		QueueJob(std::move(job));
+
+		m_needs_keyframe = false;
+		m_chunks_since_keyframe = 0;
+	}
+
+	void GSDumpZstChunked::OnVSync()
+	{
+		m_frame++;
+
+		if (m_buffer_size < CHUNK_SIZE && (m_frame - m_chunk_first_frame) < CHUNK_FRAMES)
+			return;
+
+		FlushChunk();
+
+		if (++m_chunks_since_keyframe >= KEYFRAME_CHUNKS)
+			m_needs_keyframe = true;
+	}
+
+	void GSDumpZstChunked::FlushChunk()
+	{
+		if (m_buffer_size == 0)
+			return;
+
+		// Hand the packet buffer over instead of copying it, and carry on in one the thread is done with.
+		Job job;
+		job.data.swap(m_buffer);
+		job.size = m_buffer_size;
+		job.first_frame = m_chunk_first_frame;
+		job.type = GSDumpChunkedEntry::TYPE_PACKETS;
+		QueueJob(std::move(job));
+
+		{
+			std::unique_lock lock(m_mutex);
+			if (!m_free_buffers.empty())
+			{
+				m_buffer.swap(m_free_buffers.back());
+				m_free_buffers.pop_back();
+			}
+		}
+		if (m_buffer.empty())
+			m_buffer.resize(_1mb);
+
+		m_buffer_size = 0;
+		m_chunk_first_frame = m_frame;
+	}
+
+	void GSDumpZstChunked::QueueJob(Job job)
+	{
+		{
+			std::unique_lock lock(m_mutex);
+			m_done_cv.wait(lock, [this]() { return m_jobs.size() < MAX_PENDING_JOBS; });
+			m_jobs.push_back(std::move(job));
+		}
+		m_work_cv.notify_one();
+	}
+
+	void GSDumpZstChunked::ThreadProc()
+	{
+		Threading::SetNameOfCurrentThread("GS Dump Compression");
+
+		std::unique_lock lock(m_mutex);
+		for (;;)
+		{
+			m_work_cv.wait(lock, [this]() { return !m_jobs.empty() || m_shutdown; });
+			if (m_jobs.empty())
+				break;
+
+			// Leave the job in the queue while it's compressed, so the GS thread can't get more than
+			// MAX_PENDING_JOBS chunks ahead.
+			Job& job = m_jobs.front();
+			lock.unlock();
+			CompressJob(job);
+			lock.lock();
+
+			if (job.type == GSDumpChunkedEntry::TYPE_PACKETS)
+				m_free_buffers.push_back(std::move(job.data));
+			m_jobs.pop_front();
+			m_done_cv.notify_one();
+		}
+	}
+
+	void GSDumpZstChunked::CompressJob(Job& job)
+	{
+		const u8* data = job.data.data();
+		size_t size = job.size;
+
+		if (job.type == GSDumpChunkedEntry::TYPE_KEYFRAME)
+		{
+			const u32 state_size = static_cast<u32>(job.size);
+			m_keyframe_buff.resize(sizeof(state_size) + state_size + sizeof(job.regs));
+			std::memcpy(m_keyframe_buff.data(), &state_size, sizeof(state_size));
+			std::memcpy(m_keyframe_buff.data() + sizeof(state_size), job.data.data(), state_size);
+			std::memcpy(m_keyframe_buff.data() + sizeof(state_size) + state_size, &job.regs, sizeof(job.regs));
+			data = m_keyframe_buff.data();
+			size = m_keyframe_buff.size();
+		}
+
+		m_out_buff.resize(ZSTD_compressBound(size));
+
+		const size_t compressed = ZSTD_compress2(m_cctx, m_out_buff.data(), m_out_buff.size(), data, size);
+		if (ZSTD_isError(compressed))
+		{
+			Console.ErrorFmt("GSDumpZstChunked: Error {}", ZSTD_getErrorName(compressed));
+			return;
+		}
+
+		Write(m_out_buff.data(), compressed);
+
+		GSDumpChunkedEntry entry = {};
+		entry.offset = m_file_offset;
+		entry.compressed_size = static_cast<u32>(compressed);
+		entry.raw_size = static_cast<u32>(size);
+		entry.first_frame = job.first_frame;
+		entry.type = job.type;
+		m_index.push_back(entry);
+
+		m_file_offset += compressed;
+	}
+} // namespace
+
+std::unique_ptr<GSDumpBase> GSDumpBase::CreateZstChunkedDump(
+	const std::string& fn, const std::string& serial, u32 crc,
+	u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
+	const freezeData& fd, const GSPrivRegSet* regs)
+{
+	return std::make_unique<GSDumpZstChunked>(fn, serial, crc,
+		screenshot_width, screenshot_height, screenshot_pixels,
+		fd, regs);
+}
@@ -7,6 +7,8 @@
 #include "GS/GSRegs.h"
 #include "GS/Renderers/SW/GSVertexSW.h"
 
+#include "common/HeapArray.h"
+
 /*
 
 Dump file format:
@@ -24,6 +26,14 @@ ReadFIFO2 data (id == 2)
 Regs data (id == 3)
 - [PMODE/0x2000]
 
+Chunked dump file format (.gs.zsc):
+- [GSDumpChunkedHeader] [chunk] .. [chunk] [GSDumpChunkedEntry] .. [GSDumpChunkedEntry] [GSDumpChunkedFooter]
+
+Each chunk is an independent zstd frame, so any of them can be decompressed without the ones before it.
+Packet chunks hold consecutive pieces of the stream above and always end on a VSync, the first one starts
+with the header. Keyframe chunks hold [state size/4] [state data/size] [PMODE/0x2000] as of the start of
+the packet chunk with the same first frame, there is always one for frame 0.
+
 */
 
 #pragma pack(push, 4)
@@ -39,6 +49,38 @@ struct GSDumpHeader
 	u32 screenshot_offset;
 	u32 screenshot_size;
 };
+
+struct GSDumpChunkedHeader
+{
+	static constexpr u32 MAGIC = 0x435A5347; // GSZC
+	static constexpr u32 VERSION = 1;
+
+	u32 magic;
+	u32 version;
+};
+
+struct GSDumpChunkedEntry
+{
+	enum : u32
+	{
+		TYPE_PACKETS,
+		TYPE_KEYFRAME,
+	};
+
+	u64 offset;
+	u32 compressed_size;
+	u32 raw_size;
+	u32 first_frame;
+	u32 type;
+};
+
+struct GSDumpChunkedFooter
+{
+	u64 index_offset;
+	u32 index_count;
+	u32 frame_count;
+	u32 magic;
+};
 #pragma pack(pop)
 
 class GSDumpBase
@@ -56,6 +98,7 @@ protected:
 
 	virtual void AppendRawData(const void* data, size_t size) = 0;
 	virtual void AppendRawData(u8 c) = 0;
+	virtual void OnVSync() {}
 
 public:
 	GSDumpBase(std::string fn);
@@ -67,6 +110,11 @@ public:
 	void Transfer(int index, const u8* mem, size_t size);
 	bool VSync(int field, bool last, const GSPrivRegSet* regs);
 
+	/// Formats with random access want a full GS state every so often, see AddKeyframe().
+	/// The frozen state is moved in, so the dump can pack and compress it on another thread.
+	virtual bool NeedsKeyframe() const { return false; }
+	virtual void AddKeyframe(DynamicHeapArray<u8, 64> state, const GSPrivRegSet* regs) {}
+
 	static std::unique_ptr<GSDumpBase> CreateUncompressedDump(
 		const std::string& fn, const std::string& serial, u32 crc,
 		u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
@@ -79,4 +127,8 @@ public:
 		const std::string& fn, const std::string& serial, u32 crc,
 		u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
 		const freezeData& fd, const GSPrivRegSet* regs);
+	static std::unique_ptr<GSDumpBase> CreateZstChunkedDump(
+		const std::string& fn, const std::string& serial, u32 crc,
+		u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
+		const freezeData& fd, const GSPrivRegSet* regs);
 };
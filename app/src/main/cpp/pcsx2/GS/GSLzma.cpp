@@ -19,7 +19,9 @@
 #include <XzCrc64.h>
 #include <zstd.h>
 
+#include <condition_variable>
 #include <mutex>
+#include <thread>
 
 using namespace GSDumpTypes;
 
@@ -69,6 +71,37 @@ bool GSDumpFile::GetPreviewImageFromDump(const char* filename, u32* width, u32*
 }
 
 bool GSDumpFile::ReadFile(Error* error)
+{
+	if (!ReadHeader(error))
+		return false;
+
+	// read all the packet data in
+	// TODO: make this suck less by getting the full/extracted size and preallocating
+	for (;;)
+	{
+		const size_t packet_data_size = m_packet_data.size();
+		m_packet_data.resize(std::max<size_t>(packet_data_size * 2, 8 * _1mb));
+
+		const size_t read_size = m_packet_data.size() - packet_data_size;
+		const size_t read = Read(m_packet_data.data() + packet_data_size, read_size);
+		if (read != read_size)
+		{
+			if (!IsEof())
+			{
+				Error::SetString(error, "Failed to read packet");
+				return false;
+			}
+
+			m_packet_data.resize(packet_data_size + read);
+			m_packet_data.shrink_to_fit();
+			break;
+		}
+	}
+
+	return ParsePackets(error);
+}
+
+bool GSDumpFile::ReadHeader(Error* error)
 {
 	u32 ss;
 	if (Read(&m_crc, sizeof(m_crc)) != sizeof(m_crc) || Read(&ss, sizeof(ss)) != sizeof(ss))
@@ -126,28 +159,12 @@ bool GSDumpFile::ReadFile(Error* error)
 		return false;
 	}
 
-	// read all the packet data in
-	// TODO: make this suck less by getting the full/extracted size and preallocating
-	for (;;)
-	{
-		const size_t packet_data_size = m_packet_data.size();
-		m_packet_data.resize(std::max<size_t>(packet_data_size * 2, 8 * _1mb));
-
-		const size_t read_size = m_packet_data.size() - packet_data_size;
-		const size_t read = Read(m_packet_data.data() + packet_data_size, read_size);
-		if (read != read_size)
-		{
-			if (!IsEof())
-			{
-				Error::SetString(error, "Failed to read packet");
-				return false;
-			}
+	return true;
+}
 
-			m_packet_data.resize(packet_data_size + read);
-			m_packet_data.shrink_to_fit();
-			break;
-		}
-	}
+bool GSDumpFile::ParsePackets(Error* error)
+{
+	m_dump_packets.clear();
 
 	u8* data = m_packet_data.data();
 	size_t remaining = m_packet_data.size();
@@ -613,6 +630,347 @@ namespace
 
 		return ret;
 	}
+
+	/******************************************************************/
+
+	class GSDumpZstChunked final : public GSDumpFile
+	{
+	public:
+		GSDumpZstChunked();
+		~GSDumpZstChunked() override;
+
+		bool ReadFile(Error* error) override;
+
+		bool IsChunked() const override;
+		u32 GetFrameCount() const override;
+		bool NextChunk(Error* error) override;
+		bool Rewind(Error* error) override;
+		bool SeekToFrame(u32 frame, ByteArray* state, ByteArray* regs, u32* keyframe, Error* error) override;
+
+	protected:
+		bool Open(FileSystem::ManagedCFilePtr fp, Error* error) override;
+		bool IsEof() override;
+		size_t Read(void* ptr, size_t size) override;
+
+	private:
+		bool Decompress(const GSDumpChunkedEntry& entry, std::vector<u8>* out, Error* error);
+		bool LoadPacketChunk(size_t chunk, Error* error);
+		void Prefetch(size_t chunk);
+		void WorkerThread();
+
+		std::vector<GSDumpChunkedEntry> m_packet_chunks;
+		std::vector<GSDumpChunkedEntry> m_keyframes;
+		u32 m_frame_count = 0;
+
+		// the header is only read once, chunk 0 is trimmed to the packets which follow it
+		std::vector<u8> m_chunk;
+		size_t m_chunk_pos = 0;
+		size_t m_header_size = 0;
+		size_t m_current_chunk = 0;
+
+		// at most one chunk is decompressed ahead of the one being replayed
+		std::thread m_worker;
+		std::mutex m_file_mutex;
+		std::mutex m_mutex;
+		std::condition_variable m_cv;
+		std::vector<u8> m_ready_data;
+		size_t m_request = SIZE_MAX;
+		size_t m_working_chunk = SIZE_MAX;
+		size_t m_ready_chunk = SIZE_MAX;
+		bool m_shutdown = false;
+	};
+
+	GSDumpZstChunked::GSDumpZstChunked() = default;
+
+	GSDumpZstChunked::~GSDumpZstChunked()
+	{
+		if (m_worker.joinable())
+		{
+			{
+				std::unique_lock lock(m_mutex);
+				m_shutdown = true;
+			}
+			m_cv.notify_all();
+			m_worker.join();
+		}
+	}
+
+	bool GSDumpZstChunked::Open(FileSystem::ManagedCFilePtr fp, Error* error)
+	{
+		m_fp = std::move(fp);
+
+		GSDumpChunkedHeader header;
+		GSDumpChunkedFooter footer;
+		if (std::fread(&header, sizeof(header), 1, m_fp.get()) != 1 || header.magic != GSDumpChunkedHeader::MAGIC)
+		{
+			Error::SetString(error, "Not a chunked GS dump");
+			return false;
+		}
+		if (header.version != GSDumpChunkedHeader::VERSION)
+		{
+			Error::SetString(error, fmt::format("Unsupported chunked GS dump version {}", header.version));
+			return false;
+		}
+		if (FileSystem::FSeek64(m_fp.get(), -static_cast<s64>(sizeof(footer)), SEEK_END) != 0 ||
+			std::fread(&footer, sizeof(footer), 1, m_fp.get()) != 1 || footer.magic != GSDumpChunkedHeader::MAGIC)
+		{
+			Error::SetString(error, "Chunked GS dump is missing its index, it was probably not closed properly");
+			return false;
+		}
+
+		// The index sits between the chunks and the footer, so it can't be larger than the file.
+		const s64 file_size = FileSystem::FSize64(m_fp.get());
+		if (file_size < static_cast<s64>(sizeof(header) + sizeof(footer)) ||
+			footer.index_offset > static_cast<u64>(file_size) - sizeof(footer) ||
+			static_cast<u64>(footer.index_count) * sizeof(GSDumpChunkedEntry) >
+				static_cast<u64>(file_size) - sizeof(footer) - footer.index_offset)
+		{
+			Error::SetString(error, fmt::format("Chunk index of {} entries at offset {} does not fit in the file",
+				footer.index_count, footer.index_offset));
+			return false;
+		}
+
+		std::vector<GSDumpChunkedEntry> index(footer.index_count);
+		if (FileSystem::FSeek64(m_fp.get(), static_cast<s64>(footer.index_offset), SEEK_SET) != 0 ||
+			std::fread(index.data(), sizeof(GSDumpChunkedEntry), index.size(), m_fp.get()) != index.size())
+		{
+			Error::SetString(error, "Failed to read chunk index");
+			return false;
+		}
+
+		for (const GSDumpChunkedEntry& entry : index)
+		{
+			if (entry.offset > footer.index_offset || entry.compressed_size > footer.index_offset - entry.offset)
+			{
+				Error::SetString(error, fmt::format("Chunk at offset {} runs past the chunk index", entry.offset));
+				return false;
+			}
+
+			if (entry.type == GSDumpChunkedEntry::TYPE_KEYFRAME)
+				m_keyframes.push_back(entry);
+			else
+				m_packet_chunks.push_back(entry);
+		}
+
+		if (m_packet_chunks.empty() || m_keyframes.empty())
+		{
+			Error::SetString(error, "Chunked GS dump has no packets");
+			return false;
+		}
+
+		m_frame_count = footer.frame_count;
+		DevCon.WriteLnFmt("Chunked GS dump has {} frames across {} chunks, {} keyframes", m_frame_count,
+			m_packet_chunks.size(), m_keyframes.size());
+
+		if (!Decompress(m_packet_chunks[0], &m_chunk, error))
+			return false;
+
+		m_worker = std::thread(&GSDumpZstChunked::WorkerThread, this);
+		return true;
+	}
+
+	bool GSDumpZstChunked::Decompress(const GSDumpChunkedEntry& entry, std::vector<u8>* out, Error* error)
+	{
+		std::vector<u8> compressed(entry.compressed_size);
+		{
+			std::unique_lock lock(m_file_mutex);
+			if (FileSystem::FSeek64(m_fp.get(), static_cast<s64>(entry.offset), SEEK_SET) != 0 ||
+				std::fread(compressed.data(), compressed.size(), 1, m_fp.get()) != 1)
+			{
+				Error::SetString(error, fmt::format("Failed to read {} bytes from offset {}", entry.compressed_size, entry.offset));
+				return false;
+			}
+		}
+
+		// Don't trust the index for the allocation, the frame header has to agree with it.
+		if (ZSTD_getFrameContentSize(compressed.data(), compressed.size()) != entry.raw_size)
+		{
+			Error::SetString(error, fmt::format("Chunk at offset {} does not decompress to {} bytes", entry.offset, entry.raw_size));
+			return false;
+		}
+
+		out->resize(entry.raw_size);
+		const size_t ret = ZSTD_decompress(out->data(), out->size(), compressed.data(), compressed.size());
+		if (ZSTD_isError(ret) || ret != entry.raw_size)
+		{
+			Error::SetString(error, fmt::format("Failed to decompress chunk at offset {}: {}", entry.offset,
+				ZSTD_isError(ret) ? ZSTD_getErrorName(ret) : "size mismatch"));
+			return false;
+		}
+
+		return true;
+	}
+
+	void GSDumpZstChunked::WorkerThread()
+	{
+		std::unique_lock lock(m_mutex);
+		for (;;)
+		{
+			m_cv.wait(lock, [this]() { return m_shutdown || m_request != SIZE_MAX; });
+			if (m_shutdown)
+				break;
+
+			const size_t chunk = m_request;
+			m_request = SIZE_MAX;
+			m_working_chunk = chunk;
+			lock.unlock();
+
+			std::vector<u8> data;
+			Error error;
+			const bool result = Decompress(m_packet_chunks[chunk], &data, &error);
+			if (!result)
+				Console.ErrorFmt("(GSDump) {}", error.GetDescription());
+
+			lock.lock();
+			m_working_chunk = SIZE_MAX;
+			if (result)
+			{
+				m_ready_data = std::move(data);
+				m_ready_chunk = chunk;
+			}
+			m_cv.notify_all();
+		}
+	}
+
+	void GSDumpZstChunked::Prefetch(size_t chunk)
+	{
+		std::unique_lock lock(m_mutex);
+		if (m_ready_chunk == chunk || m_working_chunk == chunk)
+			return;
+
+		m_request = chunk;
+		m_cv.notify_all();
+	}
+
+	bool GSDumpZstChunked::LoadPacketChunk(size_t chunk, Error* error)
+	{
+		std::vector<u8> data;
+		{
+			std::unique_lock lock(m_mutex);
+			if (m_working_chunk == chunk)
+				m_cv.wait(lock, [this]() { return m_working_chunk == SIZE_MAX; });
+
+			if (m_ready_chunk == chunk)
+			{
+				data = std::move(m_ready_data);
+				m_ready_chunk = SIZE_MAX;
+			}
+			else
+			{
+				// drop whatever was prefetched, we're going elsewhere
+				m_ready_data = {};
+				m_ready_chunk = SIZE_MAX;
+				m_request = SIZE_MAX;
+			}
+		}
+
+		if (data.empty() && !Decompress(m_packet_chunks[chunk], &data, error))
+			return false;
+
+		if (chunk == 0)
+			data.erase(data.begin(), data.begin() + std::min(m_header_size, data.size()));
+
+		m_packet_data = std::move(data);
+		m_current_chunk = chunk;
+		if (!ParsePackets(error))
+			return false;
+
+		Prefetch((chunk + 1) % m_packet_chunks.size());
+		return true;
+	}
+
+	bool GSDumpZstChunked::ReadFile(Error* error)
+	{
+		if (!ReadHeader(error))
+			return false;
+
+		m_header_size = m_chunk_pos;
+		m_packet_data.assign(m_chunk.begin() + m_chunk_pos, m_chunk.end());
+		m_chunk = {};
+		m_chunk_pos = 0;
+		m_current_chunk = 0;
+		if (!ParsePackets(error))
+			return false;
+
+		Prefetch(1 % m_packet_chunks.size());
+		return true;
+	}
+
+	bool GSDumpZstChunked::IsEof()
+	{
+		return (m_chunk_pos == m_chunk.size());
+	}
+
+	size_t GSDumpZstChunked::Read(void* ptr, size_t size)
+	{
+		const size_t read = std::min(size, m_chunk.size() - m_chunk_pos);
+		std::memcpy(ptr, m_chunk.data() + m_chunk_pos, read);
+		m_chunk_pos += read;
+		return read;
+	}
+
+	bool GSDumpZstChunked::IsChunked() const
+	{
+		return true;
+	}
+
+	u32 GSDumpZstChunked::GetFrameCount() const
+	{
+		return m_frame_count;
+	}
+
+	bool GSDumpZstChunked::NextChunk(Error* error)
+	{
+		if ((m_current_chunk + 1) >= m_packet_chunks.size())
+			return false;
+
+		return LoadPacketChunk(m_current_chunk + 1, error);
+	}
+
+	bool GSDumpZstChunked::Rewind(Error* error)
+	{
+		return (m_current_chunk == 0 && !m_dump_packets.empty()) || LoadPacketChunk(0, error);
+	}
+
+	bool GSDumpZstChunked::SeekToFrame(u32 frame, ByteArray* state, ByteArray* regs, u32* keyframe, Error* error)
+	{
+		auto it = std::upper_bound(m_keyframes.begin(), m_keyframes.end(), frame,
+			[](u32 frame, const GSDumpChunkedEntry& entry) { return frame < entry.first_frame; });
+		if (it != m_keyframes.begin())
+			--it;
+
+		std::vector<u8> data;
+		if (!Decompress(*it, &data, error))
+			return false;
+
+		u32 state_size;
+		if (data.size() < sizeof(state_size))
+		{
+			Error::SetString(error, "Keyframe is corrupted");
+			return false;
+		}
+		std::memcpy(&state_size, data.data(), sizeof(state_size));
+		if ((sizeof(state_size) + static_cast<u64>(state_size) + 8192) > data.size())
+		{
+			Error::SetString(error, "Keyframe is corrupted");
+			return false;
+		}
+
+		const u8* ptr = data.data() + sizeof(state_size);
+		state->assign(ptr, ptr + state_size);
+		regs->assign(ptr + state_size, ptr + state_size + 8192);
+
+		const auto chunk = std::find_if(m_packet_chunks.begin(), m_packet_chunks.end(),
+			[first_frame = it->first_frame](const GSDumpChunkedEntry& entry) { return entry.first_frame == first_frame; });
+		if (chunk == m_packet_chunks.end())
+		{
+			Error::SetString(error, fmt::format("No packets for keyframe at frame {}", it->first_frame));
+			return false;
+		}
+
+		*keyframe = it->first_frame;
+		return LoadPacketChunk(static_cast<size_t>(chunk - m_packet_chunks.begin()), error);
+	}
 } // namespace
 
 /******************************************************************/
@@ -624,7 +982,9 @@ std::unique_ptr<GSDumpFile> GSDumpFile::OpenGSDump(const char* filename, Error*
 		return nullptr;
 
 	std::unique_ptr<GSDumpFile> file;
-	if (StringUtil::EndsWithNoCase(filename, ".xz"))
+	if (StringUtil::EndsWithNoCase(filename, ".gs.zsc"))
+		file = std::make_unique<GSDumpZstChunked>();
+	else if (StringUtil::EndsWithNoCase(filename, ".xz"))
 		file = std::make_unique<GSDumpLzma>();
 	else if (StringUtil::EndsWithNoCase(filename, ".zst"))
 		file = std::make_unique<GSDumpDecompressZst>();
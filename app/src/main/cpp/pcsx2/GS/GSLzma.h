@@ -302,7 +302,17 @@ public:
 	__fi const ByteArray& GetStateData() const { return m_state_data; }
 	__fi const GSDataArray& GetPackets() const { return m_dump_packets; }
 
-	bool ReadFile(Error* error);
+	virtual bool ReadFile(Error* error);
+
+	/// Chunked dumps only keep a window of the packets in memory, GetPackets() returns the current one.
+	/// NextChunk() moves to the following window and fails at the end, Rewind() goes back to the first.
+	virtual bool IsChunked() const { return false; }
+	virtual u32 GetFrameCount() const { return 0; }
+	virtual bool NextChunk(Error* error = nullptr) { return false; }
+	virtual bool Rewind(Error* error = nullptr) { return true; }
+
+	/// Loads the nearest keyframe at or before frame, and the packets following it.
+	virtual bool SeekToFrame(u32 frame, ByteArray* state, ByteArray* regs, u32* keyframe, Error* error = nullptr) { return false; }
 
 protected:
 	GSDumpFile();
@@ -311,18 +321,21 @@ protected:
 	virtual bool IsEof() = 0;
 	virtual size_t Read(void* ptr, size_t size) = 0;
 
+	bool ReadHeader(Error* error);
+	bool ParsePackets(Error* error);
+
 protected:
 	FileSystem::ManagedCFilePtr m_fp;
 
+	std::vector<u8> m_packet_data;
+	GSDataArray m_dump_packets;
+
 private:
 	std::string m_serial;
 	u32 m_crc = 0;
 
 	std::vector<u8> m_regs_data;
 	std::vector<u8> m_state_data;
-	std::vector<u8> m_packet_data;
-
-	GSDataArray m_dump_packets;
 };
 
 // Initializes CRC tables used by LZMA SDK.
@@ -4,6 +4,9 @@
 #include "GSPerfMon.h"
 #include "GS.h"
 
+#include "common/HostSys.h"
+
+#include <algorithm>
 #include <cstring>
 
 GSPerfMon g_perfmon;
@@ -17,6 +20,19 @@ void GSPerfMon::Reset()
 	m_count = 0;
 	std::memset(m_counters, 0, sizeof(m_counters));
 	std::memset(m_stats, 0, sizeof(m_stats));
+	std::memset(m_totals, 0, sizeof(m_totals));
+	SetWorkerCount(m_worker_count);
+}
+
+void GSPerfMon::SetWorkerCount(u32 count)
+{
+	m_worker_count = std::min(count, MaxWorkers);
+	for (u32 i = 0; i < MaxWorkers; i++)
+	{
+		m_worker_busy[i].store(0, std::memory_order_relaxed);
+		m_worker_stats[i] = 0.0;
+	}
+	m_worker_last_update = GetCPUTicks();
 }
 
 void GSPerfMon::EndFrame(bool frame_only)
@@ -39,5 +55,17 @@ void GSPerfMon::Update()
 		m_count = 0;
 	}
 
+	for (size_t i = 0; i < std::size(m_counters); i++)
+		m_totals[i] += m_counters[i];
+
 	memset(m_counters, 0, sizeof(m_counters));
+
+	const u64 now = GetCPUTicks();
+	const double elapsed = static_cast<double>(now - m_worker_last_update);
+	m_worker_last_update = now;
+	for (u32 i = 0; i < m_worker_count; i++)
+	{
+		const u64 busy = m_worker_busy[i].exchange(0, std::memory_order_relaxed);
+		m_worker_stats[i] = (elapsed > 0.0) ? std::min(static_cast<double>(busy) * 100.0 / elapsed, 100.0) : 0.0;
+	}
 }
@@ -5,6 +5,7 @@
 
 #include "common/Pcsx2Defs.h"
 
+#include <atomic>
 #include <ctime>
 
 class GSPerfMon
@@ -22,6 +23,10 @@ public:
 		SyncPoint,
 		Barriers,
 		RenderPasses,
+		TextureLookups,
+		TextureHits,
+		CLUTExpands,
+		CLUTHits,
 		CounterLast,
 
 		// Reused counters for HW.
@@ -29,14 +34,23 @@ public:
 		TextureUploads = SyncPoint,
 	};
 
+	static constexpr u32 MaxWorkers = 32;
+
 protected:
 	double m_counters[CounterLast] = {};
 	double m_stats[CounterLast] = {};
+	double m_totals[CounterLast] = {};
 	u64 m_frame = 0;
 	clock_t m_lastframe = 0;
 	int m_count = 0;
 	int m_disp_fb_sprite_blits = 0;
 
+	// SW rasterizer workers, busy time is in GetCPUTicks() units.
+	std::atomic<u64> m_worker_busy[MaxWorkers] = {};
+	double m_worker_stats[MaxWorkers] = {};
+	u32 m_worker_count = 0;
+	u64 m_worker_last_update = 0;
+
 public:
 	GSPerfMon();
 
@@ -48,9 +62,22 @@ public:
 
 	void Put(counter_t c, double val) { m_counters[c] += val; }
 	double GetCounter(counter_t c) { return m_counters[c]; }
+	/// Running total since Reset(), Update() only folds the counters into it.
+	double GetTotal(counter_t c) { return m_totals[c] + m_counters[c]; }
 	double Get(counter_t c) { return m_stats[c]; }
 	void Update();
 
+	void SetWorkerCount(u32 count);
+	u32 GetWorkerCount() const { return m_worker_count; }
+	__fi void PutWorkerBusy(u32 worker, u64 ticks)
+	{
+		if (worker < MaxWorkers)
+			m_worker_busy[worker].fetch_add(ticks, std::memory_order_relaxed);
+	}
+	/// Percentage of the last update interval the worker spent rasterizing, the rest of it was idle.
+	double GetWorkerBusy(u32 worker) const { return m_worker_stats[worker]; }
+	double GetWorkerIdle(u32 worker) const { return 100.0 - m_worker_stats[worker]; }
+
 	__fi void AddDisplayFramebufferSpriteBlit() { m_disp_fb_sprite_blits++; }
 	__fi int GetDisplayFramebufferSpriteBlits()
 	{
@@ -1108,6 +1108,10 @@ struct alignas(32) GIFPath
 	u32 nreg;
 	u32 reg;
 	u32 type;
+	u8 vtx_attr; // VTX_* bits present in a TYPE_VERTEX loop
+	u8 vtx_xyzf; // XYZF2 instead of XYZ2
+	u8 vtx_stq, vtx_rgba, vtx_uv, vtx_fog, vtx_xyz; // offsets within the loop, 0xff if absent
+	u8 _pad;
 	GSVector4i regs;
 
 	enum
@@ -1115,7 +1119,15 @@ struct alignas(32) GIFPath
 		TYPE_UNKNOWN,
 		TYPE_ADONLY,
 		TYPE_STQRGBAXYZF2,
-		TYPE_STQRGBAXYZ2
+		TYPE_STQRGBAXYZ2,
+		TYPE_VERTEX
+	};
+
+	enum
+	{
+		VTX_STQ = 1 << 0,
+		VTX_RGBA = 1 << 1,
+		VTX_UV = 1 << 2,
 	};
 
 	__forceinline void SetTag(const void* mem)
@@ -1209,8 +1221,72 @@ struct alignas(32) GIFPath
 					default:
 						ASSUME(0);
 				}
+
+				if (type == TYPE_UNKNOWN)
+					SetVertexType();
+			}
+		}
+	}
+
+	// Any loop made of vertex attributes (each at most once, STQ before RGBA, NOPs anywhere) ending in
+	// XYZ2/XYZF2 emits exactly one vertex per iteration, so it can be unpacked without per-register dispatch.
+	void SetVertexType()
+	{
+		u32 attr = 0;
+
+		vtx_stq = vtx_rgba = vtx_uv = vtx_fog = vtx_xyz = 0xff;
+
+		for (u32 i = 0; i < nreg; i++)
+		{
+			const u8 r = regs.U8[i];
+
+			if (r == GIF_REG_NOP || r == GIF_REG_INVALID)
+				continue;
+
+			if (vtx_xyz != 0xff)
+				return; // something after the kick
+
+			switch (r)
+			{
+				case GIF_REG_STQ:
+					if (attr & VTX_STQ)
+						return;
+					attr |= VTX_STQ;
+					vtx_stq = i;
+					break;
+				case GIF_REG_RGBA:
+					if (attr & VTX_RGBA)
+						return;
+					attr |= VTX_RGBA;
+					vtx_rgba = i;
+					break;
+				case GIF_REG_UV:
+					if (attr & VTX_UV)
+						return;
+					attr |= VTX_UV;
+					vtx_uv = i;
+					break;
+				case GIF_REG_FOG:
+					if (vtx_fog != 0xff)
+						return;
+					vtx_fog = i;
+					break;
+				case GIF_REG_XYZF2:
+				case GIF_REG_XYZ2:
+					vtx_xyzf = (r == GIF_REG_XYZF2);
+					vtx_xyz = i;
+					break;
+				default:
+					return;
 			}
 		}
+
+		// RGBA picks up Q from the STQ written before it
+		if (vtx_xyz == 0xff || ((attr & VTX_STQ) && vtx_rgba < vtx_stq))
+			return;
+
+		vtx_attr = attr;
+		type = TYPE_VERTEX;
 	}
 
 	__forceinline u8 GetReg() const
@@ -219,7 +219,15 @@ void GSState::SetPrimHandlers()
 	m_fpGIFRegHandlerXYZ[P][2] = &GSState::GIFRegHandlerXYZ2<P, 0, auto_flush, index_swap>; \
 	m_fpGIFRegHandlerXYZ[P][3] = &GSState::GIFRegHandlerXYZ2<P, 1, auto_flush, index_swap>; \
 	m_fpGIFPackedRegHandlerSTQRGBAXYZF2[P] = &GSState::GIFPackedRegHandlerSTQRGBAXYZF2<P, auto_flush, index_swap>; \
-	m_fpGIFPackedRegHandlerSTQRGBAXYZ2[P] = &GSState::GIFPackedRegHandlerSTQRGBAXYZ2<P, auto_flush, index_swap>;
+	m_fpGIFPackedRegHandlerSTQRGBAXYZ2[P] = &GSState::GIFPackedRegHandlerSTQRGBAXYZ2<P, auto_flush, index_swap>; \
+	m_fpGIFPackedRegHandlerVertex[P][0] = &GSState::GIFPackedRegHandlerVertex<P, 0, auto_flush, index_swap>; \
+	m_fpGIFPackedRegHandlerVertex[P][1] = &GSState::GIFPackedRegHandlerVertex<P, 1, auto_flush, index_swap>; \
+	m_fpGIFPackedRegHandlerVertex[P][2] = &GSState::GIFPackedRegHandlerVertex<P, 2, auto_flush, index_swap>; \
+	m_fpGIFPackedRegHandlerVertex[P][3] = &GSState::GIFPackedRegHandlerVertex<P, 3, auto_flush, index_swap>; \
+	m_fpGIFPackedRegHandlerVertex[P][4] = &GSState::GIFPackedRegHandlerVertex<P, 4, auto_flush, index_swap>; \
+	m_fpGIFPackedRegHandlerVertex[P][5] = &GSState::GIFPackedRegHandlerVertex<P, 5, auto_flush, index_swap>; \
+	m_fpGIFPackedRegHandlerVertex[P][6] = &GSState::GIFPackedRegHandlerVertex<P, 6, auto_flush, index_swap>; \
+	m_fpGIFPackedRegHandlerVertex[P][7] = &GSState::GIFPackedRegHandlerVertex<P, 7, auto_flush, index_swap>;
 
 	SetHandlerXYZ(GS_POINTLIST, true, false);
 	SetHandlerXYZ(GS_LINELIST, auto_flush, index_swap);
@@ -727,6 +735,88 @@ void GSState::GIFPackedRegHandlerNOP(const GIFPackedReg* RESTRICT r, u32 size)
 {
 }
 
+template <u32 prim, u32 attr, bool auto_flush, bool index_swap>
+void GSState::GIFPackedRegHandlerVertex(const GIFPackedReg* RESTRICT r, u32 size, const GIFPath& path)
+{
+	const u32 nreg = path.nreg;
+
+	pxAssert(size > 0 && size % nreg == 0);
+
+	CheckFlushes();
+
+	// the layout is fixed for the whole tag, only FOG and XYZ vs XYZF are left as (well predicted) branches
+	const u32 stq = path.vtx_stq;
+	const u32 rgba = path.vtx_rgba;
+	const u32 uv = path.vtx_uv;
+	const u32 fog = path.vtx_fog;
+	const u32 xyz = path.vtx_xyz;
+	const bool has_fog = (fog != 0xff);
+	const bool xyzf = path.vtx_xyzf;
+	const bool uv_hack = GSConfig.UserHacks_ForceEvenSpritePosition;
+
+	const GIFPackedReg* RESTRICT r_end = r + size;
+
+	while (r < r_end)
+	{
+		if constexpr ((attr & GIFPath::VTX_STQ) != 0)
+		{
+			const GSVector4i st = GSVector4i::loadl(&r[stq].U64[0]);
+			GSVector4i q = GSVector4i::loadl(&r[stq].U64[1]);
+
+			GSVector4i::storel(&m_v.ST, st);
+
+			q = q.blend8(GSVector4i::cast(GSVector4::m_one), q == GSVector4i::zero()); // see GIFPackedRegHandlerSTQ
+			q = GSVector4i::cast(GSVector4::cast(q).replace_nan(GSVector4::m_max));
+
+			GSVector4::store(&m_q, GSVector4::cast(q));
+		}
+
+		if constexpr ((attr & GIFPath::VTX_RGBA) != 0)
+		{
+			const GSVector4i v = GSVector4i::load<false>(&r[rgba]).shuffle8(GSVector4i::load(0x0c080400));
+
+			m_v.RGBAQ.U32[0] = (u32)GSVector4i::store(v);
+			m_v.RGBAQ.Q = m_q;
+		}
+
+		if constexpr ((attr & GIFPath::VTX_UV) != 0)
+		{
+			const GSVector4i v = GSVector4i::loadl(&r[uv]) & GSVector4i::x00003fff();
+
+			m_v.UV = (u32)GSVector4i::store(v.ps32(v));
+
+			// Set on every write like GIFPackedRegHandlerUV_Hack, a flush inside the loop clears it
+			if (uv_hack)
+				m_isPackedUV_HackFlag = true;
+		}
+
+		if (has_fog)
+			m_v.FOG = r[fog].FOG.F;
+
+		if (xyzf)
+		{
+			GSVector4i xy = GSVector4i::loadl(&r[xyz].U64[0]);
+			GSVector4i zf = GSVector4i::loadl(&r[xyz].U64[1]);
+			xy = xy.upl16(xy.srl<4>()).upl32(GSVector4i::load((int)m_v.UV));
+			zf = zf.srl32<4>() & GSVector4i::x00ffffff().upl32(GSVector4i::x000000ff());
+
+			m_v.m[1] = xy.upl32(zf);
+		}
+		else
+		{
+			const GSVector4i xy = GSVector4i::loadl(&r[xyz].U64[0]);
+			const GSVector4i z = GSVector4i::loadl(&r[xyz].U64[1]);
+			const GSVector4i v = xy.upl16(xy.srl<4>()).upl32(z);
+
+			m_v.m[1] = v.upl64(GSVector4i::loadl(&m_v.UV));
+		}
+
+		VertexKick<prim, auto_flush, index_swap>(r[xyz].XYZF2.Skip());
+
+		r += nreg;
+	}
+}
+
 void GSState::GIFRegHandlerNull(const GIFReg* RESTRICT r)
 {
 }
@@ -2470,6 +2560,12 @@ void GSState::Transfer(const u8* mem, u32 size)
 
 								mem += total * sizeof(GIFPackedReg);
 
+								break;
+							case GIFPath::TYPE_VERTEX:
+								(this->*m_fpGIFPackedRegHandlerVertex[PRIM->PRIM][path.vtx_attr])((GIFPackedReg*)mem, total, path);
+
+								mem += total * sizeof(GIFPackedReg);
+
 								break;
 							default:
 								ASSUME(0);
@@ -59,6 +59,12 @@ private:
 	template<u32 prim, bool auto_flush, bool index_swap> void GIFPackedRegHandlerSTQRGBAXYZ2(const GIFPackedReg* RESTRICT r, u32 size);
 	void GIFPackedRegHandlerNOP(const GIFPackedReg* RESTRICT r, u32 size);
 
+	typedef void (GSState::*GIFPackedRegHandlerV)(const GIFPackedReg* RESTRICT r, u32 size, const GIFPath& path);
+
+	GIFPackedRegHandlerV m_fpGIFPackedRegHandlerVertex[8][8] = {};
+
+	template<u32 prim, u32 attr, bool auto_flush, bool index_swap> void GIFPackedRegHandlerVertex(const GIFPackedReg* RESTRICT r, u32 size, const GIFPath& path);
+
 	template<int i> void ApplyTEX0(GIFRegTEX0& TEX0);
 	void ApplyPRIM(u32 prim);
 
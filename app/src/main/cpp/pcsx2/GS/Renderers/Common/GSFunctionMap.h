@@ -18,6 +18,7 @@ protected:
 	{
 		u64 frame, frames, prims;
 		u64 ticks, actual, total;
+		u64 uses;
 		VALUE f;
 	};
 
@@ -64,9 +65,25 @@ public:
 			m_active = p;
 		}
 
+		m_active->uses++;
+
 		return m_active->f;
 	}
 
+	/// Calls f(key, uses) for every function looked up since the last call, and resets the counts.
+	template <typename F>
+	void ConsumeUses(const F& f)
+	{
+		for (auto& i : m_map_active)
+		{
+			if (i.second->uses > 0)
+			{
+				f(i.first, i.second->uses);
+				i.second->uses = 0;
+			}
+		}
+	}
+
 	void UpdateStats(u64 frame, u64 ticks, int actual, int total, int prims)
 	{
 		if (m_active)
@@ -142,6 +159,7 @@ namespace GSCodeReserve
 	void ResetMemory();
 
 	size_t GetMemoryUsed();
+	size_t GetMemorySize();
 
 	u8* ReserveMemory(size_t size);
 	void CommitMemory(size_t size);
@@ -152,6 +170,9 @@ class GSCodeGeneratorFunctionMap : public GSFunctionMap<KEY, VALUE>
 {
 	std::string m_name;
 	std::unordered_map<u64, VALUE> m_cgmap;
+	u32 m_compiled = 0;
+	u32 m_preloaded = 0;
+	u64 m_compile_ticks = 0;
 
 	enum { MAX_SIZE = 8192 };
 
@@ -180,6 +201,8 @@ public:
 		}
 		else
 		{
+			const u64 start = GetCPUTicks();
+
 			HostSys::BeginCodeWrite();
 
 			u8* code_ptr = GSCodeReserve::ReserveMemory(MAX_SIZE);
@@ -202,8 +225,29 @@ public:
 			ret = (VALUE)cg.GetCode();
 
 			m_cgmap[key] = ret;
+
+			m_compiled++;
+			m_compile_ticks += GetCPUTicks() - start;
 		}
 
 		return ret;
 	}
+
+	/// Generates the function for key ahead of its first use.
+	void Preload(KEY key)
+	{
+		if (m_cgmap.find(key) != m_cgmap.end())
+			return;
+
+		if (GetDefaultFunction(key))
+			m_preloaded++;
+	}
+
+	u32 GetCompiledCount() const { return m_compiled; }
+
+	void PrintCompileStats()
+	{
+		printf("%s: %u functions compiled (%u preloaded) in %.2f ms\n", m_name.c_str(), m_compiled, m_preloaded,
+			static_cast<double>(m_compile_ticks) * 1000.0 / static_cast<double>(GetTickFrequency()));
+	}
 };
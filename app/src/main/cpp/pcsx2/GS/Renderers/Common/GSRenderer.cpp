@@ -9,6 +9,7 @@
 #include "GS/GSGL.h"
 #include "GS/GSPerfMon.h"
 #include "GS/GSUtil.h"
+#include "GSDumpBenchmark.h"
 #include "GSDumpReplayer.h"
 #include "Host.h"
 #include "PerformanceMetrics.h"
@@ -610,6 +611,9 @@ void GSRenderer::VSync(u32 field, bool registers_written, bool idle_frame)
 	m_last_draw_n = s_n;
 	m_last_transfer_n = s_transfer_n;
 
+	if (GSDumpReplayer::IsRunner())
+		GSDumpBenchmark::RecordFrame();
+
 	// Skip presentation when running uncapped while vsync is on.
 	if (skip_frame || g_gs_device->ShouldSkipPresentingFrame())
 	{
@@ -719,6 +723,13 @@ void GSRenderer::VSync(u32 field, bool registers_written, bool idle_frame)
 					screenshot_pixels.empty() ? nullptr : screenshot_pixels.data(), fd, m_regs);
 				compression_str = TRANSLATE_SV("GS", "with LZMA compression");
 			}
+			else if (GSConfig.GSDumpCompression == GSDumpCompressionMethod::ZstandardChunked)
+			{
+				m_dump = GSDumpBase::CreateZstChunkedDump(m_snapshot, VMManager::GetDiscSerial(),
+					VMManager::GetDiscCRC(), screenshot_width, screenshot_height,
+					screenshot_pixels.empty() ? nullptr : screenshot_pixels.data(), fd, m_regs);
+				compression_str = TRANSLATE_SV("GS", "with chunked Zstandard compression");
+			}
 			else
 			{
 				m_dump = GSDumpBase::CreateZstDump(m_snapshot, VMManager::GetDiscSerial(),
@@ -766,9 +777,21 @@ void GSRenderer::VSync(u32 field, bool registers_written, bool idle_frame)
 				Host::OSD_INFO_DURATION);
 			m_dump.reset();
 		}
-		else if (!last)
+		else
 		{
-			m_dump_frames--;
+			if (m_dump->NeedsKeyframe())
+			{
+				// Only the snapshot has to happen here, packing and compression run on the dump's thread.
+				freezeData fd = {0, nullptr};
+				Freeze(&fd, true);
+				DynamicHeapArray<u8, 64> state(static_cast<size_t>(fd.size));
+				fd.data = state.data();
+				Freeze(&fd, false);
+				m_dump->AddKeyframe(std::move(state), m_regs);
+			}
+
+			if (!last)
+				m_dump_frames--;
 		}
 	}
 
@@ -6,8 +6,12 @@
 #include "GS/Renderers/SW/GSScanlineEnvironment.h"
 #include "GS/Renderers/SW/GSRasterizer.h"
 
+#include "PersistentCache.h"
+#include "VMManager.h"
+
 #include "common/Console.h"
 
+#include <algorithm>
 #include <fstream>
 
 // Comment to disable all dynamic code generation.
@@ -34,8 +38,13 @@ GSDrawScanline::GSDrawScanline()
 
 GSDrawScanline::~GSDrawScanline()
 {
+	SaveKernelCache();
+
 	if (const size_t used = GSCodeReserve::GetMemoryUsed(); used > 0)
-		DevCon.WriteLn("SW JIT generated %zu bytes of code", used);
+	{
+		DevCon.WriteLn("SW JIT generated %zu bytes of code (%u setup prim, %u draw scanline functions)", used,
+			m_sp_map.GetCompiledCount(), m_ds_map.GetCompiledCount());
+	}
 }
 
 bool GSDrawScanline::ShouldUseCDrawScanline(u64 key)
@@ -180,9 +189,204 @@ void GSDrawScanline::UpdateDrawStats(u64 frame, u64 ticks, int actual, int total
 
 void GSDrawScanline::PrintStats()
 {
+	m_sp_map.PrintCompileStats();
+	m_ds_map.PrintCompileStats();
 	m_ds_map.PrintStats();
 }
 
+// The cache holds the selectors along with how often each one was looked up. The kernels are
+// regenerated from them when a game starts, most used first, instead of on the first draw which
+// needs them.
+enum : u32
+{
+	KERNEL_CACHE_SIGNATURE = 0x4B4A5753, // SWJK
+	// Layout of KernelCacheEntry, the selector layout is folded in by GetKernelCacheVersion().
+	KERNEL_CACHE_FORMAT = 1,
+	KERNEL_CACHE_MAX_PRELOAD = 2048,
+};
+
+struct KernelCacheEntry
+{
+	u64 key;
+	u32 uses;
+	u32 type; // Index into m_kernel_uses
+};
+
+// Hashes the key bits of every selector field, so moving, resizing, adding or removing a field
+// invalidates caches written by other builds. Generator changes don't matter, the code is always
+// rebuilt from the selector.
+static u32 GetKernelCacheVersion()
+{
+	u32 hash = 0x811C9DC5u ^ KERNEL_CACHE_FORMAT;
+	const auto add_field = [&hash](u64 mask) {
+		for (u32 i = 0; i < sizeof(mask); i++)
+			hash = (hash ^ static_cast<u8>(mask >> (i * 8))) * 0x01000193u;
+	};
+
+#define ADD_SELECTOR_FIELD(name) \
+	{ \
+		GSScanlineSelector sel; \
+		sel.key = 0; \
+		sel.name = ~0u; \
+		add_field(sel.key); \
+	}
+	ADD_SELECTOR_FIELD(fpsm);
+	ADD_SELECTOR_FIELD(zpsm);
+	ADD_SELECTOR_FIELD(ztst);
+	ADD_SELECTOR_FIELD(atst);
+	ADD_SELECTOR_FIELD(afail);
+	ADD_SELECTOR_FIELD(iip);
+	ADD_SELECTOR_FIELD(tfx);
+	ADD_SELECTOR_FIELD(tcc);
+	ADD_SELECTOR_FIELD(fst);
+	ADD_SELECTOR_FIELD(ltf);
+	ADD_SELECTOR_FIELD(tlu);
+	ADD_SELECTOR_FIELD(fge);
+	ADD_SELECTOR_FIELD(date);
+	ADD_SELECTOR_FIELD(abe);
+	ADD_SELECTOR_FIELD(aba);
+	ADD_SELECTOR_FIELD(abb);
+	ADD_SELECTOR_FIELD(abc);
+	ADD_SELECTOR_FIELD(abd);
+	ADD_SELECTOR_FIELD(pabe);
+	ADD_SELECTOR_FIELD(aa1);
+	ADD_SELECTOR_FIELD(fwrite);
+	ADD_SELECTOR_FIELD(ftest);
+	ADD_SELECTOR_FIELD(rfb);
+	ADD_SELECTOR_FIELD(zwrite);
+	ADD_SELECTOR_FIELD(ztest);
+	ADD_SELECTOR_FIELD(zoverflow);
+	ADD_SELECTOR_FIELD(zclamp);
+	ADD_SELECTOR_FIELD(wms);
+	ADD_SELECTOR_FIELD(wmt);
+	ADD_SELECTOR_FIELD(datm);
+	ADD_SELECTOR_FIELD(colclamp);
+	ADD_SELECTOR_FIELD(fba);
+	ADD_SELECTOR_FIELD(dthe);
+	ADD_SELECTOR_FIELD(prim);
+	ADD_SELECTOR_FIELD(edge);
+	ADD_SELECTOR_FIELD(tw);
+	ADD_SELECTOR_FIELD(lcm);
+	ADD_SELECTOR_FIELD(mmin);
+	ADD_SELECTOR_FIELD(notest);
+	ADD_SELECTOR_FIELD(zequal);
+	ADD_SELECTOR_FIELD(breakpoint);
+#undef ADD_SELECTOR_FIELD
+
+	return hash;
+}
+
+void GSDrawScanline::OpenKernelCache()
+{
+	std::string path;
+	if (const u32 crc = VMManager::GetCurrentCRC(); crc != 0)
+		path = PersistentCache::GetGamePath("swjit", VMManager::GetDiscSerial(), crc);
+
+	if (path == m_kernel_cache_path)
+		return;
+
+	SaveKernelCache();
+
+	// Anything looked up before now belongs to the previous game (or the BIOS).
+	m_sp_map.ConsumeUses([](u64, u64) {});
+	m_ds_map.ConsumeUses([](u64, u64) {});
+	m_kernel_uses[0].clear();
+	m_kernel_uses[1].clear();
+
+	m_kernel_cache_path = std::move(path);
+	if (!m_kernel_cache_path.empty() && LoadKernelCache())
+		PreloadKernels();
+}
+
+bool GSDrawScanline::LoadKernelCache()
+{
+	PersistentCache::Reader reader;
+	if (!reader.Open(m_kernel_cache_path, KERNEL_CACHE_SIGNATURE, GetKernelCacheVersion()))
+		return false;
+
+	std::vector<KernelCacheEntry> entries;
+	if (!reader.ReadArray(&entries, reader.GetCount()))
+	{
+		Console.Warning("Truncated SW JIT cache '%s'", m_kernel_cache_path.c_str());
+		return false;
+	}
+
+	for (const KernelCacheEntry& entry : entries)
+	{
+		if (entry.type < std::size(m_kernel_uses))
+			m_kernel_uses[entry.type][entry.key] += entry.uses;
+	}
+
+	return true;
+}
+
+void GSDrawScanline::PreloadKernels()
+{
+	std::vector<KernelCacheEntry> order;
+	for (u32 type = 0; type < std::size(m_kernel_uses); type++)
+	{
+		for (const auto& [key, uses] : m_kernel_uses[type])
+			order.push_back({key, static_cast<u32>(std::min<u64>(uses, UINT32_MAX)), type});
+	}
+
+	std::sort(order.begin(), order.end(), [](const KernelCacheEntry& l, const KernelCacheEntry& r) { return l.uses > r.uses; });
+
+	// Leave most of the code space to whatever the game does differently this time.
+	const size_t max_used = GSCodeReserve::GetMemorySize() / 4;
+	const u64 start = GetCPUTicks();
+	u32 count = 0;
+	for (const KernelCacheEntry& entry : order)
+	{
+		if (count == KERNEL_CACHE_MAX_PRELOAD || GSCodeReserve::GetMemoryUsed() >= max_used)
+			break;
+
+		if (entry.type == 0)
+			m_sp_map.Preload(entry.key);
+		else
+			m_ds_map.Preload(entry.key);
+
+		count++;
+	}
+
+	DevCon.WriteLn("SW JIT: Preloaded %u of %zu cached functions in %.2f ms", count, order.size(),
+		static_cast<double>(GetCPUTicks() - start) * 1000.0 / static_cast<double>(GetTickFrequency()));
+}
+
+void GSDrawScanline::SaveKernelCache()
+{
+	if (m_kernel_cache_path.empty())
+		return;
+
+	bool dirty = false;
+	m_sp_map.ConsumeUses([this, &dirty](u64 key, u64 uses) {
+		m_kernel_uses[0][key] += uses;
+		dirty = true;
+	});
+	m_ds_map.ConsumeUses([this, &dirty](u64 key, u64 uses) {
+		m_kernel_uses[1][key] += uses;
+		dirty = true;
+	});
+	if (!dirty)
+		return;
+
+	std::vector<KernelCacheEntry> entries;
+	for (u32 type = 0; type < std::size(m_kernel_uses); type++)
+	{
+		for (const auto& [key, uses] : m_kernel_uses[type])
+			entries.push_back({key, static_cast<u32>(std::min<u64>(uses, UINT32_MAX)), type});
+	}
+
+	PersistentCache::Writer writer;
+	if (!writer.Open(m_kernel_cache_path, KERNEL_CACHE_SIGNATURE, GetKernelCacheVersion(), static_cast<u32>(entries.size())) ||
+		!writer.WriteArray(entries))
+	{
+		Console.Error("Failed to write SW JIT cache '%s'", m_kernel_cache_path.c_str());
+		return;
+	}
+
+	DevCon.WriteLn("SW JIT: Saved %zu cached functions", entries.size());
+}
+
 #if _M_SSE >= 0x501
 typedef GSVector8i VectorI;
 typedef GSVector8  VectorF;
@@ -51,10 +51,22 @@ public:
 	void UpdateDrawStats(u64 frame, u64 ticks, int actual, int total, int prims);
 	void PrintStats();
 
+	/// Switches the persistent kernel cache to the running game, and compiles the selectors it used most.
+	void OpenKernelCache();
+
+	/// Merges the selectors used since the last save into the cache of the current game.
+	void SaveKernelCache();
+
 private:
 	GSCodeGeneratorFunctionMap<GSSetupPrimCodeGenerator, u64, SetupPrimPtr> m_sp_map;
 	GSCodeGeneratorFunctionMap<GSDrawScanlineCodeGenerator, u64, DrawScanlinePtr> m_ds_map;
 
+	std::string m_kernel_cache_path;
+	std::unordered_map<u64, u64> m_kernel_uses[2]; // setup prim, draw scanline
+
+	bool LoadKernelCache();
+	void PreloadKernels();
+
 	static void CSetupPrim(const GSVertexSW* vertex, const u16* index, const GSVertexSW& dscan, GSScanlineLocalData& local);
 	static void CDrawScanline(int pixels, int left, int top, const GSVertexSW& scan, GSScanlineLocalData& local);
 	static void CDrawEdge(int pixels, int left, int top, const GSVertexSW& scan, GSScanlineLocalData& local);
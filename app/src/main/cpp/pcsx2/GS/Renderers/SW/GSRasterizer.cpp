@@ -125,7 +125,12 @@ int GSRasterizer::GetPixels(bool reset)
 
 void GSRasterizer::Draw(GSRasterizerData& data)
 {
-	if ((data.vertex && data.vertex_count == 0) || (data.index && data.index_count == 0))
+	Draw(data, data.scissor, data.index, data.index_count);
+}
+
+void GSRasterizer::Draw(GSRasterizerData& data, const GSVector4i& scissor, const u16* index, int index_count)
+{
+	if ((data.vertex && data.vertex_count == 0) || (index && index_count == 0))
 		return;
 
 	m_pixels.actual = 0;
@@ -140,19 +145,37 @@ void GSRasterizer::Draw(GSRasterizerData& data)
 	m_draw_edge = data.draw_edge;
 	GSDrawScanline::BeginDraw(data, m_local);
 
+	// Blocks have to belong to a single thread, the lower bounds are updated without any locking.
+	// Tiled workers are created with one thread and the tiles are block aligned. Banded workers
+	// only own whole blocks when a band is at least a block high, extra threads heights of 1 and
+	// 2 interleave the rows of a block between threads, so those draw without coarse Z.
+	m_coarse_z.blocks = (m_threads == 1 || m_thread_height >= GSCoarseZBlock::SHIFT) ? data.coarse_z : nullptr;
+
+	if (m_coarse_z.blocks)
+	{
+		const GSScanlineSelector& sel = data.global.sel;
+
+		m_coarse_z.epoch = data.coarse_z_epoch;
+		m_coarse_z.zmask = 0xFFFFFFFFu >> (sel.zpsm * 8);
+		m_coarse_z.zclamp = sel.zclamp ? m_coarse_z.zmask : 0xFFFFFFFFu;
+		m_coarse_z.greater = (sel.ztst == ZTST_GREATER);
+		m_coarse_z.sprite = (data.primclass == GS_SPRITE_CLASS);
+		m_coarse_z.z = 0;
+		m_coarse_z.dz = 0.0;
+	}
+
 	const GSVertexSW* vertex = data.vertex;
 	const GSVertexSW* vertex_end = data.vertex + data.vertex_count;
 
-	const u16* index = data.index;
-	const u16* index_end = data.index + data.index_count;
+	const u16* index_end = index + index_count;
 
 	static constexpr u16 tmp_index[] = {0, 1, 2};
 
-	bool scissor_test = !data.bbox.eq(data.bbox.rintersect(data.scissor));
+	bool scissor_test = !data.bbox.eq(data.bbox.rintersect(scissor));
 
-	m_scissor = data.scissor;
-	m_fscissor_x = GSVector4(data.scissor).xzxz();
-	m_fscissor_y = GSVector4(data.scissor).ywyw();
+	m_scissor = scissor;
+	m_fscissor_x = GSVector4(scissor).xzxz();
+	m_fscissor_y = GSVector4(scissor).ywyw();
 	m_scanmsk_value = data.scanmsk_value;
 
 	switch (data.primclass)
@@ -161,11 +184,11 @@ void GSRasterizer::Draw(GSRasterizerData& data)
 
 			if (scissor_test)
 			{
-				DrawPoint<true>(vertex, data.vertex_count, index, data.index_count);
+				DrawPoint<true>(vertex, data.vertex_count, index, index_count);
 			}
 			else
 			{
-				DrawPoint<false>(vertex, data.vertex_count, index, data.index_count);
+				DrawPoint<false>(vertex, data.vertex_count, index, index_count);
 			}
 
 			break;
@@ -266,7 +289,7 @@ void GSRasterizer::DrawPoint(const GSVertexSW* vertex, int vertex_count, const u
 			{
 				if (IsOneOfMyScanlines(p.y))
 				{
-					m_setup_prim(vertex, index, GSVertexSW::zero(), m_local);
+					SetupPrim(vertex, index, GSVertexSW::zero());
 
 					DrawScanline(1, p.x, p.y, v);
 				}
@@ -287,7 +310,7 @@ void GSRasterizer::DrawPoint(const GSVertexSW* vertex, int vertex_count, const u
 			{
 				if (IsOneOfMyScanlines(p.y))
 				{
-					m_setup_prim(vertex, tmp_index, GSVertexSW::zero(), m_local);
+					SetupPrim(vertex, tmp_index, GSVertexSW::zero());
 
 					DrawScanline(1, p.x, p.y, v);
 				}
@@ -355,7 +378,7 @@ void GSRasterizer::DrawLine(const GSVertexSW* vertex, const u16* index)
 
 					scan += dscan * (l - scan.p).xxxx();
 
-					m_setup_prim(vertex, index, dscan, m_local);
+					SetupPrim(vertex, index, dscan);
 
 					DrawScanline(pixels, left, p.y, scan);
 				}
@@ -850,7 +873,7 @@ void GSRasterizer::DrawSprite(const GSVertexSW* vertex, const u16* index)
 
 	scan.t = (scan.t + dt * prestep).xyzw(scan.t);
 
-	m_setup_prim(vertex, index, dscan, m_local);
+	SetupPrim(vertex, index, dscan);
 
 	while (1)
 	{
@@ -1079,7 +1102,7 @@ void GSRasterizer::Flush(const GSVertexSW* vertex, const u16* index, const GSVer
 
 	if (count > 0)
 	{
-		m_setup_prim(vertex, index, dscan, m_local);
+		SetupPrim(vertex, index, dscan);
 
 		const GSVertexSW* RESTRICT e = m_edge.buff;
 		const GSVertexSW* RESTRICT ee = e + count;
@@ -1117,9 +1140,30 @@ void GSRasterizer::Flush(const GSVertexSW* vertex, const u16* index, const GSVer
 #define PIXELS_PER_LOOP 4
 #endif
 
+void GSRasterizer::SetupPrim(const GSVertexSW* vertex, const u16* index, const GSVertexSW& dscan)
+{
+	if (m_coarse_z.blocks)
+	{
+		if (m_coarse_z.sprite)
+			m_coarse_z.z = vertex[index[1]].t.U32[3];
+		else
+			m_coarse_z.dz = dscan.p.F64[1];
+	}
+
+	m_setup_prim(vertex, index, dscan, m_local);
+}
+
 void GSRasterizer::DrawScanline(int pixels, int left, int top, const GSVertexSW& scan)
 {
 	if ((m_scanmsk_value & 2) && (m_scanmsk_value & 1) == (top & 1)) return;
+
+	if (m_coarse_z.blocks)
+	{
+		pixels = TestCoarseZ(pixels, left, top, scan);
+
+		if (pixels == 0)
+			return;
+	}
 	m_pixels.actual += pixels;
 	m_pixels.total += ((left + pixels + (PIXELS_PER_LOOP - 1)) & ~(PIXELS_PER_LOOP - 1)) - (left & ~(PIXELS_PER_LOOP - 1));
 	//m_pixels.total += ((left + pixels + (PIXELS_PER_LOOP - 1)) & ~(PIXELS_PER_LOOP - 1)) - left;
@@ -1140,6 +1184,95 @@ void GSRasterizer::DrawEdge(int pixels, int left, int top, const GSVertexSW& sca
 	m_draw_edge(pixels, left, top, scan, m_local);
 }
 
+u32 GSRasterizer::GetCoarseZ(int x, int y)
+{
+	GSCoarseZBlock& block = m_coarse_z.blocks[y * GSCoarseZBlock::COUNT_X + x];
+
+	if (block.epoch != m_coarse_z.epoch)
+	{
+		const GSScanlineGlobalData& global = *m_local.gd;
+		const u8* vm = static_cast<const u8*>(global.vm);
+		const int top = y << GSCoarseZBlock::SHIFT;
+		const int left = x << (GSCoarseZBlock::SHIFT - 2);
+
+		// Same loads and masking as the ztest in the kernel (see GSDrawScanline::CDrawScanline),
+		// four pixels per column offset, two from each 16 byte half of the column.
+		GSVector4i zmin = GSVector4i::xffffffff();
+
+		for (int i = 0; i < (1 << GSCoarseZBlock::SHIFT); i++)
+		{
+			const int row = global.fzbr[top + i].y;
+
+			for (int j = 0; j < (1 << (GSCoarseZBlock::SHIFT - 2)); j++)
+			{
+				const u32 za = (row + global.fzbc[left + j].y) % HALF_VM_SIZE;
+
+				GSVector4i zd = GSVector4i::load(vm + za * 2, vm + za * 2 + 16);
+
+				switch (global.sel.zpsm)
+				{
+					case 1: zd = zd.sll32< 8>().srl32<8>(); break;
+					case 2: zd = zd.sll32<16>().srl32<16>(); break;
+					default: break;
+				}
+
+				zmin = zmin.min_u32(zd);
+			}
+		}
+
+		block.zmin = zmin.minv_u32();
+		block.epoch = m_coarse_z.epoch;
+	}
+
+	return block.zmin;
+}
+
+int GSRasterizer::TestCoarseZ(int pixels, int left, int top, const GSVertexSW& scan)
+{
+	u64 zs;
+
+	if (m_coarse_z.sprite)
+	{
+		zs = m_coarse_z.z;
+	}
+	else
+	{
+		// The kernel steps the same linear function, with a float per pixel offset for the first
+		// pixels and a truncation at the end, so leave some room around the exact endpoints.
+
+		const double z0 = scan.p.F64[1];
+		const double z1 = z0 + m_coarse_z.dz * (pixels - 1);
+		const double margin = 4.0 + std::abs(m_coarse_z.dz) * (1.0 / 64);
+		const double zlo = std::min(z0, z1) - margin;
+		const double zhi = std::max(z0, z1) + margin;
+
+		// negative values wrap around when converted
+
+		if (zlo < 0.0 || zhi >= 4294967295.0)
+			return pixels;
+
+		zs = static_cast<u64>(zhi);
+	}
+
+	zs = std::min<u64>(zs, m_coarse_z.zclamp);
+
+	// GEQUAL fails below the destination, GREATER also when equal.
+
+	const u64 zref = m_coarse_z.greater ? zs : zs + 1;
+	const int y = top >> GSCoarseZBlock::SHIFT;
+
+	int right = left + pixels;
+
+	// Rejected blocks at the end are cut off, the start would need the interpolants moved as well.
+
+	while (right > left && GetCoarseZ((right - 1) >> GSCoarseZBlock::SHIFT, y) >= zref)
+	{
+		right = ((right - 1) >> GSCoarseZBlock::SHIFT) << GSCoarseZBlock::SHIFT;
+	}
+
+	return std::max(right - left, 0);
+}
+
 //
 
 GSSingleRasterizer::GSSingleRasterizer()
@@ -1181,9 +1314,8 @@ int GSSingleRasterizer::GetPixels(bool reset /*= true*/)
 
 void GSSingleRasterizer::PrintStats()
 {
-#ifdef ENABLE_DRAW_STATS
-	m_ds.PrintStats();
-#endif
+	if constexpr (ENABLE_DRAW_STATS)
+		m_ds.PrintStats();
 }
 
 //
@@ -1201,11 +1333,13 @@ GSRasterizerList::GSRasterizerList(int threads)
 	}
 
 	PerformanceMetrics::SetGSSWThreadCount(threads);
+	g_perfmon.SetWorkerCount(threads);
 }
 
 GSRasterizerList::~GSRasterizerList()
 {
 	PerformanceMetrics::SetGSSWThreadCount(0);
+	g_perfmon.SetWorkerCount(0);
 	_aligned_free(m_scanline);
 }
 
@@ -1296,6 +1430,11 @@ std::unique_ptr<IRasterizer> GSRasterizerList::Create(int threads)
 		return std::make_unique<GSSingleRasterizer>();
 	}
 
+	if (GSConfig.SWTileBinning)
+	{
+		return GSTiledRasterizerList::Create(threads);
+	}
+
 	std::unique_ptr<GSRasterizerList> rl(new GSRasterizerList(threads));
 
 	const std::vector<u32>& procs = VMManager::Internal::GetSoftwareRendererProcessorList();
@@ -1310,7 +1449,11 @@ std::unique_ptr<IRasterizer> GSRasterizerList::Create(int threads)
 		auto& r = *rl->m_r[i];
 		rl->m_workers.push_back(std::unique_ptr<GSWorker>(new GSWorker(
 			[i, affinity]() { GSRasterizerList::OnWorkerStartup(i, affinity); },
-			[&r](GSRingHeap::SharedPtr<GSRasterizerData>& item) { r.Draw(*item.get()); },
+			[&r, i](GSRingHeap::SharedPtr<GSRasterizerData>& item) {
+				const u64 start = GetCPUTicks();
+				r.Draw(*item.get());
+				g_perfmon.PutWorkerBusy(i, GetCPUTicks() - start);
+			},
 			[i]() { GSRasterizerList::OnWorkerShutdown(i); })));
 	}
 
@@ -1319,4 +1462,293 @@ std::unique_ptr<IRasterizer> GSRasterizerList::Create(int threads)
 
 void GSRasterizerList::PrintStats()
 {
+	if constexpr (ENABLE_DRAW_STATS)
+		m_ds.PrintStats();
+}
+
+//
+
+GSTiledRasterizerList::GSTiledRasterizerList(int threads)
+	: m_sema(std::make_unique<Threading::WorkSema[]>(threads))
+	, m_bin(std::make_unique<Batch>())
+	, m_exec(std::make_unique<Batch>())
+{
+	m_bin->tiles = std::make_unique<Tile[]>(TILES_X * TILES_Y);
+	m_exec->tiles = std::make_unique<Tile[]>(TILES_X * TILES_Y);
+
+	PerformanceMetrics::SetGSSWThreadCount(threads);
+	g_perfmon.SetWorkerCount(threads);
+}
+
+GSTiledRasterizerList::~GSTiledRasterizerList()
+{
+	Sync();
+
+	m_exit = true;
+	for (size_t i = 0; i < m_threads.size(); i++)
+		m_sema[i].NotifyOfWork();
+	for (std::thread& thread : m_threads)
+		thread.join();
+
+	PerformanceMetrics::SetGSSWThreadCount(0);
+	g_perfmon.SetWorkerCount(0);
+}
+
+std::unique_ptr<IRasterizer> GSTiledRasterizerList::Create(int threads)
+{
+	std::unique_ptr<GSTiledRasterizerList> rl(new GSTiledRasterizerList(threads));
+
+	const std::vector<u32>& procs = VMManager::Internal::GetSoftwareRendererProcessorList();
+	const bool pin = (EmuConfig.EnableThreadPinning && static_cast<size_t>(threads) <= procs.size());
+	if (EmuConfig.EnableThreadPinning && !pin)
+		WARNING_LOG("Not pinning SW threads, we need {} processors, but only have {}", threads, procs.size());
+
+	// Every worker can end up drawing any tile, so they all own the whole screen.
+	for (int i = 0; i < threads; i++)
+		rl->m_r.push_back(std::unique_ptr<GSRasterizer>(new GSRasterizer(&rl->m_ds, 0, 1)));
+
+	for (int i = 0; i < threads; i++)
+	{
+		const u64 affinity = pin ? (static_cast<u64>(1u) << procs[i]) : 0;
+		rl->m_threads.emplace_back(&GSTiledRasterizerList::ThreadProc, rl.get(), i, affinity);
+	}
+
+	return rl;
+}
+
+void GSTiledRasterizerList::ThreadProc(int i, u64 affinity)
+{
+	GSRasterizerList::OnWorkerStartup(i, affinity);
+
+	GSRasterizer& r = *m_r[i];
+	while (true)
+	{
+		m_sema[i].WaitForWorkWithSpin();
+		if (m_exit)
+			break;
+
+		const u64 start = GetCPUTicks();
+
+		Batch& batch = *m_exec;
+		const u32 count = static_cast<u32>(batch.active.size());
+		for (u32 idx = batch.next.fetch_add(1, std::memory_order_relaxed); idx < count;
+			 idx = batch.next.fetch_add(1, std::memory_order_relaxed))
+		{
+			DrawTile(r, batch, batch.active[idx]);
+		}
+
+		g_perfmon.PutWorkerBusy(i, GetCPUTicks() - start);
+		m_running.fetch_sub(1, std::memory_order_release);
+	}
+
+	GSRasterizerList::OnWorkerShutdown(i);
+}
+
+void GSTiledRasterizerList::DrawTile(GSRasterizer& r, Batch& batch, u16 tile)
+{
+	const int tx = tile % TILES_X;
+	const int ty = tile / TILES_X;
+	const GSVector4i rect(tx << TILE_SHIFT_X, ty << TILE_SHIFT_Y, (tx + 1) << TILE_SHIFT_X, (ty + 1) << TILE_SHIFT_Y);
+
+	const Tile& t = batch.tiles[tile];
+	for (const TileDraw& td : t.draws)
+	{
+		GSRasterizerData& data = *batch.draws[td.draw].get();
+		const GSVector4i scissor = data.scissor.rintersect(rect);
+
+		if (td.first == UINT32_MAX)
+			r.Draw(data, scissor, data.index, data.index_count);
+		else
+			r.Draw(data, scissor, &t.index[td.first], static_cast<int>(td.count));
+	}
+}
+
+void GSTiledRasterizerList::Bin(const GSRingHeap::SharedPtr<GSRasterizerData>& data)
+{
+	const GSRasterizerData& d = *data.get();
+	const GSVector4i r = d.bbox.rintersect(d.scissor);
+	if (r.rempty())
+		return;
+
+	pxAssert(r.top >= 0 && r.top < 2048 && r.bottom >= 0 && r.bottom <= 2048);
+
+	Batch& batch = *m_bin;
+	const u32 draw = static_cast<u32>(batch.draws.size());
+	batch.draws.push_back(data);
+
+	if (!d.index)
+	{
+		for (int ty = r.top >> TILE_SHIFT_Y; ty <= ((r.bottom - 1) >> TILE_SHIFT_Y); ty++)
+		{
+			for (int tx = r.left >> TILE_SHIFT_X; tx <= ((r.right - 1) >> TILE_SHIFT_X); tx++)
+			{
+				const u16 tile = static_cast<u16>(ty * TILES_X + tx);
+				Tile& t = batch.tiles[tile];
+				if (t.draws.empty())
+					batch.active.push_back(tile);
+				t.draws.push_back({draw, UINT32_MAX, 0});
+			}
+		}
+
+		return;
+	}
+
+	int n;
+	switch (d.primclass)
+	{
+		case GS_POINT_CLASS:
+			n = 1;
+			break;
+		case GS_LINE_CLASS:
+		case GS_SPRITE_CLASS:
+			n = 2;
+			break;
+		case GS_TRIANGLE_CLASS:
+			n = 3;
+			break;
+		default:
+			ASSUME(0);
+	}
+
+	for (int i = 0; i + n <= d.index_count; i += n)
+		BinPrim(batch, draw, r, &d.index[i], n, d.vertex);
+
+	batch.index_count += static_cast<u32>(d.index_count);
+}
+
+void GSTiledRasterizerList::BinPrim(Batch& batch, u32 draw, const GSVector4i& r, const u16* index, int n, const GSVertexSW* vertex)
+{
+	const GSVector4& p0 = vertex[index[0]].p;
+	float l = p0.x, t = p0.y, rr = p0.x, b = p0.y;
+	for (int i = 1; i < n; i++)
+	{
+		const GSVector4& p = vertex[index[i]].p;
+		l = std::min(l, p.x);
+		t = std::min(t, p.y);
+		rr = std::max(rr, p.x);
+		b = std::max(b, p.y);
+	}
+
+	// A pixel of slack for edges and rounding, the tile scissor does the exact clipping.
+	// The bounds come first so NaNs end up clamped.
+	const int left = static_cast<int>(std::max(static_cast<float>(r.left), l - 1.0f));
+	const int top = static_cast<int>(std::max(static_cast<float>(r.top), t - 1.0f));
+	const int right = static_cast<int>(std::min(static_cast<float>(r.right), rr + 2.0f));
+	const int bottom = static_cast<int>(std::min(static_cast<float>(r.bottom), b + 2.0f));
+	if (left >= right || top >= bottom)
+		return;
+
+	for (int ty = top >> TILE_SHIFT_Y; ty <= ((bottom - 1) >> TILE_SHIFT_Y); ty++)
+	{
+		for (int tx = left >> TILE_SHIFT_X; tx <= ((right - 1) >> TILE_SHIFT_X); tx++)
+		{
+			const u16 tile = static_cast<u16>(ty * TILES_X + tx);
+			Tile& tl = batch.tiles[tile];
+			if (tl.draws.empty())
+				batch.active.push_back(tile);
+			if (tl.draws.empty() || tl.draws.back().draw != draw)
+				tl.draws.push_back({draw, static_cast<u32>(tl.index.size()), 0});
+
+			tl.draws.back().count += n;
+			tl.index.insert(tl.index.end(), index, index + n);
+		}
+	}
+}
+
+void GSTiledRasterizerList::ClearBatch(Batch& batch)
+{
+	for (const u16 tile : batch.active)
+	{
+		batch.tiles[tile].draws.clear();
+		batch.tiles[tile].index.clear();
+	}
+
+	batch.active.clear();
+	batch.draws.clear();
+	batch.index_count = 0;
+}
+
+void GSTiledRasterizerList::Kick()
+{
+	if (m_bin->draws.empty())
+		return;
+
+	pxAssert(m_running.load(std::memory_order_acquire) == 0);
+
+	// The workers are done with the previous batch, recycle it for binning.
+	ClearBatch(*m_exec);
+	std::swap(m_bin, m_exec);
+
+	m_exec->next.store(0, std::memory_order_relaxed);
+	m_running.store(static_cast<u32>(m_threads.size()), std::memory_order_relaxed);
+	for (size_t i = 0; i < m_threads.size(); i++)
+		m_sema[i].NotifyOfWork();
+}
+
+void GSTiledRasterizerList::WaitBatch()
+{
+	for (size_t i = 0; i < m_threads.size(); i++)
+		m_sema[i].WaitForEmptyWithSpin();
+}
+
+void GSTiledRasterizerList::Queue(const GSRingHeap::SharedPtr<GSRasterizerData>& data)
+{
+	if (!m_ds.SetupDraw(*data.get())) [[unlikely]]
+	{
+		Sync();
+		m_ds.ResetCodeCache();
+		m_ds.SetupDraw(*data.get());
+	}
+
+	Bin(data);
+
+	// Start on whatever has been binned as soon as the workers are free, only block when the
+	// next batch has grown large enough that binning further would just add latency.
+	if (m_running.load(std::memory_order_acquire) == 0)
+	{
+		Kick();
+	}
+	else if (m_bin->draws.size() >= MAX_BATCH_DRAWS || m_bin->index_count >= MAX_BATCH_INDICES)
+	{
+		WaitBatch();
+		Kick();
+	}
+}
+
+void GSTiledRasterizerList::Sync()
+{
+	if (!IsSynced())
+	{
+		WaitBatch();
+		Kick();
+		WaitBatch();
+		ClearBatch(*m_exec);
+
+		g_perfmon.Put(GSPerfMon::SyncPoint, 1);
+	}
+}
+
+bool GSTiledRasterizerList::IsSynced() const
+{
+	// A finished batch still holds references to its draws, and through them to texture pages,
+	// until Sync() or the next Kick() clears it.
+	return m_bin->draws.empty() && m_exec->draws.empty() && m_running.load(std::memory_order_acquire) == 0;
+}
+
+int GSTiledRasterizerList::GetPixels(bool reset)
+{
+	int pixels = 0;
+
+	for (size_t i = 0; i < m_r.size(); i++)
+	{
+		pixels += m_r[i]->GetPixels(reset);
+	}
+
+	return pixels;
+}
+
+void GSTiledRasterizerList::PrintStats()
+{
+	if constexpr (ENABLE_DRAW_STATS)
+		m_ds.PrintStats();
 }
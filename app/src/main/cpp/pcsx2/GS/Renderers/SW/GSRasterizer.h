@@ -15,6 +15,19 @@ MULTI_ISA_UNSHARED_START
 
 class GSDrawScanline;
 
+// Lower bound of the depth buffer over an 8x8 pixel block. Entries are filled in lazily by the
+// rasterizer and are only trusted while their epoch matches the one of the draw, the renderer
+// moves to a new epoch whenever something could have lowered the values in the depth buffer.
+struct GSCoarseZBlock
+{
+	static constexpr int SHIFT = 3;
+	static constexpr int COUNT_X = 2048 >> SHIFT;
+	static constexpr int COUNT = COUNT_X * (2048 >> SHIFT);
+
+	u32 zmin;
+	u32 epoch;
+};
+
 class alignas(32) GSRasterizerData : public GSAlignedClass<32>
 {
 	static int s_counter;
@@ -33,6 +46,8 @@ public:
 	int pixels;
 	int counter;
 	u8 scanmsk_value;
+	GSCoarseZBlock* coarse_z; // NULL if spans can't be rejected early
+	u32 coarse_z_epoch;
 
 	GSScanlineGlobalData global;
 
@@ -53,6 +68,8 @@ public:
 		, start(0)
 		, pixels(0)
 		, scanmsk_value(0)
+		, coarse_z(NULL)
+		, coarse_z_epoch(0)
 	{
 		counter = s_counter++;
 	}
@@ -86,6 +103,18 @@ protected:
 	GSDrawScanline::DrawScanlinePtr m_draw_scanline = nullptr;
 	GSDrawScanline::DrawScanlinePtr m_draw_edge = nullptr;
 
+	struct
+	{
+		GSCoarseZBlock* blocks;
+		u32 epoch;
+		u32 zmask;
+		u32 zclamp;
+		bool greater;
+		bool sprite;
+		u32 z; // sprites
+		double dz; // everything else
+	} m_coarse_z = {};
+
 	__forceinline bool HasEdge() const { return (m_draw_edge != nullptr); }
 
 	template <bool scissor_test>
@@ -105,9 +134,13 @@ protected:
 	__forceinline void AddScanline(GSVertexSW* e, int pixels, int left, int top, const GSVertexSW& scan);
 	__forceinline void Flush(const GSVertexSW* vertex, const u16* index, const GSVertexSW& dscan, bool edge = false);
 
+	__forceinline void SetupPrim(const GSVertexSW* vertex, const u16* index, const GSVertexSW& dscan);
 	__forceinline void DrawScanline(int pixels, int left, int top, const GSVertexSW& scan);
 	__forceinline void DrawEdge(int pixels, int left, int top, const GSVertexSW& scan);
 
+	u32 GetCoarseZ(int x, int y);
+	int TestCoarseZ(int pixels, int left, int top, const GSVertexSW& scan);
+
 public:
 	GSRasterizer(GSDrawScanline* ds, int id, int threads);
 	~GSRasterizer();
@@ -117,6 +150,7 @@ public:
 	__forceinline int FindMyNextScanline(int top) const;
 
 	void Draw(GSRasterizerData& data);
+	void Draw(GSRasterizerData& data, const GSVector4i& scissor, const u16* index, int index_count);
 	int GetPixels(bool reset);
 };
 
@@ -130,6 +164,7 @@ public:
 	virtual bool IsSynced() const = 0;
 	virtual int GetPixels(bool reset = true) = 0;
 	virtual void PrintStats() = 0;
+	virtual GSDrawScanline& GetDrawScanline() = 0;
 };
 
 class GSSingleRasterizer final : public IRasterizer
@@ -143,6 +178,7 @@ public:
 	bool IsSynced() const override;
 	int GetPixels(bool reset = true) override;
 	void PrintStats() override;
+	GSDrawScanline& GetDrawScanline() override { return m_ds; }
 
 	void Draw(GSRasterizerData& data);
 
@@ -166,11 +202,85 @@ protected:
 
 	GSRasterizerList(int threads);
 
+public:
+	~GSRasterizerList() override;
+
 	static void OnWorkerStartup(int i, u64 affinity);
 	static void OnWorkerShutdown(int i);
 
+	static std::unique_ptr<IRasterizer> Create(int threads);
+
+	// IRasterizer
+
+	void Queue(const GSRingHeap::SharedPtr<GSRasterizerData>& data) override;
+	void Sync() override;
+	bool IsSynced() const override;
+	int GetPixels(bool reset) override;
+	void PrintStats() override;
+	GSDrawScanline& GetDrawScanline() override { return m_ds; }
+};
+
+// Bins the primitives of each draw into screen tiles on the GS thread, the workers then take
+// whole tiles from a shared cursor, so nobody rejects primitives outside of their area and a
+// thread which finishes early picks up the remaining tiles of the others.
+class GSTiledRasterizerList final : public IRasterizer
+{
+protected:
+	static constexpr int TILE_SHIFT_X = 6;
+	static constexpr int TILE_SHIFT_Y = 5;
+	static constexpr int TILES_X = 2048 >> TILE_SHIFT_X;
+	static constexpr int TILES_Y = 2048 >> TILE_SHIFT_Y;
+	static_assert(TILE_SHIFT_X >= GSCoarseZBlock::SHIFT && TILE_SHIFT_Y >= GSCoarseZBlock::SHIFT,
+		"Coarse Z blocks must not straddle tiles");
+	static constexpr u32 MAX_BATCH_DRAWS = 256;
+	static constexpr u32 MAX_BATCH_INDICES = 1024 * 1024;
+
+	struct TileDraw
+	{
+		u32 draw;
+		u32 first; // UINT32_MAX = unindexed, draw everything
+		u32 count;
+	};
+
+	struct Tile
+	{
+		std::vector<TileDraw> draws;
+		std::vector<u16> index;
+	};
+
+	struct Batch
+	{
+		std::vector<GSRingHeap::SharedPtr<GSRasterizerData>> draws;
+		std::vector<u16> active; // non-empty tiles, in the order they were first touched
+		std::unique_ptr<Tile[]> tiles;
+		u32 index_count = 0;
+		std::atomic<u32> next{0};
+	};
+
+	GSDrawScanline m_ds;
+
+	std::vector<std::unique_ptr<GSRasterizer>> m_r;
+	std::vector<std::thread> m_threads;
+	std::unique_ptr<Threading::WorkSema[]> m_sema;
+	std::atomic<u32> m_running{0};
+	bool m_exit = false;
+
+	// Binned on the GS thread, executed by the workers.
+	std::unique_ptr<Batch> m_bin;
+	std::unique_ptr<Batch> m_exec;
+
+	GSTiledRasterizerList(int threads);
+
+	void Bin(const GSRingHeap::SharedPtr<GSRasterizerData>& data);
+	void BinPrim(Batch& batch, u32 draw, const GSVector4i& r, const u16* index, int n, const GSVertexSW* vertex);
+	static void ClearBatch(Batch& batch);
+	void Kick();
+	void WaitBatch();
+	void ThreadProc(int i, u64 affinity);
+	void DrawTile(GSRasterizer& r, Batch& batch, u16 tile);
+
 public:
-	~GSRasterizerList() override;
+	~GSTiledRasterizerList() override;
 
 	static std::unique_ptr<IRasterizer> Create(int threads);
 
@@ -181,6 +291,7 @@ public:
 	bool IsSynced() const override;
 	int GetPixels(bool reset) override;
 	void PrintStats() override;
+	GSDrawScanline& GetDrawScanline() override { return m_ds; }
 };
 
 MULTI_ISA_UNSHARED_END
@@ -28,11 +28,31 @@ GSRendererSW::GSRendererSW(int threads)
 
 	m_tc = std::make_unique<GSTextureCacheSW>();
 	m_rl = GSRasterizerList::Create(threads);
+	m_rl->GetDrawScanline().OpenKernelCache();
+
+	// Vertex conversion, JIT lookups and handing out work to the rasterizers move to their own
+	// thread, the GS thread only keeps what depends on GS state and local memory ordering.
+	if (threads > 0 && GSConfig.SWDrawPipeline)
+	{
+		m_pipeline = std::make_unique<GSDrawPipeline>(
+			[]() { Threading::SetNameOfCurrentThread("GS-SW-Pipeline"); },
+			[this](GSRingHeap::SharedPtr<GSRasterizerData>& item) {
+				static_cast<SharedData*>(item.get())->PrepareVertices();
+				m_rl->Queue(item);
+			},
+			[]() {});
+	}
 
 	m_output = (u8*)_aligned_malloc(1024 * 1024 * sizeof(u32), VECTOR_ALIGNMENT);
 
 	std::fill(std::begin(m_fzb_pages), std::end(m_fzb_pages), 0);
 	std::fill(std::begin(m_tex_pages), std::end(m_tex_pages), 0);
+
+	if (GSConfig.SWCoarseZ)
+	{
+		m_coarse_z.blocks = static_cast<GSCoarseZBlock*>(_aligned_malloc(sizeof(GSCoarseZBlock) * GSCoarseZBlock::COUNT, VECTOR_ALIGNMENT));
+		std::memset(m_coarse_z.blocks, 0, sizeof(GSCoarseZBlock) * GSCoarseZBlock::COUNT);
+	}
 }
 
 GSRendererSW::~GSRendererSW()
@@ -49,15 +69,30 @@ void GSRendererSW::Reset(bool hardware_reset)
 
 	m_tc->RemoveAll();
 
+	InvalidateCoarseZ();
+
 	GSRenderer::Reset(hardware_reset);
 }
 
+void GSRendererSW::GameChanged()
+{
+	// The pipeline thread looks up kernels.
+	if (m_pipeline)
+		m_pipeline->Wait();
+
+	m_rl->GetDrawScanline().OpenKernelCache();
+}
+
 void GSRendererSW::Destroy()
 {
 	// Need to destroy worker queue first to stop any pending thread work
+	m_pipeline.reset();
 	m_rl.reset();
 	m_tc.reset();
 
+	_aligned_free(m_coarse_z.blocks);
+	m_coarse_z.blocks = nullptr;
+
 	for (GSTexture*& tex : m_texture)
 	{
 		delete tex;
@@ -340,7 +375,17 @@ void GSRendererSW::Draw()
 	// If you have both GS_SPRITE_CLASS && m_vt.m_eq.q, it will depends on the first part of the 'OR'
 	u32 q_div = !IsMipMapActive() && ((m_vt.m_eq.q && m_vt.m_min.t.z != 1.0f) || (!m_vt.m_eq.q && m_vt.m_primclass == GS_SPRITE_CLASS));
 
-	GSVertexSW::s_cvb[m_vt.m_primclass][PRIM->TME][PRIM->FST][q_div](m_context, sd->vertex, m_vertex.buff, m_vertex.next);
+	if (m_pipeline)
+	{
+		sd->m_raw_vertex = static_cast<GSVertex*>(m_vertex_heap.alloc(sizeof(GSVertex) * m_vertex.next, 32));
+		sd->m_cvb = GSVertexSW::s_cvb[m_vt.m_primclass][PRIM->TME][PRIM->FST][q_div];
+		sd->m_cvb_ctx = *m_context;
+		std::memcpy(sd->m_raw_vertex, m_vertex.buff, sizeof(GSVertex) * m_vertex.next);
+	}
+	else
+	{
+		GSVertexSW::s_cvb[m_vt.m_primclass][PRIM->TME][PRIM->FST][q_div](m_context, sd->vertex, m_vertex.buff, m_vertex.next);
+	}
 
 	std::memcpy(sd->index, m_index.buff, sizeof(u16) * m_index.tail);
 
@@ -366,6 +411,9 @@ void GSRendererSW::Draw()
 		return;
 	}
 
+	if (!m_pipeline)
+		sd->PrepareVertices();
+
 	if constexpr (LOG && false)
 	{
 		int n = GSUtil::GetVertexCount(PRIM->PRIM);
@@ -425,6 +473,11 @@ void GSRendererSW::Draw()
 
 	sd->UsePages(fb_pages, m_context->offset.fb.psm(), zb_pages, m_context->offset.zb.psm());
 
+	if (m_coarse_z.blocks)
+	{
+		SetupCoarseZ(sd, r, fb_pages, zb_pages);
+	}
+
 	if (GSConfig.ShouldDump(s_n, g_perfmon.GetFrame()))
 	{
 		Sync(2);
@@ -543,7 +596,10 @@ void GSRendererSW::Queue(GSRingHeap::SharedPtr<GSRasterizerData>& item)
 		fflush(s_fp);
 	}
 
-	m_rl->Queue(item);
+	if (m_pipeline)
+		m_pipeline->Push(item);
+	else
+		m_rl->Queue(item);
 
 	// invalidate new parts rendered onto
 
@@ -564,6 +620,9 @@ void GSRendererSW::Sync(int reason)
 
 	u64 t = LOG ? GetCPUTicks() : 0;
 
+	if (m_pipeline)
+		m_pipeline->Wait();
+
 	m_rl->Sync();
 
 	if constexpr (LOG && false)
@@ -598,6 +657,11 @@ void GSRendererSW::Sync(int reason)
 	g_perfmon.Put(GSPerfMon::Fillrate, pixels);
 }
 
+bool GSRendererSW::IsSynced() const
+{
+	return (!m_pipeline || m_pipeline->IsEmpty()) && m_rl->IsSynced();
+}
+
 void GSRendererSW::InvalidateVideoMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r)
 {
 	if constexpr (LOG)
@@ -611,7 +675,7 @@ void GSRendererSW::InvalidateVideoMem(const GIFRegBITBLTBUF& BITBLTBUF, const GS
 
 	// check if the changing pages either used as a texture or a target
 
-	if (!m_rl->IsSynced())
+	if (!IsSynced())
 	{
 		pages.loopPagesWithBreak([this](u32 page)
 		{
@@ -624,7 +688,12 @@ void GSRendererSW::InvalidateVideoMem(const GIFRegBITBLTBUF& BITBLTBUF, const GS
 		});
 	}
 
-	m_tc->InvalidatePages(pages, off.psm()); // if texture update runs on a thread and Sync(5) happens then this must come later
+	if (m_coarse_z.blocks && IsCoarseZPage(pages))
+	{
+		InvalidateCoarseZ();
+	}
+
+	m_tc->InvalidateBlocks(off, r); // if texture update runs on a thread and Sync(5) happens then this must come later
 }
 
 void GSRendererSW::InvalidateLocalMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r, bool clut)
@@ -635,7 +704,7 @@ void GSRendererSW::InvalidateLocalMem(const GIFRegBITBLTBUF& BITBLTBUF, const GS
 		fflush(s_fp);
 	}
 
-	if (!m_rl->IsSynced())
+	if (!IsSynced())
 	{
 		GSOffset off = m_mem.GetOffset(BITBLTBUF.SBP, BITBLTBUF.SBW, BITBLTBUF.SPSM);
 		GSOffset::PageLooper pages = off.pageLooperForRect(r);
@@ -652,6 +721,94 @@ void GSRendererSW::InvalidateLocalMem(const GIFRegBITBLTBUF& BITBLTBUF, const GS
 	}
 }
 
+void GSRendererSW::SetupCoarseZ(SharedData* sd, const GSVector4i& r, const GSOffset::PageLooper* fb_pages, const GSOffset::PageLooper* zb_pages)
+{
+	const GSScanlineSelector& sel = sd->global.sel;
+
+	// passing only greater or equal values keeps the lower bounds, any other depth write may not
+
+	const bool test = zb_pages && sel.ztest && (sel.ztst == ZTST_GEQUAL || sel.ztst == ZTST_GREATER);
+
+	if (test)
+	{
+		const u32 zbp = m_context->ZBUF.Block();
+		const u32 bw = m_context->FRAME.FBW;
+		const u32 zpsm = m_context->ZBUF.PSM;
+
+		if (zbp != m_coarse_z.zbp || bw != m_coarse_z.bw || zpsm != m_coarse_z.zpsm)
+		{
+			InvalidateCoarseZ();
+
+			m_coarse_z.zbp = zbp;
+			m_coarse_z.bw = bw;
+			m_coarse_z.zpsm = zpsm;
+		}
+
+		// the rasterizer reads whole blocks, which can reach outside of the drawn area
+
+		const GSVector4i br = r.ralign<Align_Outside>(GSVector2i(1 << GSCoarseZBlock::SHIFT, 1 << GSCoarseZBlock::SHIFT));
+
+		m_context->offset.zb.pageLooperForRect(br).loopPages([this](u32 page)
+		{
+			m_coarse_z.pages[page >> 5] |= 1u << (page & 31);
+		});
+	}
+	else if (zb_pages && sel.zwrite && IsCoarseZPage(*zb_pages))
+	{
+		InvalidateCoarseZ();
+	}
+
+	// frame buffer writes into the depth buffer, including this draw's own
+
+	if (fb_pages && sel.fwrite && IsCoarseZPage(*fb_pages))
+	{
+		InvalidateCoarseZ();
+		return;
+	}
+
+	if (test)
+	{
+		sd->coarse_z = m_coarse_z.blocks;
+		sd->coarse_z_epoch = m_coarse_z.epoch;
+	}
+}
+
+void GSRendererSW::InvalidateCoarseZ()
+{
+	if (!m_coarse_z.blocks)
+		return;
+
+	// old entries are told apart by their epoch, they only need clearing when it wraps around
+
+	if (++m_coarse_z.epoch == 0)
+	{
+		Sync(8);
+
+		std::memset(m_coarse_z.blocks, 0, sizeof(GSCoarseZBlock) * GSCoarseZBlock::COUNT);
+
+		m_coarse_z.epoch = 1;
+	}
+
+	std::fill(std::begin(m_coarse_z.pages), std::end(m_coarse_z.pages), 0);
+}
+
+bool GSRendererSW::IsCoarseZPage(const GSOffset::PageLooper& pages) const
+{
+	bool res = false;
+
+	pages.loopPagesWithBreak([this, &res](u32 page)
+	{
+		if (m_coarse_z.pages[page >> 5] & (1u << (page & 31)))
+		{
+			res = true;
+			return false;
+		}
+		return true;
+	});
+
+	return res;
+}
+
 void GSRendererSW::UsePages(const GSOffset::PageLooper& pages, const int type)
 {
 	pages.loopPages([this, type](u32 page)
@@ -702,7 +859,7 @@ void GSRendererSW::ReleasePages(const GSOffset::PageLooper& pages, const int typ
 
 bool GSRendererSW::CheckTargetPages(const GSOffset::PageLooper* fb_pages, const GSOffset::PageLooper* zb_pages, const GSVector4i& r)
 {
-	const bool synced = m_rl->IsSynced();
+	const bool synced = IsSynced();
 
 	const bool fb = (fb_pages != nullptr);
 	const bool zb = (zb_pages != nullptr);
@@ -886,7 +1043,7 @@ bool GSRendererSW::CheckTargetPages(const GSOffset::PageLooper* fb_pages, const
 
 bool GSRendererSW::CheckSourcePages(SharedData* sd)
 {
-	if (!m_rl->IsSynced())
+	if (!IsSynced())
 	{
 		for (size_t i = 0; sd->m_tex[i].t != NULL; i++)
 		{
@@ -1171,16 +1328,7 @@ bool GSRendererSW::GetScanlineGlobalData(SharedData* data)
 
 					// TODO: but not when mipmapping is used!!!
 
-					GSVector4 half(0x8000, 0x8000);
-
-					GSVertexSW* RESTRICT v = data->vertex;
-
-					for (int i = 0, j = data->vertex_count; i < j; i++)
-					{
-						GSVector4 t = v[i].t;
-
-						v[i].t = (t - half).xyzw(t);
-					}
+					data->m_half_texel_shift = true;
 				}
 			}
 
@@ -1415,6 +1563,9 @@ GSRendererSW::SharedData::SharedData()
 	, m_zpsm(0)
 	, m_using_pages(false)
 	, m_syncpoint(SyncNone)
+	, m_raw_vertex(nullptr)
+	, m_cvb(nullptr)
+	, m_half_texel_shift(false)
 {
 	m_tex[0].t = NULL;
 
@@ -1428,6 +1579,9 @@ GSRendererSW::SharedData::~SharedData()
 {
 	ReleasePages();
 
+	if (m_raw_vertex)
+		GSRingHeap::free(m_raw_vertex);
+
 	if (global.clut)
 		GSRingHeap::free(global.clut);
 	if (global.dimx)
@@ -1517,6 +1671,30 @@ void GSRendererSW::SharedData::SetSource(GSTextureCacheSW::Texture* t, const GSV
 	m_tex[level + 1].t = nullptr;
 }
 
+void GSRendererSW::SharedData::PrepareVertices()
+{
+	if (m_raw_vertex)
+	{
+		m_cvb(&m_cvb_ctx, vertex, m_raw_vertex, vertex_count);
+		GSRingHeap::free(m_raw_vertex);
+		m_raw_vertex = nullptr;
+	}
+
+	if (m_half_texel_shift)
+	{
+		const GSVector4 half(0x8000, 0x8000);
+
+		GSVertexSW* RESTRICT v = vertex;
+
+		for (int i = 0, j = vertex_count; i < j; i++)
+		{
+			GSVector4 t = v[i].t;
+
+			v[i].t = (t - half).xyzw(t);
+		}
+	}
+}
+
 void GSRendererSW::SharedData::UpdateSource()
 {
 	for (size_t i = 0; m_tex[i].t; i++)
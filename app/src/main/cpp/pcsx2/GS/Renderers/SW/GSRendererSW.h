@@ -35,6 +35,12 @@ public:
 			SyncTarget
 		} m_syncpoint;
 
+		// Unconverted vertices, when the conversion is left to the draw pipeline thread.
+		GSVertex* m_raw_vertex;
+		GSVertexSW::ConvertVertexBufferPtr m_cvb;
+		GSDrawingContext m_cvb_ctx;
+		bool m_half_texel_shift;
+
 	public:
 		SharedData();
 		virtual ~SharedData();
@@ -44,10 +50,16 @@ public:
 
 		void SetSource(GSTextureCacheSW::Texture* t, const GSVector4i& r, int level);
 		void UpdateSource();
+
+		/// Converts the raw vertices (if they were deferred) and applies the bilinear half texel shift.
+		void PrepareVertices();
 	};
 
 protected:
+	using GSDrawPipeline = GSJobQueue<GSRingHeap::SharedPtr<GSRasterizerData>, 256>;
+
 	std::unique_ptr<IRasterizer> m_rl;
+	std::unique_ptr<GSDrawPipeline> m_pipeline;
 	std::unique_ptr<GSTextureCacheSW> m_tc;
 	GSRingHeap m_vertex_heap;
 	std::array<GSTexture*, 3> m_texture = {};
@@ -60,7 +72,17 @@ protected:
 	GIFRegDIMX m_last_dimx = {};
 	GSVector4i m_dimx[8] = {};
 
+	// Lower bounds of the depth buffer last tested with GEQUAL or GREATER, see GSCoarseZBlock.
+	struct
+	{
+		GSCoarseZBlock* blocks = nullptr;
+		u32 epoch = 1;
+		u32 zbp = 0, bw = 0, zpsm = 0;
+		u32 pages[16] = {}; // what the current epoch has read from
+	} m_coarse_z;
+
 	void Reset(bool hardware_reset) override;
+	void GameChanged() override;
 	void VSync(u32 field, bool registers_written, bool idle_frame) override;
 	GSTexture* GetOutput(int i, float& scale, int& y_offset) override;
 	GSTexture* GetFeedbackOutput(float& scale) override;
@@ -68,6 +90,7 @@ protected:
 	void Draw() override;
 	void Queue(GSRingHeap::SharedPtr<GSRasterizerData>& item);
 	void Sync(int reason);
+	bool IsSynced() const;
 	void InvalidateVideoMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r) override;
 	void InvalidateLocalMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r, bool clut = false) override;
 
@@ -77,6 +100,10 @@ protected:
 	bool CheckTargetPages(const GSOffset::PageLooper* fb_pages, const GSOffset::PageLooper* zb_pages, const GSVector4i& r);
 	bool CheckSourcePages(SharedData* sd);
 
+	void SetupCoarseZ(SharedData* sd, const GSVector4i& r, const GSOffset::PageLooper* fb_pages, const GSOffset::PageLooper* zb_pages);
+	void InvalidateCoarseZ();
+	bool IsCoarseZPage(const GSOffset::PageLooper& pages) const;
+
 	bool GetScanlineGlobalData(SharedData* data);
 
 public:
@@ -7,48 +7,57 @@
 #include "GS/GSPng.h"
 #include "GS/GSUtil.h"
 
-GSTextureCacheSW::GSTextureCacheSW() = default;
+#include "common/HashCombine.h"
+
+size_t GSTextureCacheSW::TextureKeyHash::operator()(const TextureKey& k) const
+{
+	std::size_t h = 0;
+	HashCombine(h, k.TEX0, k.TEXA, k.tw0);
+	return h;
+}
+
+GSTextureCacheSW::GSTextureCacheSW()
+{
+	m_dirty_pages.reserve(MAX_PAGES);
+}
 
 GSTextureCacheSW::~GSTextureCacheSW()
 {
 	RemoveAll();
 }
 
-GSTextureCacheSW::Texture* GSTextureCacheSW::Lookup(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, u32 tw0)
+GSTextureCacheSW::TextureKey GSTextureCacheSW::GetKey(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, u32 tw0)
 {
 	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[TEX0.PSM];
 
-	auto& m = m_map[TEX0.TBP0 >> 5];
-
-	for (auto i = m.begin(); i != m.end(); ++i)
-	{
-		Texture* t = *i;
-
-		if (((TEX0.U32[0] ^ t->m_TEX0.U32[0]) | ((TEX0.U32[1] ^ t->m_TEX0.U32[1]) & 3)) != 0) // TBP0 TBW PSM TW TH
-		{
-			continue;
-		}
+	TextureKey key;
+	key.TEX0 = TEX0.U64 & 0x3ffffffffull;
+	key.TEXA = ((psm.trbpp == 16 || psm.trbpp == 24) && TEX0.TCC) ? TEXA.U64 : 0;
+	key.tw0 = tw0;
+	return key;
+}
 
-		if ((psm.trbpp == 16 || psm.trbpp == 24) && TEX0.TCC && TEXA != t->m_TEXA)
-		{
-			continue;
-		}
+GSTextureCacheSW::Texture* GSTextureCacheSW::Lookup(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, u32 tw0)
+{
+	const TextureKey key = GetKey(TEX0, TEXA, tw0);
 
-		if (tw0 != 0 && t->m_tw != tw0)
-		{
-			continue;
-		}
+	g_perfmon.Put(GSPerfMon::TextureLookups, 1);
 
+	if (auto it = m_lookup.find(key); it != m_lookup.end())
+	{
 		// Lookup hit
-		m.MoveFront(i.Index());
+		Texture* t = it->second;
+		g_perfmon.Put(GSPerfMon::TextureHits, 1);
 		t->m_age = 0;
 		return t;
 	}
 
 	// Lookup miss
 	Texture* t = new Texture(tw0, TEX0, TEXA);
+	t->m_key = key;
 
 	m_textures.insert(t);
+	m_lookup.emplace(key, t);
 
 	t->m_pages.loopPages([this, t](u32 page)
 	{
@@ -58,40 +67,69 @@ GSTextureCacheSW::Texture* GSTextureCacheSW::Lookup(const GIFRegTEX0& TEX0, cons
 	return t;
 }
 
-void GSTextureCacheSW::InvalidatePages(const GSOffset::PageLooper& pages, u32 psm)
+void GSTextureCacheSW::InvalidatePage(u32 page, u32 psm, u32 blocks)
 {
-	pages.loopPages([this, psm](u32 page)
+	for (Texture* t : m_map[page])
 	{
-		for (Texture* t : m_map[page])
+		if (GSUtil::HasSharedBits(psm, t->m_sharedbits))
 		{
-			if (GSUtil::HasSharedBits(psm, t->m_sharedbits))
-			{
-				u32* RESTRICT valid = t->m_valid;
+			u32* RESTRICT valid = t->m_valid;
 
-				if (t->m_repeating)
-				{
-					for (const GSVector2i& j : t->m_p2t[page])
-					{
-						valid[j.x] &= j.y;
-					}
-				}
-				else
+			if (t->m_repeating)
+			{
+				for (const GSVector2i& j : t->m_p2t[page])
 				{
-					valid[page] = 0;
+					valid[j.x] &= j.y;
 				}
-
-				t->m_complete = false;
 			}
+			else
+			{
+				valid[page] &= ~blocks;
+			}
+
+			t->m_complete = false;
 		}
+	}
+}
+
+void GSTextureCacheSW::InvalidatePages(const GSOffset::PageLooper& pages, u32 psm)
+{
+	pages.loopPages([this, psm](u32 page)
+	{
+		InvalidatePage(page, psm, 0xffffffff);
 	});
 }
 
+void GSTextureCacheSW::InvalidateBlocks(const GSOffset& off, const GSVector4i& r)
+{
+	// an upload usually covers a few blocks of a page, keep the rest of the decoded texels
+
+	off.loopBlocks(r, [this](u32 block)
+	{
+		const u32 page = block >> 5;
+
+		if (m_dirty_blocks[page] == 0)
+			m_dirty_pages.push_back(static_cast<u16>(page));
+
+		m_dirty_blocks[page] |= 1u << (block & 31);
+	});
+
+	for (const u16 page : m_dirty_pages)
+	{
+		InvalidatePage(page, off.psm(), m_dirty_blocks[page]);
+		m_dirty_blocks[page] = 0;
+	}
+
+	m_dirty_pages.clear();
+}
+
 void GSTextureCacheSW::RemoveAll()
 {
 	for (auto i : m_textures)
 		delete i;
 
 	m_textures.clear();
+	m_lookup.clear();
 
 	for (auto& l : m_map)
 	{
@@ -108,6 +146,7 @@ void GSTextureCacheSW::IncAge()
 		if (++t->m_age > 10)
 		{
 			i = m_textures.erase(i);
+			m_lookup.erase(t->m_key);
 
 			t->m_pages.loopPages([this, t](u32 page)
 			{
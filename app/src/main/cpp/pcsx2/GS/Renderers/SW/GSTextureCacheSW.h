@@ -5,11 +5,26 @@
 
 #include "GS/Renderers/Common/GSRenderer.h"
 #include "GS/Renderers/Common/GSFastList.h"
+#include <unordered_map>
 #include <unordered_set>
 
 class GSTextureCacheSW
 {
 public:
+	struct TextureKey
+	{
+		u64 TEX0; // TBP0 TBW PSM TW TH
+		u64 TEXA; // only when it affects the decoded texels
+		u32 tw0;
+
+		bool operator==(const TextureKey& k) const { return TEX0 == k.TEX0 && TEXA == k.TEXA && tw0 == k.tw0; }
+	};
+
+	struct TextureKeyHash
+	{
+		size_t operator()(const TextureKey& k) const;
+	};
+
 	class Texture
 	{
 	public:
@@ -17,6 +32,7 @@ public:
 		GSOffset::PageLooper m_pages;
 		GIFRegTEX0 m_TEX0;
 		GIFRegTEXA m_TEXA;
+		TextureKey m_key;
 		void* m_buff;
 		u32 m_tw;
 		u32 m_age;
@@ -28,7 +44,7 @@ public:
 		const u32* RESTRICT m_sharedbits;
 
 		// m_valid
-		// fast mode: each u32 bits map to the 32 blocks of that page
+		// fast mode: each u32 bits map to the 32 blocks of that page, uploads only clear the blocks they wrote
 		// repeating mode: 1 bpp image of the texture tiles (8x8), also having 512 elements is just a coincidence (worst case: (1024*1024)/(8*8)/(sizeof(u32)*8))
 
 		Texture(u32 tw0, const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA);
@@ -42,8 +58,17 @@ public:
 
 protected:
 	std::unordered_set<Texture*> m_textures;
+	std::unordered_map<TextureKey, Texture*, TextureKeyHash> m_lookup;
 	std::array<FastList<Texture*>, MAX_PAGES> m_map;
 
+	// scratch for InvalidateBlocks, always cleared again on return
+	std::array<u32, MAX_PAGES> m_dirty_blocks = {};
+	std::vector<u16> m_dirty_pages;
+
+	static TextureKey GetKey(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, u32 tw0);
+
+	void InvalidatePage(u32 page, u32 psm, u32 blocks);
+
 public:
 	GSTextureCacheSW();
 	virtual ~GSTextureCacheSW();
@@ -51,6 +76,7 @@ public:
 	Texture* Lookup(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, u32 tw0 = 0);
 
 	void InvalidatePages(const GSOffset::PageLooper& pages, u32 psm);
+	void InvalidateBlocks(const GSOffset& off, const GSVector4i& r);
 
 	void RemoveAll();
 	void IncAge();
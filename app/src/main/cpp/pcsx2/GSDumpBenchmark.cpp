@@ -0,0 +1,374 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "Config.h"
+#include "GS/GSPerfMon.h"
+#include "GSDumpBenchmark.h"
+#include "GSDumpReplayer.h"
+#include "Host.h"
+#include "VMManager.h"
+
+#include "common/Console.h"
+#include "common/Error.h"
+#include "common/FileSystem.h"
+#include "common/HostSys.h"
+#include "common/MemorySettingsInterface.h"
+#include "common/Path.h"
+#include "common/Threading.h"
+#include "common/Timer.h"
+
+#include "ryml_std.hpp"
+#include "ryml.hpp"
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace GSDumpBenchmark
+{
+	struct FrameStats
+	{
+		double ms;
+		double counters[GSPerfMon::CounterLast];
+	};
+
+	struct Result
+	{
+		std::string dump;
+		GSRendererType renderer;
+		u32 frames;
+		double total_ms;
+		double mean_ms;
+		double p50_ms;
+		double p95_ms;
+		double p99_ms;
+		double max_ms;
+		double counters[GSPerfMon::CounterLast];
+	};
+
+	static bool RunDump(const std::string& path, GSRendererType renderer, Result* result, std::string* frames_csv, Error* error);
+	static void WriteResults(const Options& options, const std::vector<Result>& results, const std::string& frames_csv);
+	static bool CompareWithBaseline(const Options& options, const std::vector<Result>& results, Error* error);
+	static std::string EscapeJSON(std::string_view str);
+
+	static constexpr GSRendererType s_renderers[] = {GSRendererType::SW, GSRendererType::Null};
+
+	static constexpr const char* s_counter_names[] = {
+		"prims",
+		"draws",
+		"draw_calls",
+		"readbacks",
+		"swizzle",
+		"unswizzle",
+		"fillrate",
+		"sync_points",
+		"barriers",
+		"render_passes",
+		"texture_lookups",
+		"texture_hits",
+		"clut_expands",
+		"clut_hits",
+	};
+	static_assert(std::size(s_counter_names) == GSPerfMon::CounterLast);
+
+	// Written by the GS thread, only read once the VM has shut down.
+	static std::mutex s_frames_mutex;
+	static std::vector<FrameStats> s_frames;
+	static u64 s_last_frame_ticks = 0;
+	static double s_last_totals[GSPerfMon::CounterLast] = {};
+
+	// Renderer override for the runs, layered on top so the user's settings are never touched.
+	static MemorySettingsInterface s_override_settings;
+} // namespace GSDumpBenchmark
+
+void GSDumpBenchmark::RecordFrame()
+{
+	const u64 now = GetCPUTicks();
+
+	std::unique_lock lock(s_frames_mutex);
+
+	FrameStats frame;
+	frame.ms = static_cast<double>(now - s_last_frame_ticks) * 1000.0 / static_cast<double>(GetTickFrequency());
+	for (u32 i = 0; i < GSPerfMon::CounterLast; i++)
+	{
+		const double total = g_perfmon.GetTotal(static_cast<GSPerfMon::counter_t>(i));
+		frame.counters[i] = std::max(total - s_last_totals[i], 0.0);
+		s_last_totals[i] = total;
+	}
+
+	// the first vsync only marks the start, it would include loading the state
+	if (s_last_frame_ticks != 0)
+		s_frames.push_back(frame);
+
+	s_last_frame_ticks = now;
+}
+
+bool GSDumpBenchmark::RunDump(const std::string& path, GSRendererType renderer, Result* result, std::string* frames_csv, Error* error)
+{
+	{
+		std::unique_lock lock(s_frames_mutex);
+		s_frames.clear();
+		s_last_frame_ticks = 0;
+		std::fill(std::begin(s_last_totals), std::end(s_last_totals), 0.0);
+	}
+
+	{
+		auto lock = Host::GetSettingsLock();
+		s_override_settings.SetIntValue("EmuCore/GS", "Renderer", static_cast<int>(renderer));
+	}
+	VMManager::ApplySettings();
+
+	VMBootParameters boot_params;
+	boot_params.filename = path;
+	if (!VMManager::Initialize(boot_params))
+	{
+		Error::SetString(error, fmt::format("Failed to start '{}'", Path::GetFileName(path)));
+		return false;
+	}
+
+	// play through once, then shut down
+	GSDumpReplayer::SetLoopCount(1);
+	VMManager::SetState(VMState::Running);
+	for (;;)
+	{
+		const VMState state = VMManager::GetState();
+		if (state == VMState::Stopping || state == VMState::Shutdown)
+			break;
+		else if (state == VMState::Running)
+			VMManager::Execute();
+		else
+			Threading::Sleep(1);
+	}
+	VMManager::Shutdown(false);
+
+	std::unique_lock lock(s_frames_mutex);
+	if (s_frames.empty())
+	{
+		Error::SetString(error, fmt::format("'{}' did not render any frames", Path::GetFileName(path)));
+		return false;
+	}
+
+	std::vector<double> times;
+	times.reserve(s_frames.size());
+	*result = {};
+	result->dump = Path::GetFileName(path);
+	result->renderer = renderer;
+	result->frames = static_cast<u32>(s_frames.size());
+	const char* renderer_name = Pcsx2Config::GSOptions::GetRendererName(renderer);
+	for (size_t i = 0; i < s_frames.size(); i++)
+	{
+		const FrameStats& frame = s_frames[i];
+		fmt::format_to(std::back_inserter(*frames_csv), "\"{}\",{},{},{:.4f}", result->dump, renderer_name, i, frame.ms);
+		for (u32 c = 0; c < GSPerfMon::CounterLast; c++)
+			fmt::format_to(std::back_inserter(*frames_csv), ",{:.0f}", frame.counters[c]);
+		*frames_csv += '\n';
+
+		times.push_back(frame.ms);
+		result->total_ms += frame.ms;
+		for (u32 c = 0; c < GSPerfMon::CounterLast; c++)
+			result->counters[c] += frame.counters[c];
+	}
+
+	std::sort(times.begin(), times.end());
+	const auto percentile = [&times](double p) {
+		return times[std::min(static_cast<size_t>(p * static_cast<double>(times.size())), times.size() - 1)];
+	};
+	result->mean_ms = result->total_ms / static_cast<double>(result->frames);
+	result->p50_ms = percentile(0.50);
+	result->p95_ms = percentile(0.95);
+	result->p99_ms = percentile(0.99);
+	result->max_ms = times.back();
+
+	Console.WriteLnFmt("(GSDumpBenchmark) {} [{}]: {} frames, {:.3f} ms mean, {:.3f} ms p95, {:.1f} FPS",
+		result->dump, renderer_name, result->frames, result->mean_ms,
+		result->p95_ms, 1000.0 / result->mean_ms);
+	return true;
+}
+
+bool GSDumpBenchmark::Run(const Options& options, Error* error)
+{
+	FileSystem::FindResultsArray files;
+	FileSystem::FindFiles(options.dump_directory.c_str(), "*", FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_SORT_BY_NAME, &files);
+
+	std::vector<std::string> dumps;
+	for (const FILESYSTEM_FIND_DATA& fd : files)
+	{
+		if (VMManager::IsGSDumpFileName(fd.FileName))
+			dumps.push_back(fd.FileName);
+	}
+	if (dumps.empty())
+	{
+		Error::SetString(error, fmt::format("No GS dumps found in '{}'", options.dump_directory));
+		return false;
+	}
+
+	if (!FileSystem::EnsureDirectoryExists(options.output_directory.c_str(), true, error))
+		return false;
+
+	{
+		auto lock = Host::GetSettingsLock();
+		s_override_settings.Clear();
+		Host::Internal::SetCommandLineSettingsLayer(&s_override_settings, lock);
+	}
+
+	Common::Timer timer;
+	GSDumpReplayer::SetIsDumpRunner(true);
+
+	std::vector<Result> results;
+	std::string frames_csv = "dump,renderer,frame,ms";
+	for (const char* name : s_counter_names)
+		fmt::format_to(std::back_inserter(frames_csv), ",{}", name);
+	frames_csv += '\n';
+
+	bool okay = true;
+	for (const std::string& dump : dumps)
+	{
+		for (const GSRendererType renderer : s_renderers)
+		{
+			Result result;
+			Error dump_error;
+			if (RunDump(dump, renderer, &result, &frames_csv, &dump_error))
+			{
+				results.push_back(std::move(result));
+			}
+			else
+			{
+				Console.ErrorFmt("(GSDumpBenchmark) {}", dump_error.GetDescription());
+				okay = false;
+			}
+		}
+	}
+
+	GSDumpReplayer::SetIsDumpRunner(false);
+	{
+		auto lock = Host::GetSettingsLock();
+		Host::Internal::SetCommandLineSettingsLayer(nullptr, lock);
+		s_override_settings.Clear();
+	}
+	VMManager::ApplySettings();
+
+	Console.WriteLnFmt("(GSDumpBenchmark) Ran {} dumps in {:.2f} seconds.", dumps.size(), timer.GetTimeSeconds());
+
+	WriteResults(options, results, frames_csv);
+
+	if (!options.baseline_path.empty() && !CompareWithBaseline(options, results, error))
+		return false;
+
+	if (!okay)
+		Error::SetString(error, "Some dumps failed to run, check the log.");
+
+	return okay;
+}
+
+std::string GSDumpBenchmark::EscapeJSON(std::string_view str)
+{
+	std::string ret;
+	ret.reserve(str.size());
+	for (const char ch : str)
+	{
+		if (ch == '"' || ch == '\\')
+			ret.push_back('\\');
+		ret.push_back(ch);
+	}
+	return ret;
+}
+
+void GSDumpBenchmark::WriteResults(const Options& options, const std::vector<Result>& results, const std::string& frames_csv)
+{
+	std::string json;
+	std::string summary_csv = "dump,renderer,frames,total_ms,mean_ms,p50_ms,p95_ms,p99_ms,max_ms";
+	for (const char* name : s_counter_names)
+		fmt::format_to(std::back_inserter(summary_csv), ",{}", name);
+	summary_csv += '\n';
+
+	fmt::format_to(std::back_inserter(json), "{{\n\t\"threshold_percent\": {},\n\t\"results\": [\n", options.threshold_percent);
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		const Result& r = results[i];
+		const char* renderer = Pcsx2Config::GSOptions::GetRendererName(r.renderer);
+		fmt::format_to(std::back_inserter(json),
+			"\t\t{{\"dump\": \"{}\", \"renderer\": \"{}\", \"frames\": {}, \"total_ms\": {:.3f}, \"mean_ms\": {:.4f}, "
+			"\"p50_ms\": {:.4f}, \"p95_ms\": {:.4f}, \"p99_ms\": {:.4f}, \"max_ms\": {:.4f}",
+			EscapeJSON(r.dump), renderer, r.frames, r.total_ms, r.mean_ms, r.p50_ms, r.p95_ms, r.p99_ms, r.max_ms);
+		fmt::format_to(std::back_inserter(summary_csv), "\"{}\",{},{},{:.3f},{:.4f},{:.4f},{:.4f},{:.4f},{:.4f}",
+			r.dump, renderer, r.frames, r.total_ms, r.mean_ms, r.p50_ms, r.p95_ms, r.p99_ms, r.max_ms);
+		for (u32 c = 0; c < GSPerfMon::CounterLast; c++)
+		{
+			fmt::format_to(std::back_inserter(json), ", \"{}\": {:.0f}", s_counter_names[c], r.counters[c]);
+			fmt::format_to(std::back_inserter(summary_csv), ",{:.0f}", r.counters[c]);
+		}
+		json += (i + 1 < results.size()) ? "},\n" : "}\n";
+		summary_csv += '\n';
+	}
+	json += "\t]\n}\n";
+
+	const std::string json_path = Path::Combine(options.output_directory, "gsbench_summary.json");
+	const std::string summary_path = Path::Combine(options.output_directory, "gsbench_summary.csv");
+	const std::string frames_path = Path::Combine(options.output_directory, "gsbench_frames.csv");
+	if (!FileSystem::WriteStringToFile(json_path.c_str(), json) ||
+		!FileSystem::WriteStringToFile(summary_path.c_str(), summary_csv) ||
+		!FileSystem::WriteStringToFile(frames_path.c_str(), frames_csv))
+	{
+		Console.ErrorFmt("(GSDumpBenchmark) Failed to write results to '{}'", options.output_directory);
+	}
+}
+
+bool GSDumpBenchmark::CompareWithBaseline(const Options& options, const std::vector<Result>& results, Error* error)
+{
+	const std::optional<std::string> buf = FileSystem::ReadFileToString(options.baseline_path.c_str());
+	if (!buf.has_value())
+	{
+		Error::SetString(error, fmt::format("Failed to read baseline '{}'", options.baseline_path));
+		return false;
+	}
+
+	const ryml::Tree tree = ryml::parse_in_arena(c4::to_csubstr(buf.value()));
+	const ryml::ConstNodeRef root = tree.rootref();
+	if (!root.is_map() || !root.has_child("results"))
+	{
+		Error::SetString(error, fmt::format("'{}' is not a benchmark summary", options.baseline_path));
+		return false;
+	}
+
+	u32 regressions = 0;
+	for (const Result& r : results)
+	{
+		const char* renderer = Pcsx2Config::GSOptions::GetRendererName(r.renderer);
+		for (const ryml::ConstNodeRef& n : root["results"].children())
+		{
+			if (!n.has_child("dump") || !n.has_child("renderer") || !n.has_child("mean_ms") ||
+				n["dump"].val() != c4::to_csubstr(r.dump) || n["renderer"].val() != c4::to_csubstr(renderer))
+			{
+				continue;
+			}
+
+			double base_ms = 0.0;
+			n["mean_ms"] >> base_ms;
+			if (base_ms <= 0.0)
+				break;
+
+			const double change = (r.mean_ms - base_ms) * 100.0 / base_ms;
+			if (change > options.threshold_percent)
+			{
+				Console.ErrorFmt("(GSDumpBenchmark) {} [{}]: {:.4f} ms vs {:.4f} ms baseline, {:+.1f}% slower",
+					r.dump, renderer, r.mean_ms, base_ms, change);
+				regressions++;
+			}
+			else
+			{
+				Console.WriteLnFmt("(GSDumpBenchmark) {} [{}]: {:.4f} ms vs {:.4f} ms baseline, {:+.1f}%",
+					r.dump, renderer, r.mean_ms, base_ms, change);
+			}
+			break;
+		}
+	}
+
+	if (regressions > 0)
+	{
+		Error::SetString(error, fmt::format("{} results regressed by more than {}%", regressions, options.threshold_percent));
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,30 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include <string>
+
+class Error;
+
+namespace GSDumpBenchmark
+{
+	struct Options
+	{
+		std::string dump_directory;
+		std::string output_directory;
+
+		/// Summary JSON from an earlier run. Results whose mean frame time got slower by more than
+		/// threshold_percent are reported as regressions.
+		std::string baseline_path;
+		float threshold_percent = 5.0f;
+	};
+
+	/// Replays every dump in the directory once through the SW and Null renderers without frame limiting,
+	/// and writes per-frame timings and GS counters to the output directory. Must be called on the CPU
+	/// thread after VMManager::Internal::CPUThreadInitialize(). Returns false on failure or regression.
+	bool Run(const Options& options, Error* error);
+
+	/// Called on the GS thread at every vsync while the dump runner is active.
+	void RecordFrame();
+} // namespace GSDumpBenchmark
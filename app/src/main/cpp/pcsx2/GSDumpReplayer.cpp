@@ -27,6 +27,8 @@
 
 #include <atomic>
 
+static constexpr u32 NO_SEEK_FRAME = 0xFFFFFFFFu;
+
 static void GSDumpReplayerCpuReserve();
 static void GSDumpReplayerCpuShutdown();
 static void GSDumpReplayerCpuReset();
@@ -45,6 +47,8 @@ static bool s_needs_state_loaded = false;
 static u64 s_frame_ticks = 0;
 static u64 s_next_frame_time = 0;
 static bool s_is_dump_runner = false;
+static std::atomic<u32> s_seek_frame{NO_SEEK_FRAME};
+static u32 s_fast_forward_frame = 0;
 
 R5900cpu GSDumpReplayerCpu = {
 	GSDumpReplayerCpuReserve,
@@ -182,6 +186,16 @@ u32 GSDumpReplayer::GetFrameNumber()
 	return s_dump_frame_number;
 }
 
+u32 GSDumpReplayer::GetFrameCount()
+{
+	return s_dump_file->GetFrameCount();
+}
+
+void GSDumpReplayer::SeekToFrame(u32 frame)
+{
+	s_seek_frame.store(frame, std::memory_order_release);
+}
+
 void GSDumpReplayerCpuReserve()
 {
 }
@@ -195,23 +209,103 @@ void GSDumpReplayerCpuReset()
 	s_needs_state_loaded = true;
 	s_current_packet = 0;
 	s_dump_frame_number = 0;
+	s_fast_forward_frame = 0;
 }
 
-static void GSDumpReplayerLoadInitialState()
+static void GSDumpReplayerLoadState(const GSDumpFile::ByteArray& state, const GSDumpFile::ByteArray& regs)
 {
 	// reset GS registers to initial dump values
-	std::memcpy(PS2MEM_GS, s_dump_file->GetRegsData().data(),
-		std::min(Ps2MemSize::GSregs, static_cast<u32>(s_dump_file->GetRegsData().size())));
+	std::memcpy(PS2MEM_GS, regs.data(), std::min(Ps2MemSize::GSregs, static_cast<u32>(regs.size())));
 
 	// load GS state
-	freezeData fd = {static_cast<int>(s_dump_file->GetStateData().size()),
-		const_cast<u8*>(s_dump_file->GetStateData().data())};
+	freezeData fd = {static_cast<int>(state.size()), const_cast<u8*>(state.data())};
 	MTGS::FreezeData mfd = {&fd, 0};
 	MTGS::Freeze(FreezeAction::Load, mfd);
 	if (mfd.retval != 0)
 		Host::ReportFormattedErrorAsync("GSDumpReplayer", "Failed to load GS state.");
 }
 
+static bool GSDumpReplayerLoadInitialState()
+{
+	Error error;
+	if (!s_dump_file->Rewind(&error))
+	{
+		// the packet list is no longer usable, so the dump can't go on
+		Host::ReportErrorAsync("GSDumpReplayer", fmt::format("Failed to rewind dump: {}", error.GetDescription()));
+		Host::RequestVMShutdown(false, false, false);
+		GSDumpReplayerExitExecution();
+		return false;
+	}
+
+	GSDumpReplayerLoadState(s_dump_file->GetStateData(), s_dump_file->GetRegsData());
+	return true;
+}
+
+static bool GSDumpReplayerSeek(u32 frame)
+{
+	if (s_dump_file->IsChunked())
+	{
+		GSDumpFile::ByteArray state, regs;
+		u32 keyframe;
+		Error error;
+		if (!s_dump_file->SeekToFrame(frame, &state, &regs, &keyframe, &error))
+		{
+			Host::ReportErrorAsync("GSDumpReplayer", fmt::format("Failed to seek to frame {}: {}", frame, error.GetDescription()));
+			return true;
+		}
+
+		GSDumpReplayerLoadState(state, regs);
+		s_current_packet = 0;
+		s_dump_frame_number = keyframe;
+	}
+	else if (frame < s_dump_frame_number)
+	{
+		// no keyframes, have to go through everything before it again
+		if (!GSDumpReplayerLoadInitialState())
+			return false;
+		s_current_packet = 0;
+		s_dump_frame_number = 0;
+	}
+
+	s_needs_state_loaded = false;
+	s_fast_forward_frame = frame;
+	Console.WriteLn("(GSDumpReplayer) Seeking to frame %u, replaying from frame %u.", frame, s_dump_frame_number);
+	return true;
+}
+
+static void GSDumpReplayerNextPacket()
+{
+	if (++s_current_packet < static_cast<u32>(s_dump_file->GetPackets().size()))
+		return;
+
+	s_current_packet = 0;
+
+	// chunked dumps only have part of the packets loaded, move on to the next chunk
+	if (s_dump_file->IsChunked())
+	{
+		Error error;
+		if (s_dump_file->NextChunk(&error))
+			return;
+
+		if (!s_dump_file->Rewind(&error))
+		{
+			Host::ReportErrorAsync("GSDumpReplayer", fmt::format("Failed to rewind dump: {}", error.GetDescription()));
+			Host::RequestVMShutdown(false, false, false);
+			s_dump_running = false;
+			return;
+		}
+	}
+
+	s_dump_frame_number = 0;
+	if (s_dump_loop_count > 0)
+		s_dump_loop_count--;
+	else if (s_dump_loop_count == 0)
+	{
+		Host::RequestVMShutdown(false, false, false);
+		s_dump_running = false;
+	}
+}
+
 static void GSDumpReplayerSendPacketToMTGS(GIF_PATH path, const u8* data, u32 length)
 {
 	pxAssert((length % 16) == 0);
@@ -257,24 +351,20 @@ void GSDumpReplayerCpuStep()
 {
 	if (s_needs_state_loaded)
 	{
-		GSDumpReplayerLoadInitialState();
+		if (!GSDumpReplayerLoadInitialState())
+			return;
 		s_needs_state_loaded = false;
 	}
 
-	const GSDumpFile::GSData& packet = s_dump_file->GetPackets()[s_current_packet];
-	s_current_packet = (s_current_packet + 1) % static_cast<u32>(s_dump_file->GetPackets().size());
-	if (s_current_packet == 0)
+	if (const u32 seek_frame = s_seek_frame.exchange(NO_SEEK_FRAME, std::memory_order_acq_rel); seek_frame != NO_SEEK_FRAME)
 	{
-		s_dump_frame_number = 0;
-		if (s_dump_loop_count > 0)
-			s_dump_loop_count--;
-		else if (s_dump_loop_count == 0)
-		{
-			Host::RequestVMShutdown(false, false, false);
-			s_dump_running = false;
-		}
+		if (!GSDumpReplayerSeek(seek_frame))
+			return;
 	}
 
+	// packet data belongs to the current chunk, so only move on once we're done with it
+	const GSDumpFile::GSData& packet = s_dump_file->GetPackets()[s_current_packet];
+
 	switch (packet.id)
 	{
 		case GSDumpTypes::GSType::Transfer:
@@ -308,8 +398,17 @@ void GSDumpReplayerCpuStep()
 		case GSDumpTypes::GSType::VSync:
 		{
 			s_dump_frame_number++;
-			GSDumpReplayerUpdateFrameLimit();
-			GSDumpReplayerFrameLimit();
+			if (!s_is_dump_runner && s_dump_frame_number >= s_fast_forward_frame)
+			{
+				if (s_fast_forward_frame != 0)
+				{
+					s_next_frame_time = GetCPUTicks();
+					s_fast_forward_frame = 0;
+				}
+
+				GSDumpReplayerUpdateFrameLimit();
+				GSDumpReplayerFrameLimit();
+			}
 			MTGS::PostVsyncStart(false);
 			VMManager::Internal::VSyncOnCPUThread();
 			if (VMManager::Internal::IsExecutionInterrupted())
@@ -335,6 +434,8 @@ void GSDumpReplayerCpuStep()
 		}
 		break;
 	}
+
+	GSDumpReplayerNextPacket();
 }
 
 void GSDumpReplayerCpuExecute()
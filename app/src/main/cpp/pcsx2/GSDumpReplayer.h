@@ -25,5 +25,12 @@ namespace GSDumpReplayer
 
 	u32 GetFrameNumber();
 
+	/// Number of frames in the dump, or 0 if the format doesn't record it.
+	u32 GetFrameCount();
+
+	/// Jumps to the given frame. Chunked dumps restore the nearest keyframe, others replay from the start.
+	/// Frames between the restore point and the target are run without frame limiting.
+	void SeekToFrame(u32 frame);
+
 	void RenderUI();
 } // namespace GSDumpReplayer
@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "CDVD/CDVD.h"
+#include "CDVD/IsoFileFormats.h"
+#include "CDVD/IsoReader.h"
 #include "Elfheader.h"
 #include "GameList.h"
 #include "Host.h"
@@ -17,19 +19,29 @@
 #include "common/Path.h"
 #include "common/ProgressCallback.h"
 #include "common/StringUtil.h"
+#include "common/Timer.h"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
+#include <condition_variable>
 #include <cstdio>
+#include <cstring>
 #include <ctime>
 #include <fstream>
 #include <mutex>
 #include <string_view>
+#include <thread>
 #include <utility>
 
 #ifdef _WIN32
 #include "common/RedtapeWindows.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 namespace GameList
@@ -37,13 +49,22 @@ namespace GameList
 	enum : u32
 	{
 		GAME_LIST_CACHE_SIGNATURE = 0x45434C47,
-		GAME_LIST_CACHE_VERSION = 34,
+		GAME_LIST_CACHE_VERSION = 35,
+
+		// The cache is rewritten with everything in the index once the unindexed tail, plus the
+		// records of games which are gone after a scan, gets past this many entries, or past
+		// 1/CACHE_COMPACT_TAIL_RATIO of the indexed ones.
+		CACHE_COMPACT_MIN_TAIL_ENTRIES = 32,
+		CACHE_COMPACT_TAIL_RATIO = 8,
 
 
 		PLAYED_TIME_SERIAL_LENGTH = 32,
 		PLAYED_TIME_LAST_TIME_LENGTH = 20, // uint64
 		PLAYED_TIME_TOTAL_TIME_LENGTH = 20, // uint64
 		PLAYED_TIME_LINE_LENGTH = PLAYED_TIME_SERIAL_LENGTH + 1 + PLAYED_TIME_LAST_TIME_LENGTH + 1 + PLAYED_TIME_TOTAL_TIME_LENGTH,
+
+		// Scanning is mostly waiting on storage, more threads than this just fight over it.
+		MAX_AUTO_SCAN_THREADS = 4,
 	};
 
 	struct PlayedTimeEntry
@@ -52,7 +73,30 @@ namespace GameList
 		std::time_t total_played_time;
 	};
 
-	using CacheMap = UnorderedStringMap<Entry>;
+	/// Start of the cache file. Compacted records follow it, then the index, then anything appended since.
+	struct CacheFileHeader
+	{
+		u32 signature;
+		u32 version;
+		u64 index_offset;
+		u32 bucket_count;
+		u32 indexed_entries;
+		u64 tail_offset;
+	};
+	static_assert(sizeof(CacheFileHeader) == 32);
+
+	/// Open addressed by path hash, record_offset of 0 marks an empty bucket.
+	struct CacheIndexSlot
+	{
+		u64 path_hash;
+		u64 record_offset;
+		s64 last_modified_time;
+		u64 file_size;
+	};
+	static_assert(sizeof(CacheIndexSlot) == 32);
+
+	/// Offsets of records appended after the index, by path
+	using CacheTailMap = UnorderedStringMap<u64>;
 	using PlayedTimeMap = UnorderedStringMap<PlayedTimeEntry>;
 
 	static bool IsScannableFilename(const std::string_view path);
@@ -62,20 +106,30 @@ namespace GameList
 	static bool GetElfListEntry(const std::string& path, GameList::Entry* entry);
 	static bool GetIsoListEntry(const std::string& path, GameList::Entry* entry);
 
-	static bool GetGameListEntryFromCache(const std::string& path, GameList::Entry* entry);
+	static bool GetGameListEntryFromCache(const std::string& path, std::time_t timestamp, u64 file_size, GameList::Entry* entry);
 	static void ScanDirectory(const char* path, bool recursive, bool only_cache, const std::vector<std::string>& excluded_paths,
 		const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini, ProgressCallback* progress);
-	static bool AddFileFromCache(const std::string& path, std::time_t timestamp, const PlayedTimeMap& played_time_map);
-	static bool ScanFile(std::string path, std::time_t timestamp, std::unique_lock<std::recursive_mutex>& lock,
+	static bool AddFileFromCache(const std::string& path, std::time_t timestamp, u64 file_size, const PlayedTimeMap& played_time_map);
+	static bool ScanFile(std::string path, std::time_t timestamp, u64 file_size, std::unique_lock<std::recursive_mutex>& lock,
 		const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini);
+	static void AddScannedEntry(Entry entry, u64 file_size, const PlayedTimeMap& played_time_map,
+		const INISettingsInterface& custom_attributes_ini);
+	static u32 GetScanThreadCount(size_t num_files);
+	static void ScanFilesParallel(std::vector<FILESYSTEM_FIND_DATA*>& files, u32 num_threads, u32 base_progress,
+		const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini, ProgressCallback* progress);
 
 	static void LoadCache();
-	static bool LoadEntriesFromCache(std::FILE* stream);
+	static bool MapCacheFile(const char* filename);
+	static void UnmapCacheFile();
+	static bool LoadEntriesFromCache();
+	static bool ReadCacheRecord(u64 offset, Entry* entry, u64* file_size, u64* next_offset);
+	static bool ReadCacheRecordPath(u64 offset, std::string_view* path, u64* next_offset);
+	static u64 FindCacheRecord(const std::string& path, std::time_t timestamp, u64 file_size);
 	static bool OpenCacheForWriting();
-	static bool WriteEntryToCache(const GameList::Entry* entry);
+	static bool WriteEntryToCache(const GameList::Entry* entry, u64 file_size);
 	static void CloseCacheFileStream();
 	static void DeleteCacheFile();
-	static void RewriteCacheFile();
+	static void CompactCacheFileIfNeeded(bool drop_unlisted);
 
 	static std::string GetPlayedTimeFile();
 	static bool ParsePlayedTimeLine(char* line, std::string& serial, PlayedTimeEntry& entry);
@@ -89,9 +143,17 @@ namespace GameList
 
 static std::vector<GameList::Entry> s_entries;
 static std::recursive_mutex s_mutex;
-static GameList::CacheMap s_cache_map;
 static std::FILE* s_cache_write_stream = nullptr;
 
+// Read-only view of the cache file while scanning, entries are only parsed when looked up.
+static const u8* s_cache_data = nullptr;
+static size_t s_cache_size = 0;
+static GameList::CacheFileHeader s_cache_header = {};
+static GameList::CacheTailMap s_cache_tail;
+#ifdef _WIN32
+static std::vector<u8> s_cache_buffer;
+#endif
+
 const char* GameList::EntryTypeToString(EntryType type, bool translate)
 {
 	static constexpr std::array<const char*, static_cast<int>(EntryType::Count)> names = {
@@ -215,34 +277,20 @@ void GameList::FillBootParametersForEntry(VMBootParameters* params, const Entry*
 
 bool GameList::GetIsoSerialAndCRC(const std::string& path, s32* disc_type, std::string* serial, u32* crc)
 {
-	// Add a static mutex to protect CDVD operations during scanning
-	static std::mutex cdvd_scan_mutex;
-	std::lock_guard<std::mutex> lock(cdvd_scan_mutex);
-	
+	// Goes through its own image instead of the global CDVD source, so several files can be scanned at once.
 	Error error;
-
-	// Save the current CDVD state to restore it later (thread safety)
-	const CDVD_API* prev_cdvd = CDVD;
-	
-	// This isn't great, we really want to make it all thread-local...
-	CDVD = &CDVDapi_Iso;
-	if (!CDVD->open(path, &error))
+	InputIsoFile iso;
+	if (!iso.Open(path, &error))
 	{
-		Console.Error(fmt::format("(GameList::GetIsoSerialAndCRC) CDVD open of '{}' failed: {}", path, error.GetDescription()));
-		// Restore previous CDVD state
-		CDVD = prev_cdvd;
+		Console.Error(fmt::format("(GameList::GetIsoSerialAndCRC) Open of '{}' failed: {}", path, error.GetDescription()));
 		return false;
 	}
 
+	IsoReader isor(&iso);
+	*disc_type = DoCDVDdetectIsoDiskType(iso, isor);
+
 	// TODO: we could include the version in the game list?
-	*disc_type = DoCDVDdetectDiskType();
-	
-	cdvdGetDiscInfo(serial, nullptr, nullptr, crc, nullptr);
-	
-	DoCDVDclose();
-	
-	// Restore previous CDVD state
-	CDVD = prev_cdvd;
+	cdvdGetDiscInfo(isor, serial, nullptr, nullptr, crc, nullptr);
 	return true;
 }
 
@@ -419,110 +467,248 @@ bool GameList::PopulateEntryFromPath(const std::string& path, GameList::Entry* e
 		return GetIsoListEntry(path, entry);
 }
 
-bool GameList::GetGameListEntryFromCache(const std::string& path, GameList::Entry* entry)
+static u64 HashCachePath(const std::string_view path)
 {
-	auto iter = s_cache_map.find(path);
-	if (iter == s_cache_map.end())
-		return false;
-
-	*entry = std::move(iter->second);
-	s_cache_map.erase(iter);
-	return true;
+	// FNV-1a, it ends up in the file so it has to stay the same between builds.
+	u64 hash = 0xCBF29CE484222325ULL;
+	for (const char ch : path)
+		hash = (hash ^ static_cast<u8>(ch)) * 0x100000001B3ULL;
+	return hash;
 }
 
-static bool ReadString(std::FILE* stream, std::string* dest)
+namespace
 {
-	u32 size;
-	if (std::fread(&size, sizeof(size), 1, stream) != 1)
-		return false;
+	/// Bounds-checked reads from the mapped cache file.
+	struct CacheReader
+	{
+		const u8* ptr;
+		const u8* end;
 
-	dest->resize(size);
-	if (size > 0 && std::fread(dest->data(), size, 1, stream) != 1)
-		return false;
+		template <typename T>
+		bool Read(T* dest)
+		{
+			if (static_cast<size_t>(end - ptr) < sizeof(T))
+				return false;
 
-	return true;
+			std::memcpy(dest, ptr, sizeof(T));
+			ptr += sizeof(T);
+			return true;
+		}
+
+		bool ReadString(std::string_view* dest)
+		{
+			u32 size;
+			if (!Read(&size) || static_cast<size_t>(end - ptr) < size)
+				return false;
+
+			*dest = std::string_view(reinterpret_cast<const char*>(ptr), size);
+			ptr += size;
+			return true;
+		}
+	};
+} // namespace
+
+template <typename T>
+static void AppendValue(std::vector<u8>& buffer, T value)
+{
+	const size_t pos = buffer.size();
+	buffer.resize(pos + sizeof(T));
+	std::memcpy(&buffer[pos], &value, sizeof(T));
 }
 
-static bool ReadU8(std::FILE* stream, u8* dest)
+static void AppendString(std::vector<u8>& buffer, const std::string_view str)
 {
-	return std::fread(dest, sizeof(u8), 1, stream) > 0;
+	AppendValue(buffer, static_cast<u32>(str.size()));
+	buffer.insert(buffer.end(), str.begin(), str.end());
 }
 
-static bool ReadU32(std::FILE* stream, u32* dest)
+bool GameList::MapCacheFile(const char* filename)
 {
-	return std::fread(dest, sizeof(u32), 1, stream) > 0;
+	UnmapCacheFile();
+
+#ifdef _WIN32
+	std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(filename);
+	if (!data.has_value() || data->empty())
+		return false;
+
+	s_cache_buffer = std::move(data.value());
+	s_cache_data = s_cache_buffer.data();
+	s_cache_size = s_cache_buffer.size();
+#else
+	const int fd = open(filename, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return false;
+
+	struct stat st;
+	void* data = MAP_FAILED;
+	if (fstat(fd, &st) == 0 && st.st_size > 0)
+		data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+		return false;
+
+	s_cache_data = static_cast<const u8*>(data);
+	s_cache_size = static_cast<size_t>(st.st_size);
+#endif
+
+	return true;
 }
 
-static bool ReadU64(std::FILE* stream, u64* dest)
+void GameList::UnmapCacheFile()
 {
-	return std::fread(dest, sizeof(u64), 1, stream) > 0;
+#ifdef _WIN32
+	s_cache_buffer = {};
+#else
+	if (s_cache_data)
+		munmap(const_cast<u8*>(s_cache_data), s_cache_size);
+#endif
+
+	s_cache_data = nullptr;
+	s_cache_size = 0;
+	s_cache_header = {};
+	s_cache_tail.clear();
 }
 
-static bool WriteString(std::FILE* stream, const std::string& str)
+bool GameList::ReadCacheRecord(u64 offset, Entry* entry, u64* file_size, u64* next_offset)
 {
-	const u32 size = static_cast<u32>(str.size());
-	return (std::fwrite(&size, sizeof(size), 1, stream) > 0 && (size == 0 || std::fwrite(str.data(), size, 1, stream) > 0));
+	u32 record_size;
+	CacheReader reader{s_cache_data + offset, s_cache_data + s_cache_size};
+	if (offset >= s_cache_size || !reader.Read(&record_size) || static_cast<size_t>(reader.end - reader.ptr) < record_size)
+		return false;
+
+	reader.end = reader.ptr + record_size;
+	if (next_offset)
+		*next_offset = offset + sizeof(record_size) + record_size;
+
+	std::string_view path, serial, title, title_sort, title_en;
+	u8 type;
+	u8 region;
+	u8 compatibility_rating;
+	u64 last_modified_time;
+
+	if (!reader.ReadString(&path) || !reader.ReadString(&serial) || !reader.ReadString(&title) || !reader.ReadString(&title_sort) ||
+		!reader.ReadString(&title_en) || !reader.Read(&type) || !reader.Read(&region) || !reader.Read(&entry->total_size) ||
+		!reader.Read(&last_modified_time) || !reader.Read(file_size) || !reader.Read(&entry->crc) || !reader.Read(&compatibility_rating) ||
+		region >= static_cast<u8>(Region::Count) || type >= static_cast<u8>(EntryType::Count) ||
+		compatibility_rating > static_cast<u8>(CompatibilityRating::Perfect))
+	{
+		return false;
+	}
+
+	entry->path = path;
+	entry->serial = serial;
+	entry->title = title;
+	entry->title_sort = title_sort;
+	entry->title_en = title_en;
+	entry->region = static_cast<Region>(region);
+	entry->type = static_cast<EntryType>(type);
+	entry->compatibility_rating = static_cast<CompatibilityRating>(compatibility_rating);
+	entry->last_modified_time = static_cast<std::time_t>(last_modified_time);
+	return true;
 }
 
-static bool WriteU8(std::FILE* stream, u8 dest)
+bool GameList::ReadCacheRecordPath(u64 offset, std::string_view* path, u64* next_offset)
 {
-	return std::fwrite(&dest, sizeof(u8), 1, stream) > 0;
+	u32 record_size;
+	CacheReader reader{s_cache_data + offset, s_cache_data + s_cache_size};
+	if (offset >= s_cache_size || !reader.Read(&record_size) || static_cast<size_t>(reader.end - reader.ptr) < record_size)
+		return false;
+
+	reader.end = reader.ptr + record_size;
+	*next_offset = offset + sizeof(record_size) + record_size;
+	return reader.ReadString(path);
 }
 
-static bool WriteU32(std::FILE* stream, u32 dest)
+u64 GameList::FindCacheRecord(const std::string& path, std::time_t timestamp, u64 file_size)
 {
-	return std::fwrite(&dest, sizeof(u32), 1, stream) > 0;
+	// Anything appended since the last compaction replaces what's in the index.
+	if (auto iter = s_cache_tail.find(path); iter != s_cache_tail.end())
+		return iter->second;
+
+	const u32 bucket_count = s_cache_header.bucket_count;
+	if (bucket_count == 0)
+		return 0;
+
+	const u64 hash = HashCachePath(path);
+	const u8* buckets = s_cache_data + s_cache_header.index_offset;
+	for (u32 i = 0; i < bucket_count; i++)
+	{
+		CacheIndexSlot slot;
+		std::memcpy(&slot, buckets + static_cast<size_t>((hash + i) & (bucket_count - 1)) * sizeof(slot), sizeof(slot));
+		if (slot.record_offset == 0)
+			break;
+
+		// The fingerprint lets us skip changed files without touching the record itself.
+		if (slot.path_hash == hash)
+		{
+			if (slot.last_modified_time != static_cast<s64>(timestamp) || slot.file_size != file_size)
+				return 0;
+
+			std::string_view record_path;
+			u64 next_offset;
+			if (ReadCacheRecordPath(slot.record_offset, &record_path, &next_offset) && record_path == path)
+				return slot.record_offset;
+		}
+	}
+
+	return 0;
 }
 
-static bool WriteU64(std::FILE* stream, u64 dest)
+bool GameList::GetGameListEntryFromCache(const std::string& path, std::time_t timestamp, u64 file_size, GameList::Entry* entry)
 {
-	return std::fwrite(&dest, sizeof(u64), 1, stream) > 0;
+	const u64 offset = FindCacheRecord(path, timestamp, file_size);
+	if (offset == 0)
+		return false;
+
+	u64 record_file_size;
+	if (!ReadCacheRecord(offset, entry, &record_file_size, nullptr))
+	{
+		Console.Warning("Game list cache entry for '%s' is corrupted", path.c_str());
+		return false;
+	}
+
+	return (entry->last_modified_time == timestamp && record_file_size == file_size);
 }
 
-bool GameList::LoadEntriesFromCache(std::FILE* stream)
+bool GameList::LoadEntriesFromCache()
 {
-	u32 file_signature, file_version;
-	s64 start_pos, file_size;
-	if (!ReadU32(stream, &file_signature) || !ReadU32(stream, &file_version) || file_signature != GAME_LIST_CACHE_SIGNATURE ||
-		file_version != GAME_LIST_CACHE_VERSION || (start_pos = FileSystem::FTell64(stream)) < 0 ||
-		FileSystem::FSeek64(stream, 0, SEEK_END) != 0 || (file_size = FileSystem::FTell64(stream)) < 0 ||
-		FileSystem::FSeek64(stream, start_pos, SEEK_SET) != 0)
+	if (s_cache_size < sizeof(CacheFileHeader))
 	{
 		Console.Warning("Game list cache is corrupted");
 		return false;
 	}
 
-	while (FileSystem::FTell64(stream) != file_size)
+	std::memcpy(&s_cache_header, s_cache_data, sizeof(s_cache_header));
+	const CacheFileHeader& hdr = s_cache_header;
+	if (hdr.signature != GAME_LIST_CACHE_SIGNATURE || hdr.version != GAME_LIST_CACHE_VERSION ||
+		(hdr.bucket_count & (hdr.bucket_count - 1)) != 0 || hdr.tail_offset < sizeof(CacheFileHeader) ||
+		hdr.tail_offset > s_cache_size ||
+		(hdr.bucket_count > 0 && (hdr.index_offset < sizeof(CacheFileHeader) ||
+									 hdr.index_offset + static_cast<u64>(hdr.bucket_count) * sizeof(CacheIndexSlot) > hdr.tail_offset)))
 	{
-		std::string path;
-		GameList::Entry ge;
-
-		u8 type;
-		u8 region;
-		u8 compatibility_rating;
-		u64 last_modified_time;
+		Console.Warning("Game list cache is corrupted");
+		return false;
+	}
 
-		if (!ReadString(stream, &path) || !ReadString(stream, &ge.serial) || !ReadString(stream, &ge.title) || !ReadString(stream, &ge.title_sort) ||
-			!ReadString(stream, &ge.title_en) || !ReadU8(stream, &type) || !ReadU8(stream, &region) || !ReadU64(stream, &ge.total_size) ||
-			!ReadU64(stream, &last_modified_time) || !ReadU32(stream, &ge.crc) || !ReadU8(stream, &compatibility_rating) ||
-			region >= static_cast<u8>(Region::Count) || type >= static_cast<u8>(EntryType::Count) ||
-			compatibility_rating > static_cast<u8>(CompatibilityRating::Perfect))
+	// Indexed entries are only read when something asks for them, just the paths in the tail need looking at.
+	u64 offset = hdr.tail_offset;
+	while (offset != s_cache_size)
+	{
+		std::string_view path;
+		u64 next_offset;
+		if (!ReadCacheRecordPath(offset, &path, &next_offset))
 		{
 			Console.Warning("Game list cache entry is corrupted");
 			return false;
 		}
 
-		ge.path = path;
-		ge.region = static_cast<Region>(region);
-		ge.type = static_cast<EntryType>(type);
-		ge.compatibility_rating = static_cast<CompatibilityRating>(compatibility_rating);
-		ge.last_modified_time = static_cast<std::time_t>(last_modified_time);
-
-		auto iter = s_cache_map.find(ge.path);
-		if (iter != s_cache_map.end())
-			iter->second = std::move(ge);
+		auto iter = s_cache_tail.find(path);
+		if (iter != s_cache_tail.end())
+			iter->second = offset;
 		else
-			s_cache_map.emplace(std::move(path), std::move(ge));
+			s_cache_tail.emplace(path, offset);
+
+		offset = next_offset;
 	}
 
 	return true;
@@ -536,15 +722,13 @@ static std::string GetCacheFilename()
 void GameList::LoadCache()
 {
 	const std::string cache_filename(GetCacheFilename());
-	auto stream = FileSystem::OpenManagedCFile(cache_filename.c_str(), "rb");
-	if (!stream)
+	if (!MapCacheFile(cache_filename.c_str()))
 		return;
 
-	if (!LoadEntriesFromCache(stream.get()))
+	if (!LoadEntriesFromCache())
 	{
 		Console.Warning("Deleting corrupted cache file '%s'", cache_filename.c_str());
-		stream.reset();
-		s_cache_map.clear();
+		UnmapCacheFile();
 		DeleteCacheFile();
 		return;
 	}
@@ -561,10 +745,9 @@ bool GameList::OpenCacheForWriting()
 	if (s_cache_write_stream)
 	{
 		// check the header
-		u32 signature, version;
-		if (ReadU32(s_cache_write_stream, &signature) && signature == GAME_LIST_CACHE_SIGNATURE &&
-			ReadU32(s_cache_write_stream, &version) && version == GAME_LIST_CACHE_VERSION &&
-			FileSystem::FSeek64(s_cache_write_stream, 0, SEEK_END) == 0)
+		CacheFileHeader hdr;
+		if (std::fread(&hdr, sizeof(hdr), 1, s_cache_write_stream) == 1 && hdr.signature == GAME_LIST_CACHE_SIGNATURE &&
+			hdr.version == GAME_LIST_CACHE_VERSION && FileSystem::FSeek64(s_cache_write_stream, 0, SEEK_END) == 0)
 		{
 			return true;
 		}
@@ -578,9 +761,12 @@ bool GameList::OpenCacheForWriting()
 	if (!s_cache_write_stream)
 		return false;
 
-
-	// new cache file, write header
-	if (!WriteU32(s_cache_write_stream, GAME_LIST_CACHE_SIGNATURE) || !WriteU32(s_cache_write_stream, GAME_LIST_CACHE_VERSION))
+	// new cache file, write header, everything goes in the tail until it's compacted
+	CacheFileHeader hdr = {};
+	hdr.signature = GAME_LIST_CACHE_SIGNATURE;
+	hdr.version = GAME_LIST_CACHE_VERSION;
+	hdr.tail_offset = sizeof(hdr);
+	if (std::fwrite(&hdr, sizeof(hdr), 1, s_cache_write_stream) != 1)
 	{
 		Console.Error("Failed to write game list cache header");
 		std::fclose(s_cache_write_stream);
@@ -592,26 +778,29 @@ bool GameList::OpenCacheForWriting()
 	return true;
 }
 
-bool GameList::WriteEntryToCache(const Entry* entry)
+bool GameList::WriteEntryToCache(const Entry* entry, u64 file_size)
 {
-	bool result = true;
-	result &= WriteString(s_cache_write_stream, entry->path);
-	result &= WriteString(s_cache_write_stream, entry->serial);
-	result &= WriteString(s_cache_write_stream, entry->title);
-	result &= WriteString(s_cache_write_stream, entry->title_sort);
-	result &= WriteString(s_cache_write_stream, entry->title_en);
-	result &= WriteU8(s_cache_write_stream, static_cast<u8>(entry->type));
-	result &= WriteU8(s_cache_write_stream, static_cast<u8>(entry->region));
-	result &= WriteU64(s_cache_write_stream, entry->total_size);
-	result &= WriteU64(s_cache_write_stream, static_cast<u64>(entry->last_modified_time));
-	result &= WriteU32(s_cache_write_stream, entry->crc);
-	result &= WriteU8(s_cache_write_stream, static_cast<u8>(entry->compatibility_rating));
+	std::vector<u8> record;
+	AppendValue<u32>(record, 0);
+	AppendString(record, entry->path);
+	AppendString(record, entry->serial);
+	AppendString(record, entry->title);
+	AppendString(record, entry->title_sort);
+	AppendString(record, entry->title_en);
+	AppendValue(record, static_cast<u8>(entry->type));
+	AppendValue(record, static_cast<u8>(entry->region));
+	AppendValue(record, entry->total_size);
+	AppendValue(record, static_cast<u64>(entry->last_modified_time));
+	AppendValue(record, file_size);
+	AppendValue(record, entry->crc);
+	AppendValue(record, static_cast<u8>(entry->compatibility_rating));
+
+	const u32 record_size = static_cast<u32>(record.size() - sizeof(u32));
+	std::memcpy(record.data(), &record_size, sizeof(record_size));
 
 	// flush after each entry, that way we don't end up with a corrupted file if we crash scanning.
-	if (result)
-		result = (std::fflush(s_cache_write_stream) == 0);
-
-	return result;
+	return (std::fwrite(record.data(), record.size(), 1, s_cache_write_stream) == 1 &&
+			std::fflush(s_cache_write_stream) == 0);
 }
 
 void GameList::CloseCacheFileStream()
@@ -637,18 +826,110 @@ void GameList::DeleteCacheFile()
 		Console.Warning("Failed to delete game list cache '%s'", cache_filename.c_str());
 }
 
-void GameList::RewriteCacheFile()
+void GameList::CompactCacheFileIfNeeded(bool drop_unlisted)
 {
 	CloseCacheFileStream();
-	DeleteCacheFile();
 
-	if (OpenCacheForWriting())
+	// Remapped to pick up whatever was appended while scanning.
+	const std::string cache_filename(GetCacheFilename());
+	if (!MapCacheFile(cache_filename.c_str()) || !LoadEntriesFromCache())
 	{
-		for (const GameList::Entry& entry : s_entries)
-			WriteEntryToCache(&entry);
+		UnmapCacheFile();
+		return;
+	}
+
+	// After a complete scan, anything which isn't in the list was deleted, moved or excluded.
+	UnorderedStringSet listed;
+	if (drop_unlisted)
+	{
+		for (const Entry& entry : s_entries)
+			listed.emplace(entry.path);
+	}
+	const auto is_listed = [drop_unlisted, &listed](std::string_view path) {
+		return !drop_unlisted || listed.contains(path);
+	};
+
+	// Latest record for each path, the tail overrides the index.
+	UnorderedStringMap<u64> live;
+	size_t stale = s_cache_tail.size();
+	for (u32 i = 0; i < s_cache_header.bucket_count; i++)
+	{
+		CacheIndexSlot slot;
+		std::memcpy(&slot, s_cache_data + s_cache_header.index_offset + static_cast<size_t>(i) * sizeof(slot), sizeof(slot));
+
+		std::string_view path;
+		u64 next_offset;
+		if (slot.record_offset == 0 || !ReadCacheRecordPath(slot.record_offset, &path, &next_offset) || s_cache_tail.contains(path))
+			continue;
+
+		if (is_listed(path))
+			live.emplace(path, slot.record_offset);
+		else
+			stale++;
+	}
+	for (const auto& [path, offset] : s_cache_tail)
+	{
+		if (is_listed(path))
+			live.emplace(path, offset);
+	}
+
+	if (stale <= std::max<u32>(CACHE_COMPACT_MIN_TAIL_ENTRIES, s_cache_header.indexed_entries / CACHE_COMPACT_TAIL_RATIO))
+	{
+		UnmapCacheFile();
+		return;
+	}
+
+	u32 bucket_count = 16;
+	while (bucket_count < live.size() * 2)
+		bucket_count *= 2;
 
-		CloseCacheFileStream();
+	std::vector<u8> data(sizeof(CacheFileHeader));
+	std::vector<CacheIndexSlot> slots(bucket_count);
+	u32 written = 0;
+	for (const auto& [path, offset] : live)
+	{
+		Entry entry;
+		u64 file_size, next_offset;
+		if (!ReadCacheRecord(offset, &entry, &file_size, &next_offset))
+			continue;
+
+		CacheIndexSlot slot;
+		slot.path_hash = HashCachePath(path);
+		slot.record_offset = data.size();
+		slot.last_modified_time = static_cast<s64>(entry.last_modified_time);
+		slot.file_size = file_size;
+		data.insert(data.end(), s_cache_data + offset, s_cache_data + next_offset);
+
+		u32 bucket = static_cast<u32>(slot.path_hash & (bucket_count - 1));
+		while (slots[bucket].record_offset != 0)
+			bucket = (bucket + 1) & (bucket_count - 1);
+		slots[bucket] = slot;
+		written++;
+	}
+
+	CacheFileHeader hdr = {};
+	hdr.signature = GAME_LIST_CACHE_SIGNATURE;
+	hdr.version = GAME_LIST_CACHE_VERSION;
+	hdr.index_offset = data.size();
+	hdr.bucket_count = bucket_count;
+	hdr.indexed_entries = written;
+	hdr.tail_offset = hdr.index_offset + static_cast<u64>(bucket_count) * sizeof(CacheIndexSlot);
+	std::memcpy(data.data(), &hdr, sizeof(hdr));
+	data.insert(data.end(), reinterpret_cast<const u8*>(slots.data()), reinterpret_cast<const u8*>(slots.data() + slots.size()));
+
+	UnmapCacheFile();
+
+	// Written next to it and renamed over, so a crash can't leave a half-written cache behind.
+	const std::string temp_filename = cache_filename + ".tmp";
+	if (!FileSystem::WriteBinaryFile(temp_filename.c_str(), data.data(), data.size()) ||
+		!FileSystem::RenamePath(temp_filename.c_str(), cache_filename.c_str()))
+	{
+		Console.Warning("Failed to compact game list cache '%s'", cache_filename.c_str());
+		FileSystem::DeleteFilePath(temp_filename.c_str());
+		return;
 	}
+
+	Console.WriteLn(fmt::format("Compacted game list cache to {} entries ({} bytes)", hdr.indexed_entries, data.size()));
 }
 
 static bool IsPathExcluded(const std::vector<std::string>& excluded_paths, const std::string& path)
@@ -680,35 +961,137 @@ void GameList::ScanDirectory(const char* path, bool recursive, bool only_cache,
 	progress->SetProgressRange(static_cast<u32>(files.size()));
 	progress->SetProgressValue(0);
 
+	// Pick up everything that's cached first, so only the files which actually need opening are left for the scan.
+	std::vector<FILESYSTEM_FIND_DATA*> files_to_scan;
 	for (FILESYSTEM_FIND_DATA& ffd : files)
 	{
-		files_scanned++;
-
 		if (progress->IsCancelled() || !GameList::IsScannableFilename(ffd.FileName) || IsPathExcluded(excluded_paths, ffd.FileName))
 		{
+			files_scanned++;
 			continue;
 		}
 
 		std::unique_lock lock(s_mutex);
-		if (GetEntryForPath(ffd.FileName.c_str()) || AddFileFromCache(ffd.FileName, ffd.ModificationTime, played_time_map) || only_cache)
+		if (GetEntryForPath(ffd.FileName.c_str()) || AddFileFromCache(ffd.FileName, ffd.ModificationTime, static_cast<u64>(ffd.Size), played_time_map) || only_cache)
 		{
+			files_scanned++;
 			continue;
 		}
 
-		const std::string_view filename = Path::GetFileName(ffd.FileName);
-		progress->SetStatusText(fmt::format(TRANSLATE_FS("GameList", "Scanning {}..."), filename.data()).c_str());
-		ScanFile(std::move(ffd.FileName), ffd.ModificationTime, lock, played_time_map, custom_attributes_ini);
-		progress->SetProgressValue(files_scanned);
+		files_to_scan.push_back(&ffd);
 	}
-
 	progress->SetProgressValue(files_scanned);
+
+	const u32 num_threads = GetScanThreadCount(files_to_scan.size());
+	if (num_threads > 1)
+	{
+		ScanFilesParallel(files_to_scan, num_threads, files_scanned, played_time_map, custom_attributes_ini, progress);
+	}
+	else
+	{
+		for (FILESYSTEM_FIND_DATA* ffd : files_to_scan)
+		{
+			if (progress->IsCancelled())
+				break;
+
+			const std::string_view filename = Path::GetFileName(ffd->FileName);
+			progress->SetStatusText(fmt::format(TRANSLATE_FS("GameList", "Scanning {}..."), filename.data()).c_str());
+
+			std::unique_lock lock(s_mutex);
+			ScanFile(std::move(ffd->FileName), ffd->ModificationTime, static_cast<u64>(ffd->Size), lock, played_time_map,
+				custom_attributes_ini);
+			progress->SetProgressValue(++files_scanned);
+		}
+	}
+
+	progress->SetProgressValue(static_cast<u32>(files.size()));
 	progress->PopState();
 }
 
-bool GameList::AddFileFromCache(const std::string& path, std::time_t timestamp, const PlayedTimeMap& played_time_map)
+u32 GameList::GetScanThreadCount(size_t num_files)
+{
+	// 0 picks a count from the CPU, 1 scans on the calling thread like before.
+	const int setting = Host::GetBaseIntSettingValue("GameList", "ScanThreads", 0);
+	const u32 threads = (setting > 0) ? static_cast<u32>(setting) :
+	                                    std::clamp<u32>(std::thread::hardware_concurrency(), 1, MAX_AUTO_SCAN_THREADS);
+	return static_cast<u32>(std::min<size_t>(threads, num_files));
+}
+
+void GameList::ScanFilesParallel(std::vector<FILESYSTEM_FIND_DATA*>& files, u32 num_threads, u32 base_progress,
+	const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini, ProgressCallback* progress)
+{
+	std::atomic<size_t> next_file{0};
+	std::atomic<u32> files_done{0};
+	std::atomic<u64> bytes_done{0};
+	std::atomic_bool cancelled{false};
+	std::mutex done_mutex;
+	std::condition_variable done_cv;
+
+	const auto worker = [&]() {
+		for (;;)
+		{
+			const size_t index = next_file.fetch_add(1, std::memory_order_relaxed);
+			if (index >= files.size() || cancelled.load(std::memory_order_relaxed))
+				break;
+
+			FILESYSTEM_FIND_DATA* ffd = files[index];
+			std::unique_lock lock(s_mutex);
+			ScanFile(std::move(ffd->FileName), ffd->ModificationTime, static_cast<u64>(ffd->Size), lock, played_time_map,
+				custom_attributes_ini);
+			lock = {};
+
+			bytes_done.fetch_add(static_cast<u64>(std::max<s64>(ffd->Size, 0)), std::memory_order_relaxed);
+			{
+				std::unique_lock done_lock(done_mutex);
+				files_done.fetch_add(1, std::memory_order_release);
+			}
+			done_cv.notify_one();
+		}
+	};
+
+	Console.WriteLn(fmt::format("Scanning {} files on {} threads", files.size(), num_threads));
+
+	std::vector<std::thread> threads;
+	threads.reserve(num_threads);
+	for (u32 i = 0; i < num_threads; i++)
+		threads.emplace_back(worker);
+
+	// Progress callbacks aren't thread safe, so this thread reports for the workers.
+	Common::Timer timer;
+	u32 reported = 0;
+	while (reported < files.size())
+	{
+		{
+			std::unique_lock done_lock(done_mutex);
+			done_cv.wait_for(done_lock, std::chrono::milliseconds(100),
+				[&]() { return files_done.load(std::memory_order_acquire) != reported; });
+		}
+
+		if (progress->IsCancelled())
+		{
+			cancelled.store(true, std::memory_order_relaxed);
+			break;
+		}
+
+		reported = files_done.load(std::memory_order_acquire);
+		const double seconds = std::max(timer.GetTimeSeconds(), 0.001);
+		progress->SetStatusText(fmt::format(TRANSLATE_FS("GameList", "Scanning {} of {} files ({:.1f} files/s, {:.1f} MB/s)..."),
+			reported, files.size(), reported / seconds,
+			static_cast<double>(bytes_done.load(std::memory_order_relaxed)) / (1024.0 * 1024.0) / seconds)
+									.c_str());
+		progress->SetProgressValue(base_progress + reported);
+	}
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	Console.WriteLn(fmt::format("Scanned {} files in {:.2f} seconds", files_done.load(), timer.GetTimeSeconds()));
+}
+
+bool GameList::AddFileFromCache(const std::string& path, std::time_t timestamp, u64 file_size, const PlayedTimeMap& played_time_map)
 {
 	Entry entry;
-	if (!GetGameListEntryFromCache(path, &entry) || entry.last_modified_time != timestamp)
+	if (!GetGameListEntryFromCache(path, timestamp, file_size, &entry))
 		return false;
 
 	// Skip over invalid entries.
@@ -726,7 +1109,7 @@ bool GameList::AddFileFromCache(const std::string& path, std::time_t timestamp,
 	return true;
 }
 
-bool GameList::ScanFile(std::string path, std::time_t timestamp, std::unique_lock<std::recursive_mutex>& lock,
+bool GameList::ScanFile(std::string path, std::time_t timestamp, u64 file_size, std::unique_lock<std::recursive_mutex>& lock,
 	const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini)
 {
 	// don't block UI while scanning
@@ -740,17 +1123,25 @@ bool GameList::ScanFile(std::string path, std::time_t timestamp, std::unique_loc
 
 	entry.last_modified_time = timestamp;
 
+	lock.lock();
+	AddScannedEntry(std::move(entry), file_size, played_time_map, custom_attributes_ini);
+	return true;
+}
+
+void GameList::AddScannedEntry(Entry entry, u64 file_size, const PlayedTimeMap& played_time_map,
+	const INISettingsInterface& custom_attributes_ini)
+{
+	// Called with s_mutex held, which also keeps scan threads from interleaving their cache writes.
 	if (s_cache_write_stream || OpenCacheForWriting())
 	{
-		if (!WriteEntryToCache(&entry))
+		if (!WriteEntryToCache(&entry, file_size))
 			Console.Warning("Failed to write entry '%s' to cache", entry.path.c_str());
 	}
 
 	if (entry.type == EntryType::Invalid)
 	{
 		// don't add invalid entries to list
-		lock.lock();
-		return true;
+		return;
 	}
 
 	const auto iter = played_time_map.find(entry.serial);
@@ -775,8 +1166,6 @@ bool GameList::ScanFile(std::string path, std::time_t timestamp, std::unique_loc
 		}
 	}
 
-	lock.lock();
-
 	// remove if present
 	auto it = std::find_if(
 		s_entries.begin(), s_entries.end(), [&entry](const Entry& existing_entry) { return (existing_entry.path == entry.path); });
@@ -784,7 +1173,6 @@ bool GameList::ScanFile(std::string path, std::time_t timestamp, std::unique_loc
 		s_entries.erase(it);
 
 	s_entries.push_back(std::move(entry));
-	return true;
 }
 
 std::unique_lock<std::recursive_mutex> GameList::GetLock()
@@ -885,9 +1273,10 @@ void GameList::Refresh(bool invalidate_cache, bool only_cache, ProgressCallback*
 		}
 	}
 
-	// don't need unused cache entries
-	CloseCacheFileStream();
-	s_cache_map.clear();
+	// don't need unused cache entries, fold anything new into the index while we're here
+	// a cancelled scan didn't see everything, so keep the entries it missed
+	std::unique_lock lock(s_mutex);
+	CompactCacheFileIfNeeded(!progress->IsCancelled());
 }
 
 bool GameList::RescanPath(const std::string& path)
@@ -910,11 +1299,11 @@ bool GameList::RescanPath(const std::string& path)
 	}
 
 	// re-scan!
-	if (!ScanFile(path, sd.ModificationTime, lock, played_time, custom_attributes_ini))
+	if (!ScanFile(path, sd.ModificationTime, static_cast<u64>(sd.Size), lock, played_time, custom_attributes_ini))
 		return true;
 
-	// update cache.. this is far from ideal, but since everything's variable length, all we can do.
-	RewriteCacheFile();
+	// the new entry was appended to the cache, which supersedes the old one
+	CompactCacheFileIfNeeded(false);
 	return true;
 }
 
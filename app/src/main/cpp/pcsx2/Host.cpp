@@ -390,3 +390,8 @@ void Host::Internal::SetInputSettingsLayer(SettingsInterface* sif, std::unique_l
 {
 	s_layered_settings_interface.SetLayer(LayeredSettingsInterface::LAYER_INPUT, sif);
 }
+
+void Host::Internal::SetCommandLineSettingsLayer(SettingsInterface* sif, std::unique_lock<std::mutex>& settings_lock)
+{
+	s_layered_settings_interface.SetLayer(LayeredSettingsInterface::LAYER_CMDLINE, sif);
+}
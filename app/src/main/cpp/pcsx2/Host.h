@@ -166,6 +166,9 @@ namespace Host
 		/// Sets the input profile settings layer. Called by VMManager when the game changes.
 		void SetInputSettingsLayer(SettingsInterface* sif, std::unique_lock<std::mutex>& settings_lock);
 
+		/// Sets the command line settings layer, which overrides every other layer. Pass nullptr to remove it.
+		void SetCommandLineSettingsLayer(SettingsInterface* sif, std::unique_lock<std::mutex>& settings_lock);
+
 		/// Implementation to retrieve a translated string.
 		s32 GetTranslatedStringImpl(const std::string_view context, const std::string_view msg, char* tbuf, size_t tbuf_space);
 	} // namespace Internal
@@ -7,6 +7,7 @@
 #include "GS.h"
 #include "GS/GS.h"
 #include "GS/GSCapture.h"
+#include "GS/GSPerfMon.h"
 #include "GS/GSVector.h"
 #include "GS/Renderers/Common/GSDevice.h"
 #include "Host.h"
@@ -245,6 +246,29 @@ __ri void ImGuiManager::DrawPerformanceOverlay(float& position_y, float scale, f
 			FormatProcessorStat(text, PerformanceMetrics::GetCPUThreadUsage(), PerformanceMetrics::GetCPUThreadAverageTime());
 			DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
 
+			if (CHECK_EEREC && (CHECK_JITCOUNTERS || CHECK_FASTMEM))
+			{
+				// Fastmem faults are counted by the fault handler, only the dispatcher stats need the JIT counters
+				text = "EE JIT:";
+				if (CHECK_JITCOUNTERS)
+				{
+					text.append_format(" {:.0f} disp/f", PerformanceMetrics::GetEEDispatchesPerFrame());
+					if (CHECK_EERETURNSTACK)
+						text.append_format(" | RAS {:.1f}%", PerformanceMetrics::GetEEReturnStackHitRate());
+					if (CHECK_FASTMEM)
+						text.append(" |");
+				}
+				if (CHECK_FASTMEM)
+					text.append_format(" FM {:.1f} faults/f", PerformanceMetrics::GetFastmemFaultsPerFrame());
+				DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
+			}
+
+			text.clear();
+			text.append_format("IOP: {:.0f}k cyc/f", PerformanceMetrics::GetIOPCyclesPerFrame() / 1000.0f);
+			if (CHECK_IOPREC && CHECK_JITCOUNTERS)
+				text.append_format(" | {:.0f} disp/f", PerformanceMetrics::GetIOPDispatchesPerFrame());
+			DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
+
 			text = "GS: ";
 			FormatProcessorStat(text, PerformanceMetrics::GetGSThreadUsage(), PerformanceMetrics::GetGSThreadAverageTime());
 			DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
@@ -254,6 +278,14 @@ __ri void ImGuiManager::DrawPerformanceOverlay(float& position_y, float scale, f
 				text = "VU: ";
 				FormatProcessorStat(text, PerformanceMetrics::GetVUThreadUsage(), PerformanceMetrics::GetVUThreadAverageTime());
 				DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
+
+				const PerformanceMetrics::VUPipelineUsage& vu = PerformanceMetrics::GetVUPipelineUsage();
+				text.clear();
+				text.append_format("VU1: exec {:.0f}% unpack {:.0f}%", vu.execute, vu.unpack);
+				if (THREAD_VU1_PIPELINE)
+					text.append_format(" (overlap {:.0f}%) stall {:.0f}%", vu.overlap, vu.stall);
+				text.append_format(" | EE wait {:.0f}%", vu.ee_wait);
+				DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
 			}
 
 			const u32 gs_sw_threads = PerformanceMetrics::GetGSSWThreadCount();
@@ -262,6 +294,8 @@ __ri void ImGuiManager::DrawPerformanceOverlay(float& position_y, float scale, f
 				text.clear();
 				text.append_format("SW-{}: ", i);
 				FormatProcessorStat(text, PerformanceMetrics::GetGSSWThreadUsage(i), PerformanceMetrics::GetGSSWThreadAverageTime(i));
+				if (i < g_perfmon.GetWorkerCount())
+					text.append_format(" | busy {:.0f}% idle {:.0f}%", g_perfmon.GetWorkerBusy(i), g_perfmon.GetWorkerIdle(i));
 				DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
 			}
 
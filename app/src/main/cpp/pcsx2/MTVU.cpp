@@ -7,6 +7,8 @@
 #include "VMManager.h"
 #include "Vif_Dynarec.h"
 
+#include "common/Timer.h"
+
 #include <thread>
 
 //VU_Thread vu1Thread;
@@ -109,6 +111,13 @@ void VU_Thread::Close()
 	m_shutdown_flag.store(true, std::memory_order_release);
 	semaEvent.NotifyOfWork();
 	m_thread.Join();
+
+	// The VU thread always waits for the exec thread before it goes idle, so it's parked here.
+	if (m_exec_thread.Joinable())
+	{
+		m_exec_start.Post();
+		m_exec_thread.Join();
+	}
 }
 
 void VU_Thread::Reset()
@@ -118,6 +127,7 @@ void VU_Thread::Reset()
 	m_write_pos = 0;
 	m_ato_read_pos = 0;
 	m_read_pos = 0;
+	m_exec_pending = false;
 	std::memset(&vif, 0, sizeof(vif));
 	std::memset(&vifRegs, 0, sizeof(vifRegs));
 	for (size_t i = 0; i < 4; ++i)
@@ -138,23 +148,35 @@ void VU_Thread::ExecuteRingBuffer()
 		while (m_ato_read_pos.load(std::memory_order_relaxed) != GetWritePos())
 		{
 			u32 tag = Read();
+
+			// Only unpacks (and the col/row they use) may run alongside a microprogram, the
+			// same as VIF1 carrying on with UNPACKs while VU1 is busy on the real hardware.
+			if (tag != MTVU_VIF_UNPACK && tag != MTVU_VIF_WRITE_COL && tag != MTVU_VIF_WRITE_ROW && tag != MTVU_NULL_PACKET)
+				WaitPipeline();
+
 			switch (tag)
 			{
 				case MTVU_VU_EXECUTE:
 				{
-					VU1.cycle = 0;
 					s32 addr = Read();
 					vifRegs.top = Read();
 					vifRegs.itop = Read();
 					vuFBRST = Read();
-					if (addr != -1)
-						VU1.VI[REG_TPC].UL = addr & 0x7FF;
-					CpuVU1->SetStartPC(VU1.VI[REG_TPC].UL << 3);
-					CpuVU1->Execute(vu1RunCycles);
-					gifUnit.gifPath[GIF_PATH_1].FinishGSPacketMTVU();
-					semaXGkick.Post(); // Tell MTGS a path1 packet is complete
-					vuCycles[vuCycleIdx].store(VU1.cycle, std::memory_order_release);
-					vuCycleIdx = (vuCycleIdx + 1) & 3;
+					if (THREAD_VU1_PIPELINE)
+					{
+						if (!m_exec_thread.Joinable())
+						{
+							m_exec_thread.SetStackSize(VMManager::EMU_THREAD_STACK_SIZE);
+							m_exec_thread.Start([this]() { ExecutePipelined(); });
+						}
+						m_exec_addr = addr;
+						m_exec_pending = true;
+						m_exec_start.Post();
+					}
+					else
+					{
+						ExecuteProgram(addr);
+					}
 					break;
 				}
 				case MTVU_VU_WRITE_MICRO:
@@ -188,9 +210,15 @@ void VU_Thread::ExecuteRingBuffer()
 				{
 					u32 vif_copy_size = (uptr)&vif.StructEnd - (uptr)&vif.tag;
 					Read(&vif.tag, vif_copy_size);
-					ReadRegs(&vifRegs);
+					// A running program may be reading TOP/ITOP, the next execute sets them anyway.
+					ReadRegs(&vifRegs, !m_exec_pending);
 					u32 size = Read();
+					const Common::Timer::Value start = Common::Timer::GetCurrentValue();
 					MTVU_Unpack(&buffer[m_read_pos], vifRegs);
+					const Common::Timer::Value time = Common::Timer::GetCurrentValue() - start;
+					m_time_unpack.fetch_add(time, std::memory_order_relaxed);
+					if (m_exec_pending)
+						m_time_overlap.fetch_add(time, std::memory_order_relaxed);
 					m_read_pos += size_u32(size);
 					break;
 				}
@@ -202,15 +230,63 @@ void VU_Thread::ExecuteRingBuffer()
 
 			CommitReadPos();
 		}
+
+		// WaitVU() only returns once we go back to sleep, so the program must be done by then.
+		WaitPipeline();
 	}
 
 	semaEvent.Kill();
 }
 
+void VU_Thread::ExecutePipelined()
+{
+	Threading::SetNameOfCurrentThread("MTVU Exec");
+
+	for (;;)
+	{
+		m_exec_start.Wait();
+		if (m_shutdown_flag.load(std::memory_order_acquire))
+			break;
+
+		ExecuteProgram(m_exec_addr);
+		m_exec_done.Post();
+	}
+}
+
+void VU_Thread::ExecuteProgram(s32 addr)
+{
+	const Common::Timer::Value start = Common::Timer::GetCurrentValue();
+
+	VU1.cycle = 0;
+	if (addr != -1)
+		VU1.VI[REG_TPC].UL = addr & 0x7FF;
+	CpuVU1->SetStartPC(VU1.VI[REG_TPC].UL << 3);
+	CpuVU1->Execute(vu1RunCycles);
+	gifUnit.gifPath[GIF_PATH_1].FinishGSPacketMTVU();
+	semaXGkick.Post(); // Tell MTGS a path1 packet is complete
+	vuCycles[vuCycleIdx].store(VU1.cycle, std::memory_order_release);
+	vuCycleIdx = (vuCycleIdx + 1) & 3;
+
+	m_time_execute.fetch_add(Common::Timer::GetCurrentValue() - start, std::memory_order_relaxed);
+}
+
+// Waits for the program running on the exec thread (if any), only called from the VU thread
+void VU_Thread::WaitPipeline()
+{
+	if (!m_exec_pending)
+		return;
+
+	const Common::Timer::Value start = Common::Timer::GetCurrentValue();
+	m_exec_done.Wait();
+	m_exec_pending = false;
+	m_time_stall.fetch_add(Common::Timer::GetCurrentValue() - start, std::memory_order_relaxed);
+}
+
 
 // Should only be called by ReserveSpace()
 __ri void VU_Thread::WaitOnSize(s32 size)
 {
+	Common::Timer::Value start = 0;
 	for (;;)
 	{
 		s32 readPos = GetReadPos();
@@ -229,9 +305,14 @@ __ri void VU_Thread::WaitOnSize(s32 size)
 			// will be more aggressive, and only flush the minimal size.
 			// Performance will be smoother but it will consume extra CPU cycle
 			// on the EE thread (not an issue on 4 cores).
+			if (start == 0)
+				start = Common::Timer::GetCurrentValue();
 			std::this_thread::yield();
 		}
 	}
+
+	if (start != 0)
+		m_time_ee_wait.fetch_add(Common::Timer::GetCurrentValue() - start, std::memory_order_relaxed);
 }
 
 // Makes sure theres enough room in the ring buffer
@@ -301,15 +382,18 @@ __fi void VU_Thread::Read(void* dest, u32 size)
 	m_read_pos += size_u32(size);
 }
 
-__fi void VU_Thread::ReadRegs(VIFregisters* dest)
+__fi void VU_Thread::ReadRegs(VIFregisters* dest, bool tops)
 {
 	VIFregistersMTVU* src = (VIFregistersMTVU*)&buffer[m_read_pos];
 	dest->cycle = src->cycle;
 	dest->mode = src->mode;
 	dest->num = src->num;
 	dest->mask = src->mask;
-	dest->itop = src->itop;
-	dest->top = src->top;
+	if (tops)
+	{
+		dest->itop = src->itop;
+		dest->top = src->top;
+	}
 	m_read_pos += size_u32(sizeof(VIFregistersMTVU));
 }
 
@@ -435,7 +519,16 @@ bool VU_Thread::IsDone()
 void VU_Thread::WaitVU()
 {
 	MTVU_LOG("MTVU - WaitVU!");
+	const Common::Timer::Value start = Common::Timer::GetCurrentValue();
 	semaEvent.WaitForEmpty();
+	m_time_ee_wait.fetch_add(Common::Timer::GetCurrentValue() - start, std::memory_order_relaxed);
+}
+
+VU_Thread::PipelineTimes VU_Thread::GetPipelineTimes() const
+{
+	return {m_time_execute.load(std::memory_order_relaxed), m_time_unpack.load(std::memory_order_relaxed),
+		m_time_overlap.load(std::memory_order_relaxed), m_time_stall.load(std::memory_order_relaxed),
+		m_time_ee_wait.load(std::memory_order_relaxed)};
 }
 
 void VU_Thread::ExecuteVU(u32 vu_addr, u32 vif_top, u32 vif_itop, u32 fbrst)
@@ -30,6 +30,20 @@ class VU_Thread final {
 
 	Threading::Thread m_thread;
 
+	// Pipelined mode: microprograms run on a second thread, while this one carries on with the
+	// VIF unpacks queued behind them. Anything else in the ring waits for the program to finish.
+	Threading::Thread m_exec_thread;
+	Threading::UserspaceSemaphore m_exec_start;
+	Threading::UserspaceSemaphore m_exec_done;
+	s32 m_exec_addr;    // start address of the program handed to the exec thread
+	bool m_exec_pending; // a program is running on the exec thread (local to the VU thread)
+
+	std::atomic<u64> m_time_execute{0};
+	std::atomic<u64> m_time_unpack{0};
+	std::atomic<u64> m_time_overlap{0};
+	std::atomic<u64> m_time_stall{0};
+	std::atomic<u64> m_time_ee_wait{0};
+
 public:
 	alignas(16)  vifStruct        vif;
 	alignas(16)  VIFregisters     vifRegs;
@@ -50,6 +64,16 @@ public:
 	std::atomic<u64> gsLabel; // Used for GS Label command
 	std::atomic<u64> gsSignal; // Used for GS Signal command
 
+	// Free-running wall clock totals (in Common::Timer ticks) of where VU1 time goes.
+	struct PipelineTimes
+	{
+		u64 execute; // running microprograms
+		u64 unpack;  // running VIF unpacks
+		u64 overlap; // unpacks which ran while a microprogram was executing (pipelined mode)
+		u64 stall;   // VU thread waiting for a microprogram before it could carry on (pipelined mode)
+		u64 ee_wait; // EE thread waiting for the VU thread (full ring buffer or WaitVU)
+	};
+
 	VU_Thread();
 	~VU_Thread();
 
@@ -77,6 +101,8 @@ public:
 
 	void Get_MTVUChanges();
 
+	PipelineTimes GetPipelineTimes() const;
+
 	void ExecuteVU(u32 vu_addr, u32 vif_top, u32 vif_itop, u32 fbrst);
 
 	void VifUnpack(vifStruct& _vif, VIFregisters& _vifRegs, const u8* data, u32 size);
@@ -97,6 +123,9 @@ public:
 
 private:
 	void ExecuteRingBuffer();
+	void ExecutePipelined();
+	void ExecuteProgram(s32 addr);
+	void WaitPipeline();
 
 	void WaitOnSize(s32 size);
 	void ReserveSpace(s32 size);
@@ -111,7 +140,7 @@ private:
 
 	u32 Read();
 	void Read(void* dest, u32 size);
-	void ReadRegs(VIFregisters* dest);
+	void ReadRegs(VIFregisters* dest, bool tops);
 
 	void Write(u32 val);
 	void Write(const void* src, u32 size);
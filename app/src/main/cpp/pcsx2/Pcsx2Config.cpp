@@ -406,6 +406,7 @@ void Pcsx2Config::SpeedhackOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapBitBool(WaitLoop);
 	SettingsWrapBitBool(vuFlagHack);
 	SettingsWrapBitBool(vuThread);
+	SettingsWrapBitBool(vuThreadPipeline);
 	SettingsWrapBitBool(vu1Instant);
 
 	EECycleRate = std::clamp(EECycleRate, MIN_EE_CYCLE_RATE, MAX_EE_CYCLE_RATE);
@@ -454,6 +455,16 @@ Pcsx2Config::RecompilerOptions::RecompilerOptions()
 	EnableVU1 = true;
 	EnableFastmem = true;
 	PauseOnTLBMiss = false;
+	EnableEEBlockCache = false;
+	EnableEETieredCompile = false;
+	EnableEEReturnStack = false;
+	EnableEETraceFormation = false;
+	EnableEERegisterPinning = false;
+	EnableFastmemFaultHistory = false;
+	EnableVUProgramCache = false;
+	EnableIOPFastmem = true;
+	EnableIOPRegisterLiveness = true;
+	EnableJITCounters = false;
 
 	// vu and fpu clamping default to standard overflow.
 	vu0Overflow = true;
@@ -532,6 +543,16 @@ void Pcsx2Config::RecompilerOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapBitBool(EnableVU1);
 	SettingsWrapBitBool(EnableFastmem);
 	SettingsWrapBitBool(PauseOnTLBMiss);
+	SettingsWrapBitBool(EnableEEBlockCache);
+	SettingsWrapBitBool(EnableEETieredCompile);
+	SettingsWrapBitBool(EnableEEReturnStack);
+	SettingsWrapBitBool(EnableEETraceFormation);
+	SettingsWrapBitBool(EnableEERegisterPinning);
+	SettingsWrapBitBool(EnableFastmemFaultHistory);
+	SettingsWrapBitBool(EnableVUProgramCache);
+	SettingsWrapBitBool(EnableIOPFastmem);
+	SettingsWrapBitBool(EnableIOPRegisterLiveness);
+	SettingsWrapBitBool(EnableJITCounters);
 
 	SettingsWrapBitBool(vu0Overflow);
 	SettingsWrapBitBool(vu0ExtraOverflow);
@@ -737,6 +758,9 @@ Pcsx2Config::GSOptions::GSOptions()
 	HWSpinCPUForReadbacks = false;
 	GPUPaletteConversion = false;
 	AutoFlushSW = true;
+	SWTileBinning = false;
+	SWDrawPipeline = false;
+	SWCoarseZ = false;
 	PreloadFrameWithGSData = false;
 	Mipmap = true;
 	HWMipmap = true;
@@ -951,6 +975,9 @@ void Pcsx2Config::GSOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapBitBool(HWSpinCPUForReadbacks);
 	SettingsWrapBitBoolEx(GPUPaletteConversion, "paltex");
 	SettingsWrapBitBoolEx(AutoFlushSW, "autoflush_sw");
+	SettingsWrapBitBoolEx(SWTileBinning, "sw_tile_binning");
+	SettingsWrapBitBoolEx(SWDrawPipeline, "sw_draw_pipeline");
+	SettingsWrapBitBoolEx(SWCoarseZ, "sw_coarse_z");
 	SettingsWrapBitBoolEx(PreloadFrameWithGSData, "preload_frame_with_gs_data");
 	SettingsWrapBitBoolEx(Mipmap, "mipmap");
 	SettingsWrapBitBoolEx(ManualUserHacks, "UserHacks");
@@ -1894,6 +1921,7 @@ Pcsx2Config::Pcsx2Config()
 	bitset = 0;
 	// Set defaults for fresh installs / reset settings
 	McdFolderAutoManage = true;
+	CdvdPrefetchExtents = true;
 	EnablePatches = true;
 	EnableFastBoot = true;
 	EnableRecordingTools = true;
@@ -1916,6 +1944,8 @@ Pcsx2Config::Pcsx2Config()
 
 	GzipIsoIndexTemplate = "$(f).pindex.tmp";
 	PINESlot = 28011;
+	CdvdCacheSize = 16;
+	CdvdDecompressThreads = 0;
 	RtcYear = 0;
 	RtcMonth = 1;
 	RtcDay = 1;
@@ -1931,6 +1961,8 @@ void Pcsx2Config::LoadSaveCore(SettingsWrapper& wrap)
 	SettingsWrapBitBool(CdvdVerboseReads);
 	SettingsWrapBitBool(CdvdDumpBlocks);
 	SettingsWrapBitBool(CdvdPrecache);
+	SettingsWrapBitBool(CdvdPrefetchExtents);
+	SettingsWrapBitBool(CdvdTraceReads);
 	SettingsWrapBitBool(EnablePatches);
 	SettingsWrapBitBool(EnableCheats);
 	SettingsWrapBitBool(EnablePINE);
@@ -1972,6 +2004,8 @@ void Pcsx2Config::LoadSaveCore(SettingsWrapper& wrap)
 
 	SettingsWrapEntry(GzipIsoIndexTemplate);
 	SettingsWrapEntry(PINESlot);
+	SettingsWrapEntry(CdvdCacheSize);
+	SettingsWrapEntry(CdvdDecompressThreads);
 	SettingsWrapEntry(RtcYear);
 	SettingsWrapEntry(RtcMonth);
 	SettingsWrapEntry(RtcDay);
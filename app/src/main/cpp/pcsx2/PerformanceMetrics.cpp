@@ -13,6 +13,7 @@
 #include "GS/GSCapture.h"
 #include "MTGS.h"
 #include "MTVU.h"
+#include "R3000A.h"
 #include "VMManager.h"
 
 static const float UPDATE_INTERVAL = 0.5f;
@@ -50,6 +51,8 @@ static double s_cpu_thread_time = 0.0f;
 static float s_gs_thread_usage = 0.0f;
 static float s_gs_thread_time = 0.0f;
 static float s_vu_thread_usage = 0.0f;
+static VU_Thread::PipelineTimes s_last_vu_pipeline_times = {};
+static PerformanceMetrics::VUPipelineUsage s_vu_pipeline_usage = {};
 static float s_vu_thread_time = 0.0f;
 static float s_capture_thread_usage = 0.0f;
 static float s_capture_thread_time = 0.0f;
@@ -71,6 +74,15 @@ static float s_accumulated_gpu_time = 0.0f;
 static float s_gpu_usage = 0.0f;
 static u32 s_presents_since_last_update = 0;
 
+PerformanceMetrics::JITCounters PerformanceMetrics::g_jit_counters = {};
+static PerformanceMetrics::JITCounters s_last_jit_counters = {};
+static float s_ee_dispatches_per_frame = 0.0f;
+static float s_fastmem_faults_per_frame = 0.0f;
+static float s_iop_dispatches_per_frame = 0.0f;
+static float s_iop_cycles_per_frame = 0.0f;
+static u32 s_last_iop_cycle = 0;
+static float s_ee_return_stack_hit_rate = 0.0f;
+
 void PerformanceMetrics::Clear()
 {
 	Reset();
@@ -87,6 +99,7 @@ void PerformanceMetrics::Clear()
 	s_gs_thread_usage = 0.0f;
 	s_gs_thread_time = 0.0f;
 	s_vu_thread_usage = 0.0f;
+	s_vu_pipeline_usage = {};
 	s_vu_thread_time = 0.0f;
 	s_capture_thread_usage = 0.0f;
 	s_capture_thread_time = 0.0f;
@@ -94,6 +107,12 @@ void PerformanceMetrics::Clear()
 	s_average_gpu_time = 0.0f;
 	s_gpu_usage = 0.0f;
 
+	s_ee_dispatches_per_frame = 0.0f;
+	s_ee_return_stack_hit_rate = 0.0f;
+	s_fastmem_faults_per_frame = 0.0f;
+	s_iop_dispatches_per_frame = 0.0f;
+	s_iop_cycles_per_frame = 0.0f;
+
 	s_frame_number = 0;
 
 	s_frame_time_history.fill(0.0f);
@@ -119,8 +138,11 @@ void PerformanceMetrics::Reset()
 	s_last_cpu_time = s_cpu_thread_handle.GetCPUTime();
 	s_last_gs_time = MTGS::GetThreadHandle().GetCPUTime();
 	s_last_vu_time = THREAD_VU1 ? vu1Thread.GetThreadHandle().GetCPUTime() : 0;
+	s_last_vu_pipeline_times = vu1Thread.GetPipelineTimes();
 	s_last_ticks = GetCPUTicks();
 	s_last_capture_time = GSCapture::IsCapturing() ? GSCapture::GetEncoderThreadHandle().GetCPUTime() : 0;
+	s_last_jit_counters = g_jit_counters;
+	s_last_iop_cycle = psxRegs.cycle;
 
 	for (GSSWThreadStats& stat : s_gs_sw_threads)
 		stat.last_cpu_time = stat.handle.GetCPUTime();
@@ -206,6 +228,18 @@ void PerformanceMetrics::Update(bool gs_register_write, bool fb_blit, bool is_sk
 	s_cpu_thread_usage = static_cast<double>(cpu_delta) * pct_divider;
 	s_gs_thread_usage = static_cast<double>(gs_delta) * pct_divider;
 	s_vu_thread_usage = static_cast<double>(vu_delta) * pct_divider;
+
+	// Wall clock share of the interval, so overlap shows up as the parts adding up to more than the VU thread usage.
+	const VU_Thread::PipelineTimes vu_pipeline = vu1Thread.GetPipelineTimes();
+	const auto vu_pipeline_pct = [ticks_diff](u64 cur, u64 last) {
+		return static_cast<float>(static_cast<double>(cur - last) * 100.0 / static_cast<double>(ticks_diff));
+	};
+	s_vu_pipeline_usage.execute = vu_pipeline_pct(vu_pipeline.execute, s_last_vu_pipeline_times.execute);
+	s_vu_pipeline_usage.unpack = vu_pipeline_pct(vu_pipeline.unpack, s_last_vu_pipeline_times.unpack);
+	s_vu_pipeline_usage.overlap = vu_pipeline_pct(vu_pipeline.overlap, s_last_vu_pipeline_times.overlap);
+	s_vu_pipeline_usage.stall = vu_pipeline_pct(vu_pipeline.stall, s_last_vu_pipeline_times.stall);
+	s_vu_pipeline_usage.ee_wait = vu_pipeline_pct(vu_pipeline.ee_wait, s_last_vu_pipeline_times.ee_wait);
+	s_last_vu_pipeline_times = vu_pipeline;
 	s_capture_thread_usage = static_cast<double>(capture_delta) * pct_divider;
 	s_cpu_thread_time = static_cast<double>(cpu_delta) * time_divider;
 	s_gs_thread_time = static_cast<double>(gs_delta) * time_divider;
@@ -221,6 +255,24 @@ void PerformanceMetrics::Update(bool gs_register_write, bool fb_blit, bool is_sk
 		thread.time = static_cast<double>(delta) * time_divider;
 	}
 
+	// Counters are written by the EE thread without synchronization, a slightly torn read only skews one interval.
+	const JITCounters jit = g_jit_counters;
+	const u32 ee_return_hits = jit.ee_return_hits - s_last_jit_counters.ee_return_hits;
+	const u32 ee_return_total = ee_return_hits + (jit.ee_return_misses - s_last_jit_counters.ee_return_misses);
+	s_ee_dispatches_per_frame = static_cast<float>(jit.ee_dispatches - s_last_jit_counters.ee_dispatches) /
+								static_cast<float>(s_frames_since_last_update);
+	s_ee_return_stack_hit_rate = (ee_return_total > 0) ?
+									 (static_cast<float>(ee_return_hits) * 100.0f / static_cast<float>(ee_return_total)) :
+									 0.0f;
+	s_fastmem_faults_per_frame = static_cast<float>(jit.fastmem_faults - s_last_jit_counters.fastmem_faults) /
+								 static_cast<float>(s_frames_since_last_update);
+	s_iop_dispatches_per_frame = static_cast<float>(jit.iop_dispatches - s_last_jit_counters.iop_dispatches) /
+								 static_cast<float>(s_frames_since_last_update);
+	s_last_jit_counters = jit;
+
+	s_iop_cycles_per_frame = static_cast<float>(psxRegs.cycle - s_last_iop_cycle) / static_cast<float>(s_frames_since_last_update);
+	s_last_iop_cycle = psxRegs.cycle;
+
 	s_frames_since_last_update = 0;
 	s_unskipped_frames_since_last_update = 0;
 	s_presents_since_last_update = 0;
@@ -327,6 +379,11 @@ float PerformanceMetrics::GetVUThreadAverageTime()
 	return s_vu_thread_time;
 }
 
+const PerformanceMetrics::VUPipelineUsage& PerformanceMetrics::GetVUPipelineUsage()
+{
+	return s_vu_pipeline_usage;
+}
+
 float PerformanceMetrics::GetCaptureThreadUsage()
 {
 	return s_capture_thread_usage;
@@ -362,6 +419,31 @@ float PerformanceMetrics::GetGPUAverageTime()
 	return s_average_gpu_time;
 }
 
+float PerformanceMetrics::GetEEDispatchesPerFrame()
+{
+	return s_ee_dispatches_per_frame;
+}
+
+float PerformanceMetrics::GetEEReturnStackHitRate()
+{
+	return s_ee_return_stack_hit_rate;
+}
+
+float PerformanceMetrics::GetFastmemFaultsPerFrame()
+{
+	return s_fastmem_faults_per_frame;
+}
+
+float PerformanceMetrics::GetIOPDispatchesPerFrame()
+{
+	return s_iop_dispatches_per_frame;
+}
+
+float PerformanceMetrics::GetIOPCyclesPerFrame()
+{
+	return s_iop_cycles_per_frame;
+}
+
 const PerformanceMetrics::FrameTimeHistory& PerformanceMetrics::GetFrameTimeHistory()
 {
 	return s_frame_time_history;
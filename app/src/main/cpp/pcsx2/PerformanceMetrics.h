@@ -18,6 +18,19 @@ namespace PerformanceMetrics
 	static constexpr u32 NUM_FRAME_TIME_SAMPLES = 150;
 	using FrameTimeHistory = std::array<float, NUM_FRAME_TIME_SAMPLES>;
 
+	/// Free-running counters bumped by recompiled code and the recompiler's helpers. They're 32-bit so
+	/// the JIT can update them with a single add, per-frame rates are computed from the difference at each update.
+	/// The recompilers only emit the adds when Recompiler.EnableJITCounters is set.
+	struct JITCounters
+	{
+		u32 ee_dispatches; // lookups through DispatcherReg
+		u32 ee_return_hits; // JR RA resolved by the return stack
+		u32 ee_return_misses; // JR RA where the predicted return address didn't match
+		u32 fastmem_faults; // fastmem loads/stores backpatched from the fault handler
+		u32 iop_dispatches; // lookups through the IOP DispatcherReg
+	};
+	extern JITCounters g_jit_counters;
+
 	void Clear();
 	void Reset();
 	void Update(bool gs_register_write, bool fb_blit, bool is_skipping_present);
@@ -48,6 +61,17 @@ namespace PerformanceMetrics
 	float GetGSThreadAverageTime();
 	float GetVUThreadUsage();
 	float GetVUThreadAverageTime();
+
+	/// Share of wall clock time spent in each VU1 stage, see VU_Thread::PipelineTimes.
+	struct VUPipelineUsage
+	{
+		float execute;
+		float unpack;
+		float overlap;
+		float stall;
+		float ee_wait;
+	};
+	const VUPipelineUsage& GetVUPipelineUsage();
 	float GetCaptureThreadUsage();
 	float GetCaptureThreadAverageTime();
 
@@ -58,6 +82,12 @@ namespace PerformanceMetrics
 	float GetGPUUsage();
 	float GetGPUAverageTime();
 
+	float GetEEDispatchesPerFrame();
+	float GetEEReturnStackHitRate();
+	float GetFastmemFaultsPerFrame();
+	float GetIOPDispatchesPerFrame();
+	float GetIOPCyclesPerFrame();
+
 	const FrameTimeHistory& GetFrameTimeHistory();
 	u32 GetFrameTimeHistoryPos();
 } // namespace PerformanceMetrics
@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "Config.h"
+#include "PersistentCache.h"
+
+#include "common/Console.h"
+#include "common/Path.h"
+
+#include "fmt/format.h"
+
+std::string PersistentCache::GetGamePath(std::string_view subdir, const std::string& serial, u32 crc, std::string_view suffix)
+{
+	return Path::Combine(EmuFolders::Cache,
+		fmt::format("{}/{}_{:08X}{}.bin", subdir, serial.empty() ? std::string_view("ELF") : std::string_view(serial), crc, suffix));
+}
+
+bool PersistentCache::Reader::Open(const std::string& path, u32 signature, u32 version)
+{
+	m_fp = FileSystem::OpenManagedCFile(path.c_str(), "rb");
+	if (!m_fp)
+		return false;
+
+	const s64 size = FileSystem::FSize64(m_fp.get());
+	m_remaining = (size > 0) ? static_cast<u64>(size) : 0;
+
+	u32 header[3];
+	if (!ReadBytes(header, 1, sizeof(header)) || header[0] != signature || header[1] != version)
+	{
+		Console.Warning("Ignoring invalid cache file '%s'", path.c_str());
+		m_fp.reset();
+		return false;
+	}
+
+	m_count = header[2];
+	return true;
+}
+
+bool PersistentCache::Reader::CanRead(u64 count, u64 size) const
+{
+	return (m_fp && size != 0 && count <= m_remaining / size);
+}
+
+bool PersistentCache::Reader::ReadBytes(void* dst, u64 count, u64 size)
+{
+	if (!CanRead(count, size) || (count > 0 && std::fread(dst, size, count, m_fp.get()) != count))
+		return false;
+
+	m_remaining -= count * size;
+	return true;
+}
+
+bool PersistentCache::Writer::Open(const std::string& path, u32 signature, u32 version, u32 count)
+{
+	if (!FileSystem::EnsureDirectoryExists(std::string(Path::GetDirectory(path)).c_str(), true))
+		return false;
+
+	m_fp = FileSystem::OpenManagedCFile(path.c_str(), "wb");
+	const u32 header[3] = {signature, version, count};
+	return (m_fp && WriteBytes(header, 1, sizeof(header)));
+}
+
+bool PersistentCache::Writer::WriteBytes(const void* src, u64 count, u64 size)
+{
+	return (m_fp && (count == 0 || std::fwrite(src, size, count, m_fp.get()) == count));
+}
@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "common/FileSystem.h"
+#include "common/Pcsx2Defs.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Small per-game files the recompilers use to warm up faster on the next boot.
+//
+// Emitted code references host helpers and state through absolute addresses without any
+// relocation records, so it can't be reused across process launches. These files only hold
+// what is needed to rebuild it (block layouts, selectors, faulting pcs), which the owner
+// validates against the guest before use.
+//
+// Every file starts with a signature, a version and an item count, the rest is up to the owner.
+namespace PersistentCache
+{
+	/// Returns <cache>/<subdir>/<serial>_<crc><suffix>.bin, executables without a serial use "ELF".
+	std::string GetGamePath(std::string_view subdir, const std::string& serial, u32 crc, std::string_view suffix = {});
+
+	class Reader
+	{
+	public:
+		/// Opens the file and checks its header. A missing file fails quietly, a bad header is logged.
+		bool Open(const std::string& path, u32 signature, u32 version);
+
+		/// Number of items the header claims the file holds.
+		u32 GetCount() const { return m_count; }
+
+		template <typename T>
+		bool Read(T* value)
+		{
+			return ReadBytes(value, 1, sizeof(T));
+		}
+
+		/// Reads count items, failing without allocating if the rest of the file can't hold them.
+		template <typename T>
+		bool ReadArray(std::vector<T>* values, u32 count)
+		{
+			if (!CanRead(count, sizeof(T)))
+				return false;
+
+			values->resize(count);
+			return ReadBytes(values->data(), count, sizeof(T));
+		}
+
+	private:
+		bool CanRead(u64 count, u64 size) const;
+		bool ReadBytes(void* dst, u64 count, u64 size);
+
+		FileSystem::ManagedCFilePtr m_fp;
+		u64 m_remaining = 0;
+		u32 m_count = 0;
+	};
+
+	class Writer
+	{
+	public:
+		/// Creates the file (and its directory) and writes the header.
+		bool Open(const std::string& path, u32 signature, u32 version, u32 count);
+
+		template <typename T>
+		bool Write(const T& value)
+		{
+			return WriteBytes(&value, 1, sizeof(T));
+		}
+
+		template <typename T>
+		bool WriteArray(const std::vector<T>& values)
+		{
+			return WriteBytes(values.data(), values.size(), sizeof(T));
+		}
+
+	private:
+		bool WriteBytes(const void* src, u64 count, u64 size);
+
+		FileSystem::ManagedCFilePtr m_fp;
+	};
+} // namespace PersistentCache
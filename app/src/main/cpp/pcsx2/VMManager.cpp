@@ -2361,7 +2361,7 @@ bool VMManager::IsBlockDumpFileName(const std::string_view path)
 bool VMManager::IsGSDumpFileName(const std::string_view path)
 {
 	return (StringUtil::EndsWithNoCase(path, ".gs") || StringUtil::EndsWithNoCase(path, ".gs.xz") ||
-			StringUtil::EndsWithNoCase(path, ".gs.zst"));
+			StringUtil::EndsWithNoCase(path, ".gs.zst") || StringUtil::EndsWithNoCase(path, ".gs.zsc"));
 }
 
 bool VMManager::IsSaveStateFileName(const std::string_view path)
@@ -2379,7 +2379,8 @@ bool VMManager::IsDiscFileName(const std::string_view path)
 			return true;
 	}
 
-	return false;
+	// Seekable zstd images, which share their extension with zstd GS dumps.
+	return StringUtil::EndsWithNoCase(path, ".zst") && !IsGSDumpFileName(path);
 }
 
 bool VMManager::IsLoadableFileName(const std::string_view path)
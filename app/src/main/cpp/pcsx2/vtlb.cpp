@@ -23,6 +23,8 @@
 #include "IopMem.h"
 #include "Host.h"
 #include "VMManager.h"
+#include "PerformanceMetrics.h"
+#include "PersistentCache.h"
 
 #include "common/BitUtils.h"
 #include "common/Error.h"
@@ -83,6 +85,15 @@ static std::unordered_multimap<u32, u32> s_fastmem_physical_mapping; // maps mai
 static std::unordered_map<uptr, LoadstoreBackpatchInfo> s_fastmem_backpatch_info;
 static std::unordered_set<u32> s_fastmem_faulting_pcs;
 
+// Guest pcs which faulted in this or a previous session of the current game. Unlike the set above,
+// this survives recompiler resets, so the loadstores are emitted with the inline TLB lookup straight
+// away instead of each one taking a SIGSEGV round trip every time its block is rebuilt.
+static constexpr u32 FAULT_HISTORY_SIGNATURE = 0x48464D46; // FMFH
+static constexpr u32 FAULT_HISTORY_VERSION = 1;
+static std::unordered_set<u32> s_fastmem_fault_history;
+static std::string s_fastmem_fault_history_path;
+static bool s_fastmem_fault_history_dirty = false;
+
 vtlb_private::VTLBPhysical vtlb_private::VTLBPhysical::fromPointer(sptr ptr)
 {
 	pxAssertMsg(ptr >= 0, "Address too high");
@@ -1194,12 +1205,68 @@ bool vtlb_BackpatchLoadStore(uptr code_address, uptr fault_address)
 	// and store the pc in the faulting list, so that we don't emit another fastmem loadstore
 	s_fastmem_faulting_pcs.insert(info.guest_pc);
 	s_fastmem_backpatch_info.erase(iter);
+	PerformanceMetrics::g_jit_counters.fastmem_faults++;
+
+	if (!s_fastmem_fault_history_path.empty() && s_fastmem_fault_history.insert(info.guest_pc).second)
+		s_fastmem_fault_history_dirty = true;
+
 	return true;
 }
 
 bool vtlb_IsFaultingPC(u32 guest_pc)
 {
-	return (s_fastmem_faulting_pcs.find(guest_pc) != s_fastmem_faulting_pcs.end());
+	return (s_fastmem_faulting_pcs.find(guest_pc) != s_fastmem_faulting_pcs.end() ||
+			s_fastmem_fault_history.find(guest_pc) != s_fastmem_fault_history.end());
+}
+
+void vtlb_OpenFaultHistory(const std::string& serial, u32 crc)
+{
+	std::string path = PersistentCache::GetGamePath("fastmem", serial, crc);
+	if (path == s_fastmem_fault_history_path)
+		return;
+
+	vtlb_CloseFaultHistory();
+	s_fastmem_fault_history_path = std::move(path);
+
+	PersistentCache::Reader reader;
+	if (!reader.Open(s_fastmem_fault_history_path, FAULT_HISTORY_SIGNATURE, FAULT_HISTORY_VERSION))
+		return;
+
+	std::vector<u32> pcs;
+	if (!reader.ReadArray(&pcs, reader.GetCount()))
+	{
+		Console.Warning("(vtlb) Truncated fastmem fault history '%s'", s_fastmem_fault_history_path.c_str());
+		return;
+	}
+
+	s_fastmem_fault_history.insert(pcs.begin(), pcs.end());
+	Console.WriteLn("(vtlb) Loaded %zu known faulting fastmem loadstores", s_fastmem_fault_history.size());
+}
+
+void vtlb_SaveFaultHistory()
+{
+	if (!s_fastmem_fault_history_dirty || s_fastmem_fault_history_path.empty())
+		return;
+
+	const std::vector<u32> pcs(s_fastmem_fault_history.begin(), s_fastmem_fault_history.end());
+	PersistentCache::Writer writer;
+	if (!writer.Open(s_fastmem_fault_history_path, FAULT_HISTORY_SIGNATURE, FAULT_HISTORY_VERSION, static_cast<u32>(pcs.size())) ||
+		!writer.WriteArray(pcs))
+	{
+		Console.Error("(vtlb) Failed to write fastmem fault history '%s'", s_fastmem_fault_history_path.c_str());
+		return;
+	}
+
+	DevCon.WriteLn("(vtlb) Saved %zu faulting fastmem loadstores", pcs.size());
+	s_fastmem_fault_history_dirty = false;
+}
+
+void vtlb_CloseFaultHistory()
+{
+	vtlb_SaveFaultHistory();
+	s_fastmem_fault_history.clear();
+	s_fastmem_fault_history_path.clear();
+	s_fastmem_fault_history_dirty = false;
 }
 
 //virtual mappings
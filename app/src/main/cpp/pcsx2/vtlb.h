@@ -6,6 +6,8 @@
 #include "vtlbDef.h"
 #include "common/HostSys.h"
 
+#include <string>
+
 static const uptr VTLB_AllocUpperBounds = _1gb * 2;
 
 extern bool vtlb_Core_Alloc();
@@ -49,6 +51,9 @@ extern void vtlb_ClearLoadStoreInfo();
 extern void vtlb_AddLoadStoreInfo(uptr code_address, u32 code_size, u32 guest_pc, u32 gpr_bitmask, u32 fpr_bitmask, u8 address_register, u8 data_register, u8 size_in_bits, bool is_signed, bool is_load, bool is_fpr);
 extern void vtlb_DynBackpatchLoadStore(uptr code_address, u32 code_size, u32 guest_pc, u32 guest_addr, u32 gpr_bitmask, u32 fpr_bitmask, u8 address_register, u8 data_register, u8 size_in_bits, bool is_signed, bool is_load, bool is_fpr);
 extern bool vtlb_IsFaultingPC(u32 guest_pc);
+extern void vtlb_OpenFaultHistory(const std::string& serial, u32 crc);
+extern void vtlb_SaveFaultHistory();
+extern void vtlb_CloseFaultHistory();
 
 //Memory functions
 
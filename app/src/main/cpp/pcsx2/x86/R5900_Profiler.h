@@ -216,6 +216,8 @@ static const char eeOpcodeName[][16] = {
 #include <utility>
 #include <algorithm>
 
+#include "x86/iR5900BlockCache.h"
+
 #if !defined(__ANDROID__)
 using namespace x86Emitter;
 #endif
@@ -230,6 +232,8 @@ struct eeProfiler
 	u64 memStatsSlow;
 	u64 memStatsFast;
 	u32 memMask;
+	u64 regStatsLoad;
+	u64 regStatsStore;
 
 	void Reset()
 	{
@@ -238,6 +242,8 @@ struct eeProfiler
 		std::memset(memStatsConst, 0, sizeof(memStatsConst));
 		memStatsSlow = 0;
 		memStatsFast = 0;
+		regStatsLoad = 0;
+		regStatsStore = 0;
 		memMask = 0xF700FFF0;
 		pxAssert(eeOpcodeName[static_cast<int>(eeOpcode::LAST)][0] == '!');
 	}
@@ -279,6 +285,7 @@ struct eeProfiler
 				break;
 		}
 		//DevCon.WriteLn("Total = 0x%x_%x", (u32)(u64)(total>>32),(u32)total);
+		const u64 total_ops = total;
 
 		// Compute memory stat
 		total = 0;
@@ -364,6 +371,12 @@ struct eeProfiler
 			if (stat < 0.01)
 				break;
 		}
+
+		const EE::BlockCache::Stats& bc = EE::BlockCache::GetStats();
+		DevCon.WriteLn("\nEE Block Cache: preloaded=%u stale=%u cold=%u", bc.preloaded, bc.stale, bc.cold);
+
+		DevCon.WriteLn("EE GPR traffic: loads=%llu stores=%llu (%3.4f%% of executed ops)",
+			regStatsLoad, regStatsStore, per(regStatsLoad + regStatsStore, total_ops));
 	}
 
 	// Warning dirty ebx
@@ -398,6 +411,19 @@ struct eeProfiler
 		xADD(ptr32[(u32*)&memStatsFast], 1);
 		xADC(ptr32[(u32*)&memStatsFast + 1], 0);
 	}
+
+	// Counts executed loads/stores of guest GPRs to cpuRegs made by the register allocator.
+	// Only touches the vixl scratch registers, these can be emitted between any two instructions.
+	void EmitRegCounter(u64* counter)
+	{
+		armMoveAddressToReg(RSCRATCHADDR, counter);
+		armAsm->Ldr(RXVIXLSCRATCH, a64::MemOperand(RSCRATCHADDR));
+		armAsm->Add(RXVIXLSCRATCH, RXVIXLSCRATCH, 1);
+		armAsm->Str(RXVIXLSCRATCH, a64::MemOperand(RSCRATCHADDR));
+	}
+
+	void EmitRegLoad() { EmitRegCounter(&regStatsLoad); }
+	void EmitRegStore() { EmitRegCounter(&regStatsStore); }
 };
 #else
 struct eeProfiler
@@ -409,6 +435,8 @@ struct eeProfiler
 	__fi void EmitConstMem(u32 add) {}
 	__fi void EmitSlowMem() {}
 	__fi void EmitFastMem() {}
+	__fi void EmitRegLoad() {}
+	__fi void EmitRegStore() {}
 };
 #endif
 
@@ -227,6 +227,12 @@ extern u32 _recIsRegReadOrWritten(EEINST* pinst, int size, u8 xmmtype, u8 reg);
 
 extern void _recFillRegister(EEINST& pinst, int type, int reg, int write);
 
+// Chooses the guest GPRs to keep in callee-saved host registers for the whole block.
+extern void _pinHotGPRs(const EEINST* inst_cache, u32 count);
+
+// Lets IOP guest registers which are used later in the block stay in callee-saved host registers.
+extern void _enablePSXLiveRegs();
+
 // If unset, values which are not live will not be written back to memory.
 // Tends to break stuff at the moment.
 #define EE_WRITE_DEAD_VALUES 1
@@ -9,6 +9,7 @@
 #include "IopHw.h"
 #include "Common.h"
 #include "VMManager.h"
+#include "PerformanceMetrics.h"
 
 #include <time.h>
 
@@ -154,7 +155,7 @@ static void iopRecRecompile(u32 startpc);
 
 static const void* iopDispatcherEvent = nullptr;
 static const void* iopDispatcherReg = nullptr;
-static const void* iopJITCompile = nullptr;
+const void* iopJITCompile = nullptr;
 static const void* iopEnterRecompiledCode = nullptr;
 static const void* iopExitRecompiledCode = nullptr;
 
@@ -201,6 +202,9 @@ static const void* _DynGen_DispatcherReg()
 //	u8* retval = xGetPtr();
     u8* retval = armGetCurrentCodePointer();
 
+    if (CHECK_JITCOUNTERS)
+        armAdd(&PerformanceMetrics::g_jit_counters.iop_dispatches, 1);
+
 //	xMOV(eax, ptr[&psxRegs.pc]);
 //	xMOV(ebx, eax);
 //	xSHR(eax, 16);
@@ -631,11 +635,11 @@ void psxRecompileCodeConst0(R3000AFNPTR constcode, R3000AFNPTR_INFO constscode,
 	const bool t_is_used = EEINST_USEDTEST(_Rt_);
 
 	if (!s_is_const)
-		_addNeededGPRtoX86reg(_Rs_);
+		_addNeededPSXtoX86reg(_Rs_);
 	if (!t_is_const)
-		_addNeededGPRtoX86reg(_Rt_);
+		_addNeededPSXtoX86reg(_Rt_);
 	if (!d_is_const)
-		_addNeededGPRtoX86reg(_Rd_);
+		_addNeededPSXtoX86reg(_Rd_);
 
 	u32 info = 0;
 	int regs = _checkX86reg(X86TYPE_PSX, _Rs_, MODE_READ);
@@ -837,9 +841,9 @@ void psxRecompileCodeConst3(R3000AFNPTR constcode, R3000AFNPTR_INFO constscode,
 	const bool t_is_used = EEINST_USEDTEST(_Rt_);
 
 	if (!s_is_const)
-		_addNeededGPRtoX86reg(_Rs_);
+		_addNeededPSXtoX86reg(_Rs_);
 	if (!t_is_const)
-		_addNeededGPRtoX86reg(_Rt_);
+		_addNeededPSXtoX86reg(_Rt_);
 	if (LOHI)
 	{
 		if (EEINST_LIVETEST(PSX_LO))
@@ -1729,6 +1733,8 @@ static void iopRecRecompile(const u32 startpc)
 	g_psxHasConstReg = g_psxFlushedConstReg = 1;
 
 	_initX86regs();
+	if (CHECK_IOPREGLIVENESS)
+		_enablePSXLiveRegs();
 
 	if ((psxHu32(HW_ICFG) & 8) && (HWADDR(startpc) == 0xa0 || HWADDR(startpc) == 0xb0 || HWADDR(startpc) == 0xc0))
 	{
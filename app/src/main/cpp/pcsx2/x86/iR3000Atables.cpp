@@ -1484,22 +1484,88 @@ static void rpsxLW()
 	rpsxLoad(32, false);
 }
 
-static void rpsxSB()
+// Stores to IOP RAM are done inline when the page is writable (cache isn't isolated) and
+// no recompiled block starts at the target word, everything else goes through iopMemWrite.
+static void rpsxStore(int size)
 {
 	rpsxCalcAddressOperand();
 	rpsxCalcStoreOperand();
 	_psxFlushCall(FLUSH_FULLVTLB);
-//	xFastCall((void*)iopMemWrite8);
-    armEmitCall(reinterpret_cast<void*>(iopMemWrite8));
+
+	a64::Label slow_write, done;
+	if (CHECK_IOPFASTMEM)
+	{
+		// Only the RAM mirrors (0x00000000-0x007fffff) in the 0x0000, 0x8000 and 0xa000 segments,
+		// the ones iopMemReset() maps, are written inline.
+		a64::Label ram_segment;
+		armAsm->Tst(EAX, 0x1f800000);
+		armAsm->B(&slow_write, a64::Condition::ne);
+		armAsm->Lsr(a64::w3, EAX, 29);
+		armAsm->Cbz(a64::w3, &ram_segment);
+		armAsm->Sub(a64::w3, a64::w3, 0x80000000u >> 29);
+		armAsm->Cmp(a64::w3, (0xa0000000u >> 29) - (0x80000000u >> 29));
+		armAsm->B(&slow_write, a64::Condition::hi);
+		armBind(&ram_segment);
+		armLoad(EDX, PTR_CPU(psxRegs.CP0.n.Status));
+		armAsm->Tbnz(EDX, 16, &slow_write);
+
+		// same check as psxRecClearMem(), on the RAM mirror the block would be in
+		armAsm->And(EDX, EAX, 0x1ffffc);
+		armAsm->Lsr(a64::w3, EDX, 16);
+		armAsm->Ldr(a64::x3, a64::MemOperand(RSTATE_x29, a64::x3, a64::LSL, 3));
+		armAsm->Ldr(a64::x3, a64::MemOperand(a64::x3, RDX, a64::LSL, 1));
+		armMoveAddressToReg(REX, iopJITCompile);
+		armAsm->Cmp(a64::x3, REX);
+		armAsm->B(&slow_write, a64::Condition::ne);
+
+		armAsm->And(EDX, EAX, 0x1fffff);
+		const auto addr = a64::MemOperand(RSTATE_x26, RDX);
+		switch (size)
+		{
+			case 8:
+				armAsm->Strb(ECX, addr);
+				break;
+			case 16:
+				armAsm->Strh(ECX, addr);
+				break;
+			case 32:
+				armAsm->Str(ECX, addr);
+				break;
+
+				jNO_DEFAULT
+		}
+		armAsm->B(&done);
+	}
+
+	armBind(&slow_write);
+	switch (size)
+	{
+		case 8:
+//			xFastCall((void*)iopMemWrite8);
+			armEmitCall(reinterpret_cast<void*>(iopMemWrite8));
+			break;
+		case 16:
+//			xFastCall((void*)iopMemWrite16);
+			armEmitCall(reinterpret_cast<void*>(iopMemWrite16));
+			break;
+		case 32:
+//			xFastCall((void*)iopMemWrite32);
+			armEmitCall(reinterpret_cast<void*>(iopMemWrite32));
+			break;
+
+			jNO_DEFAULT
+	}
+	armBind(&done);
+}
+
+static void rpsxSB()
+{
+	rpsxStore(8);
 }
 
 static void rpsxSH()
 {
-	rpsxCalcAddressOperand();
-	rpsxCalcStoreOperand();
-	_psxFlushCall(FLUSH_FULLVTLB);
-//	xFastCall((void*)iopMemWrite16);
-    armEmitCall(reinterpret_cast<void*>(iopMemWrite16));
+	rpsxStore(16);
 }
 
 static void rpsxSW()
@@ -1513,11 +1579,7 @@ static void rpsxSW()
 		return;
 	}
 
-	rpsxCalcAddressOperand();
-	rpsxCalcStoreOperand();
-	_psxFlushCall(FLUSH_FULLVTLB);
-//	xFastCall((void*)iopMemWrite32);
-    armEmitCall(reinterpret_cast<void*>(iopMemWrite32));
+	rpsxStore(32);
 }
 
 //// SLL
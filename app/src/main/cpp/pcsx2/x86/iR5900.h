@@ -69,6 +69,10 @@ void recompileNextInstruction(bool delayslot, bool swapped_delay_slot);
 void SetBranchReg(u32 reg);
 void SetBranchImm(u32 imm);
 
+// Return stack hints, picked up by the SetBranchImm/SetBranchReg which ends the block.
+void recPushReturnAddress(u32 retpc);
+void recPredictReturn();
+
 void iFlushCall(int flushtype);
 void recBranchCall(void (*func)());
 void recCall(void (*func)());
@@ -0,0 +1,174 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "Common.h"
+#include "Memory.h"
+#include "PersistentCache.h"
+#include "x86/iR5900BlockCache.h"
+
+#include "common/Console.h"
+
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+#define XXH_STATIC_LINKING_ONLY 1
+#define XXH_INLINE_ALL 1
+#include <xxhash.h>
+
+namespace EE::BlockCache
+{
+	enum : u32
+	{
+		CACHE_FILE_SIGNATURE = 0x4B4C4245, // EBLK
+		CACHE_FILE_VERSION = 1,
+
+		// Blocks never cross a 4K page, so none can be longer than this.
+		MAX_BLOCK_INSTRUCTIONS = 0x1000 / sizeof(u32),
+	};
+
+	struct CachedBlock
+	{
+		u32 startpc;
+		u32 size;
+		u64 hash;
+	};
+	static_assert(sizeof(CachedBlock) == 16);
+
+	static u64 HashGuestCode(u32 startpc, u32 size);
+	static bool IsCacheableRange(u32 startpc, u32 size);
+	static bool Load();
+
+	static std::unordered_map<u32, CachedBlock> s_blocks;
+	static std::string s_path;
+	static bool s_dirty = false;
+	static Stats s_stats = {};
+} // namespace EE::BlockCache
+
+u64 EE::BlockCache::HashGuestCode(u32 startpc, u32 size)
+{
+	return XXH3_64bits(PSM(startpc), size * sizeof(u32));
+}
+
+bool EE::BlockCache::IsCacheableRange(u32 startpc, u32 size)
+{
+	// Only main RAM is worth caching, the BIOS has already run by the time the ELF starts.
+	// Sizes come from the cache file as well, so they're bounded before anything is hashed.
+	if (size == 0 || size > MAX_BLOCK_INSTRUCTIONS)
+		return false;
+
+	const u64 phys_start = startpc & 0x1fffffff;
+	const u64 phys_end = phys_start + static_cast<u64>(size) * sizeof(u32);
+	return (phys_end <= Ps2MemSize::ExposedRam && PSM(startpc) != nullptr);
+}
+
+bool EE::BlockCache::Load()
+{
+	PersistentCache::Reader reader;
+	if (!reader.Open(s_path, CACHE_FILE_SIGNATURE, CACHE_FILE_VERSION))
+		return false;
+
+	std::vector<CachedBlock> blocks;
+	if (!reader.ReadArray(&blocks, reader.GetCount()))
+	{
+		Console.Warning("(EE BlockCache) Truncated cache file '%s'", s_path.c_str());
+		return false;
+	}
+
+	for (const CachedBlock& block : blocks)
+		s_blocks.emplace(block.startpc, block);
+
+	return true;
+}
+
+std::vector<u32> EE::BlockCache::Open(const std::string& serial, u32 crc)
+{
+	std::string path = PersistentCache::GetGamePath("eerec", serial, crc);
+	if (path != s_path)
+	{
+		Close();
+		s_path = std::move(path);
+		Load();
+	}
+
+	std::vector<u32> valid;
+	valid.reserve(s_blocks.size());
+	s_stats.stale = 0;
+	for (const auto& it : s_blocks)
+	{
+		// Overlays which haven't been loaded yet (or were replaced) show up as stale here.
+		// They're kept in the cache, if they're compiled again later they'll be refreshed.
+		const CachedBlock& block = it.second;
+		if (IsCacheableRange(block.startpc, block.size) && HashGuestCode(block.startpc, block.size) == block.hash)
+			valid.push_back(block.startpc);
+		else
+			s_stats.stale++;
+	}
+
+	// Compile from the highest address down, so that blocks which were originally cut short by an
+	// already compiled successor are split at the same place again.
+	std::sort(valid.begin(), valid.end(), std::greater<u32>());
+	s_stats.preloaded = static_cast<u32>(valid.size());
+	Console.WriteLn("(EE BlockCache) %zu cached blocks, %u valid, %u stale", s_blocks.size(), s_stats.preloaded, s_stats.stale);
+	return valid;
+}
+
+void EE::BlockCache::Record(u32 startpc, u32 size)
+{
+	if (s_path.empty() || !IsCacheableRange(startpc, size))
+		return;
+
+	const CachedBlock block = {startpc, size, HashGuestCode(startpc, size)};
+	auto it = s_blocks.find(startpc);
+	if (it != s_blocks.end())
+	{
+		if (it->second.size == block.size && it->second.hash == block.hash)
+			return;
+
+		it->second = block;
+	}
+	else
+	{
+		s_blocks.emplace(startpc, block);
+	}
+
+	s_stats.cold++;
+	s_dirty = true;
+}
+
+void EE::BlockCache::Save()
+{
+	if (!s_dirty || s_path.empty())
+		return;
+
+	std::vector<CachedBlock> blocks;
+	blocks.reserve(s_blocks.size());
+	for (const auto& it : s_blocks)
+		blocks.push_back(it.second);
+
+	PersistentCache::Writer writer;
+	if (!writer.Open(s_path, CACHE_FILE_SIGNATURE, CACHE_FILE_VERSION, static_cast<u32>(blocks.size())) ||
+		!writer.WriteArray(blocks))
+	{
+		Console.Error("(EE BlockCache) Failed to write '%s'", s_path.c_str());
+		return;
+	}
+
+	DevCon.WriteLn("(EE BlockCache) Saved %zu blocks [preloaded=%u stale=%u cold=%u]", blocks.size(),
+		s_stats.preloaded, s_stats.stale, s_stats.cold);
+	s_dirty = false;
+}
+
+void EE::BlockCache::Close()
+{
+	Save();
+	s_blocks.clear();
+	s_path.clear();
+	s_dirty = false;
+	s_stats = {};
+}
+
+const EE::BlockCache::Stats& EE::BlockCache::GetStats()
+{
+	return s_stats;
+}
@@ -0,0 +1,40 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "common/Pcsx2Defs.h"
+
+#include <string>
+#include <vector>
+
+// Persistent per-game record of the EE blocks the recompiler has built.
+//
+// Holds the block layout (start pc, length) together with a hash of the guest instructions each
+// block was built from. On the next boot of the same game, blocks whose guest code still matches
+// are compiled in one go when the ELF entry point is reached, rather than trickling in through
+// JITCompile during the first minutes of gameplay.
+namespace EE::BlockCache
+{
+	struct Stats
+	{
+		u32 preloaded; // blocks validated and compiled at the entry point
+		u32 stale;     // cached blocks whose guest code no longer matched
+		u32 cold;      // blocks compiled on demand after the preload
+	};
+
+	/// Switches to the cache for the currently running ELF, saving the previous one if needed.
+	/// Returns the virtual start pcs of every cached block whose guest code still matches memory.
+	std::vector<u32> Open(const std::string& serial, u32 crc);
+
+	/// Records a freshly compiled block. size is in instructions.
+	void Record(u32 startpc, u32 size);
+
+	/// Writes the current cache to disk if it has changed since the last save.
+	void Save();
+
+	/// Saves and forgets the current cache.
+	void Close();
+
+	const Stats& GetStats();
+} // namespace EE::BlockCache
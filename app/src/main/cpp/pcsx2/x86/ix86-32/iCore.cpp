@@ -21,6 +21,20 @@ extern u32 g_psxConstRegs[32];
 // X86 caching
 static uint g_x86checknext;
 
+// Block-wide pinning of hot guest GPRs. Pinned GPRs are always allocated to the same callee-saved
+// host register, so they survive the helper calls behind iFlushCall() and only get spilled when
+// the block ends or falls back to the interpreter. x19-x21 are left for MODE_CALLEESAVED temps
+// and the PC writeback.
+static constexpr int s_pinHostRegs[] = {22, 23, 24};
+static constexpr u32 PIN_MIN_USES = 3;
+static s8 s_pinnedHostReg[32]; // guest GPR -> host reg, -1 if not pinned
+static s8 s_pinnedGuestReg[iREGCNT_GPR]; // host reg -> guest GPR, -1 if not reserved
+
+// Liveness-aware allocation for the IOP. The IOP never pins, so the same callee-saved host registers
+// go to PSX guest registers which are still used later in the block (EEINST_USEDTEST), keeping them
+// across the helper calls behind IOP loads and stores. Evictions prefer registers with no further use.
+static bool s_psxLiveRegs;
+
 // use special x86 register allocation for ia32
 
 void _initX86regs()
@@ -28,6 +42,92 @@ void _initX86regs()
 	std::memset(x86regs, 0, sizeof(x86regs));
 	g_x86AllocCounter = 0;
 	g_x86checknext = 0;
+
+	std::memset(s_pinnedHostReg, -1, sizeof(s_pinnedHostReg));
+	std::memset(s_pinnedGuestReg, -1, sizeof(s_pinnedGuestReg));
+	s_psxLiveRegs = false;
+}
+
+void _enablePSXLiveRegs()
+{
+	s_psxLiveRegs = true;
+}
+
+// True if evicting the host register won't cost a reload later in the block.
+static bool _isX86regDeadPSX(int x86reg)
+{
+	return s_psxLiveRegs && x86regs[x86reg].type == X86TYPE_PSX && !EEINST_USEDTEST(x86regs[x86reg].reg);
+}
+
+// Returns a callee-saved host register for a PSX guest register that is used later in the block,
+// or -1 if they all hold registers that are still needed.
+static int _getFreePSXLiveReg()
+{
+	int victim = -1;
+	for (const int hostreg : s_pinHostRegs)
+	{
+		if (s_pinnedGuestReg[hostreg] >= 0)
+			continue;
+
+		if (!x86regs[hostreg].inuse)
+			return hostreg;
+
+		if (victim < 0 && !x86regs[hostreg].needed && _isX86regDeadPSX(hostreg))
+			victim = hostreg;
+	}
+
+	if (victim >= 0)
+	{
+		RALOG("Evicting dead PSX reg %d from host reg %d\n", x86regs[victim].reg, victim);
+		_freeX86reg(victim);
+	}
+
+	return victim;
+}
+
+void _pinHotGPRs(const EEINST* inst_cache, u32 count)
+{
+	u32 uses[32] = {};
+	u32 wide = 0;
+
+	for (u32 i = 0; i < count; i++)
+	{
+		const EEINST& inst = inst_cache[i];
+		for (u32 j = 0; j < std::size(inst.readType); j++)
+		{
+			if (inst.readType[j] == XMMTYPE_GPRREG && inst.readReg[j] < 32)
+				uses[inst.readReg[j]]++;
+		}
+		for (u32 j = 0; j < std::size(inst.writeType); j++)
+		{
+			if (inst.writeType[j] == XMMTYPE_GPRREG && inst.writeReg[j] < 32)
+				uses[inst.writeReg[j]]++;
+		}
+
+		// registers touched by 128-bit ops belong in XMM registers
+		for (u32 reg = 1; reg < 32; reg++)
+		{
+			if (inst.regs[reg] & EEINST_XMM)
+				wide |= (1u << reg);
+		}
+	}
+
+	for (const int hostreg : s_pinHostRegs)
+	{
+		int best = -1;
+		for (int reg = 1; reg < 32; reg++)
+		{
+			if (uses[reg] >= PIN_MIN_USES && !(wide & (1u << reg)) && (best < 0 || uses[reg] > uses[best]))
+				best = reg;
+		}
+		if (best < 0)
+			break;
+
+		RALOG("Pinning guest reg %d to host reg %d (%u uses)\n", best, hostreg, uses[best]);
+		s_pinnedHostReg[best] = static_cast<s8>(hostreg);
+		s_pinnedGuestReg[hostreg] = static_cast<s8>(best);
+		uses[best] = 0;
+	}
 }
 
 int _getFreeX86reg(int mode)
@@ -38,7 +138,7 @@ int _getFreeX86reg(int mode)
     for (i = 0; i < iREGCNT_GPR; ++i)
     {
         const int reg = (g_x86checknext + i) % iREGCNT_GPR;
-        if (x86regs[reg].inuse || !_isAllocatableX86reg(reg))
+        if (x86regs[reg].inuse || !_isAllocatableX86reg(reg) || s_pinnedGuestReg[reg] >= 0)
             continue;
 
 //        if ((mode & MODE_CALLEESAVED) && xRegister32::IsCallerSaved(reg))
@@ -85,18 +185,24 @@ int _getFreeX86reg(int mode)
         if ((mode & MODE_COP2) && mVUIsReservedCOP2(i))
             continue;
 
-        // should have checked inuse in the previous loop.
-        pxAssert(x86regs[i].inuse);
+        // only reserved pinned registers can still be free here, better than evicting something.
+        if (!x86regs[i].inuse)
+        {
+            pxAssert(s_pinnedGuestReg[i] >= 0);
+            return i;
+        }
 
         if (x86regs[i].needed)
             continue;
 
         if (x86regs[i].type != X86TYPE_TEMP)
         {
-            if (x86regs[i].counter < bestcount)
+            // guest registers which aren't used again go first, then the least recently used
+            const u32 count = _isX86regDeadPSX(i) ? 0 : x86regs[i].counter;
+            if (count < bestcount)
             {
                 tempi = static_cast<int>(i);
-                bestcount = x86regs[i].counter;
+                bestcount = count;
             }
             continue;
         }
@@ -318,7 +424,15 @@ int _allocX86reg(int type, int reg, int mode)
 		}
 	}
 
-	const int regnum = _getFreeX86reg(mode);
+	int regnum = -1;
+	if (type == X86TYPE_GPR && reg < 32 && s_pinnedHostReg[reg] >= 0 && !x86regs[s_pinnedHostReg[reg]].inuse)
+		regnum = s_pinnedHostReg[reg];
+	else if (type == X86TYPE_PSX && s_psxLiveRegs && EEINST_USEDTEST(reg))
+		regnum = _getFreePSXLiveReg();
+
+	if (regnum < 0)
+		regnum = _getFreeX86reg(mode);
+
     a64::XRegister new_reg(regnum);
 	x86regs[regnum].type = type;
 	x86regs[regnum].reg = reg;
@@ -374,6 +488,7 @@ int _allocX86reg(int type, int reg, int mode)
 						RALOG("Loading guest reg %d to GPR %d\n", reg, regnum);
 //						xMOV(new_reg, ptr64[&cpuRegs.GPR.r[reg].UD[0]]);
                         armLoad(new_reg, PTR_CPU(cpuRegs.GPR.r[reg].UD[0]));
+						EE::Profiler.EmitRegLoad();
 					}
 				}
 			}
@@ -464,6 +579,7 @@ void _writebackX86Reg(int x86reg)
 			RALOG("Writing back GPR reg %d for guest reg %d P2\n", x86reg, x86regs[x86reg].reg);
 //			xMOV(ptr64[&cpuRegs.GPR.r[x86regs[x86reg].reg].UD[0]], xRegister64(x86reg));
             armStore(PTR_CPU(cpuRegs.GPR.r[x86regs[x86reg].reg].UD[0]), a64::XRegister(x86reg));
+			EE::Profiler.EmitRegStore();
 			break;
 
 		case X86TYPE_FPRC:
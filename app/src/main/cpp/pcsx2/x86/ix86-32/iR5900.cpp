@@ -8,6 +8,7 @@
 #include "GS.h"
 #include "Memory.h"
 #include "Patch.h"
+#include "PerformanceMetrics.h"
 #include "R3000A.h"
 #include "R5900OpcodeTables.h"
 #include "VMManager.h"
@@ -15,13 +16,17 @@
 #include "x86/BaseblockEx.h"
 #include "x86/iR5900.h"
 #include "x86/iR5900Analysis.h"
+#include "x86/iR5900BlockCache.h"
 
 #include "common/AlignedMalloc.h"
 #include "common/FastJmp.h"
 #include "common/HeapArray.h"
 #include "common/Perf.h"
+#include "common/Timer.h"
 #include "x86/microVU_Misc.h"
 
+#include <unordered_set>
+
 // Only for MOVQ workaround.
 #if !defined(__ANDROID__)
 #include "common/emitter/internal.h"
@@ -96,6 +101,54 @@ u32 s_nEndBlock = 0; // what pc the current block ends
 u32 s_branchTo;
 static bool s_nBlockFF;
 
+// Tiered compilation. New blocks are built in a baseline tier which skips the delay slot swapping
+// and the register lookahead, both of which get expensive on long blocks. The baseline block counts
+// its executions, and once it's run TIERUP_THRESHOLD times it's discarded at the next event test and
+// rebuilt with the full pipeline.
+static constexpr u32 TIERUP_THRESHOLD = 64;
+static constexpr u32 TIERUP_MAX_COUNTERS = 0x10000;
+static u32 s_nBlockTier = 1;
+alignas(16) static u32 s_tierCounters[TIERUP_MAX_COUNTERS];
+static u32 s_nTierCounters = 0;
+static std::unordered_set<u32> s_hotBlocks;
+static std::vector<u32> s_pendingTierUps;
+
+// Shadow return stack. JAL/JALR push the return address along with its recLUT slot, and a JR RA
+// which ends a block checks the top entry against the real target before going through the full
+// lookup in DispatcherReg. Entries are only hints: a mismatch (setjmp/longjmp, exceptions, or the
+// stack wrapping around) falls back to DispatcherReg, so nothing needs to be invalidated on clears.
+static constexpr u32 RETURN_STACK_SIZE = 16;
+struct ReturnStackEntry
+{
+	u32 pc;
+	u32 pad;
+	BASEBLOCK* slot;
+};
+static_assert(sizeof(ReturnStackEntry) == 16);
+struct alignas(16) ReturnStack
+{
+	u32 top;
+	u32 pad[3];
+	ReturnStackEntry entries[RETURN_STACK_SIZE];
+};
+static ReturnStack s_returnStack;
+static u32 s_nBlockReturnLink = 0;
+static bool s_nBlockReturnPredict = false;
+
+// Trace formation. Forward unconditional jumps (J, and BEQ with rs == rt) which stay within the
+// block's page are followed while scanning, so the block becomes a superblock made of several
+// straight-line segments. The skipped gaps stay part of the block's range for protection and
+// invalidation, they're just never compiled. Cycles are counted per compiled instruction, so
+// scaleblockcycles() sees exactly the instructions the trace executes.
+static constexpr u32 TRACE_MAX_JUMPS = 8;
+struct TraceJump
+{
+	u32 branchpc;
+	u32 target;
+};
+static TraceJump s_traceJumps[TRACE_MAX_JUMPS];
+static u32 s_nTraceJumps = 0;
+
 // save states for branches
 GPR_reg64 s_saveConstRegs[32];
 static u32 s_saveHasConstReg = 0, s_saveFlushedConstReg = 0;
@@ -105,6 +158,8 @@ static u32 s_savenBlockCycles = 0;
 
 static void iBranchTest(u32 newpc = 0xffffffff);
 static void ClearRecLUT(BASEBLOCK* base, int count);
+static void recRecompile(const u32 startpc);
+static void recPreloadCachedBlocks(u32 entrypc);
 static u32 scaleblockcycles();
 static void recExitExecution();
 
@@ -367,6 +422,7 @@ void recCall(void (*func)())
 
 static void recRecompile(const u32 startpc);
 static void dyna_block_discard(u32 start, u32 sz);
+void recClear(u32 addr, u32 size);
 static void dyna_page_reset(u32 start, u32 sz);
 
 static const void* DispatcherEvent = nullptr;
@@ -375,9 +431,157 @@ static const void* JITCompile = nullptr;
 static const void* EnterRecompiledCode = nullptr;
 static const void* DispatchBlockDiscard = nullptr;
 static const void* DispatchPageReset = nullptr;
+static const void* DispatcherReturn = nullptr;
+
+static void recProcessTierUps()
+{
+	// We're outside of any block here, so it's safe to throw the baseline code away.
+	for (const u32 startpc : s_pendingTierUps)
+	{
+		const u32 hwpc = HWADDR(startpc);
+		if (!s_hotBlocks.insert(hwpc).second)
+			continue;
+
+		const BASEBLOCKEX* block = recBlocks.Get(hwpc);
+		if (!block || block->startpc != hwpc || block->size == 0)
+			continue;
+
+#ifdef PCSX2_DEVBUILD
+		eeRecPerfLog.Write("Tier-up @ %08X : size=%d insts", startpc, block->size);
+#endif
+		recClear(hwpc, block->size);
+	}
+
+	s_pendingTierUps.clear();
+}
+
+// Called from baseline blocks when their execution counter runs out.
+static void recTierUpRequest(u32 startpc)
+{
+	s_pendingTierUps.push_back(startpc);
+}
+
+static void recEmitTierUpCounter(u32 startpc)
+{
+	u32* counter = &s_tierCounters[s_nTierCounters++];
+	*counter = TIERUP_THRESHOLD;
+
+	a64::Label not_hot;
+	armMoveAddressToReg(RCX, counter);
+	armAsm->Ldr(EAX, a64::MemOperand(RCX));
+	armAsm->Subs(EAX, EAX, 1);
+	armAsm->Str(EAX, a64::MemOperand(RCX));
+	armAsm->B(&not_hot, a64::Condition::ne);
+	armAsm->Mov(EAX, startpc);
+	armEmitCall(reinterpret_cast<const void*>(recTierUpRequest));
+	armBind(&not_hot);
+}
+
+void recPushReturnAddress(u32 retpc)
+{
+	if (CHECK_EERETURNSTACK && !EmuConfig.Gamefixes.GoemonTlbHack && (retpc & 0x1fffffff) < Ps2MemSize::ExposedRam)
+		s_nBlockReturnLink = retpc;
+}
+
+void recPredictReturn()
+{
+	s_nBlockReturnPredict = CHECK_EERETURNSTACK;
+}
+
+// Instructions which are safe to leave in the delay slot of a jump we're tracing through.
+static bool recTraceIsPlainDelaySlot(u32 code)
+{
+	switch (code >> 26)
+	{
+		case 0: // special
+		{
+			const u32 funct = code & 0x3f;
+			return (funct != 8 && funct != 9 && funct != 12 && funct != 13); // JR, JALR, SYSCALL, BREAK
+		}
+
+		case 1: // regimm
+		case 2: // J
+		case 3: // JAL
+		case 4: // BEQ
+		case 5: // BNE
+		case 6: // BLEZ
+		case 7: // BGTZ
+		case 16: // cp0
+		case 17: // cp1
+		case 18: // cp2
+		case 20: // BEQL
+		case 21: // BNEL
+		case 22: // BLEZL
+		case 23: // BGTZL
+		case 54: // LQC2
+		case 62: // SQC2
+			return false;
+
+		default:
+			return true;
+	}
+}
+
+// Called while scanning a block, returns true if the jump at branchpc should be followed.
+static bool recTraceTryFollow(u32 branchpc, u32 target)
+{
+	if (!CHECK_EETRACEFORMATION || EmuConfig.Gamefixes.GoemonTlbHack || s_nTraceJumps == TRACE_MAX_JUMPS)
+		return false;
+
+	// Only forward jumps which skip something and stay in the same page. Backward jumps are loops,
+	// and those are better off as their own block linked back to itself.
+	if (target <= branchpc + 8 || (target & ~0xfffu) != (branchpc & ~0xfffu))
+		return false;
+
+	if (!recTraceIsPlainDelaySlot(*(u32*)PSM(branchpc + 4)))
+		return false;
+
+	// Don't swallow anything that's already been compiled, including the target.
+	for (u32 gpc = branchpc + 8; gpc <= target; gpc += 4)
+	{
+		if (PC_GETBLOCK(gpc)->GetFnptr() != (uptr)JITCompile)
+			return false;
+	}
+
+	s_traceJumps[s_nTraceJumps++] = {branchpc, target};
+	return true;
+}
+
+// Called from SetBranchImm() after the delay slot, moves the compiler to the jump target.
+static bool recTraceContinue(u32 target)
+{
+	for (u32 i = 0; i < s_nTraceJumps; i++)
+	{
+		if (s_traceJumps[i].branchpc + 8 != pc || s_traceJumps[i].target != target)
+			continue;
+
+		g_pCurInstInfo += (target - pc) >> 2;
+		pc = target;
+		return true;
+	}
+
+	return false;
+}
+
+static void recEmitReturnStackPush(u32 retpc)
+{
+	armMoveAddressToReg(RCX, &s_returnStack);
+	armAsm->Ldr(EAX, a64::MemOperand(RCX, offsetof(ReturnStack, top)));
+	armAsm->Add(EAX, EAX, 1);
+	armAsm->And(EAX, EAX, RETURN_STACK_SIZE - 1);
+	armAsm->Str(EAX, a64::MemOperand(RCX, offsetof(ReturnStack, top)));
+	armAsm->Add(RCX, RCX, a64::Operand(RAX, a64::LSL, 4));
+	armAsm->Mov(EDX, retpc);
+	armAsm->Str(EDX, a64::MemOperand(RCX, offsetof(ReturnStack, entries) + offsetof(ReturnStackEntry, pc)));
+	armMoveAddressToReg(RDX, PC_GETBLOCK(retpc));
+	armAsm->Str(RDX, a64::MemOperand(RCX, offsetof(ReturnStack, entries) + offsetof(ReturnStackEntry, slot)));
+}
 
 static void recEventTest()
 {
+	if (!s_pendingTierUps.empty())
+		recProcessTierUps();
+
 	_cpuEventTest_Shared();
 
 	if (eeRecExitRequested)
@@ -430,6 +634,9 @@ static const void* _DynGen_DispatcherReg()
 //	u8* retval = xGetPtr(); // fallthrough target, can't align it!
     u8* retval = armGetCurrentCodePointer();
 
+    if (CHECK_JITCOUNTERS)
+        armAdd(&PerformanceMetrics::g_jit_counters.ee_dispatches, 1);
+
 	// C equivalent:
 	// u32 addr = cpuRegs.pc;
 	// void(**base)() = (void(**)())recLUT[addr >> 16];
@@ -453,6 +660,43 @@ static const void* _DynGen_DispatcherReg()
 	return retval;
 }
 
+// called for JR RA, tries the shadow return stack before falling back to DispatcherReg
+static const void* _DynGen_DispatcherReturn()
+{
+    armAlignAsmPtr();
+    u8* retval = armGetCurrentCodePointer();
+
+	// C equivalent:
+	// ReturnStackEntry& entry = s_returnStack.entries[s_returnStack.top];
+	// if (entry.pc != cpuRegs.pc) goto DispatcherReg;
+	// s_returnStack.top = (s_returnStack.top - 1) & (RETURN_STACK_SIZE - 1);
+	// ((void(*)())entry.slot->GetFnptr())();
+    a64::Label miss;
+    armMoveAddressToReg(RCX, &s_returnStack);
+    armAsm->Ldr(EDX, a64::MemOperand(RCX, offsetof(ReturnStack, top)));
+    armAsm->Add(RBX, RCX, a64::Operand(RDX, a64::LSL, 4));
+    armAsm->Ldr(EAX, a64::MemOperand(RBX, offsetof(ReturnStack, entries) + offsetof(ReturnStackEntry, pc)));
+    armLoad(EEX, PTR_CPU(cpuRegs.pc));
+    armAsm->Cmp(EAX, EEX);
+    armAsm->B(&miss, a64::Condition::ne);
+
+    armAsm->Sub(EDX, EDX, 1);
+    armAsm->And(EDX, EDX, RETURN_STACK_SIZE - 1);
+    armAsm->Str(EDX, a64::MemOperand(RCX, offsetof(ReturnStack, top)));
+    if (CHECK_JITCOUNTERS)
+        armAdd(&PerformanceMetrics::g_jit_counters.ee_return_hits, 1);
+    armAsm->Ldr(RAX, a64::MemOperand(RBX, offsetof(ReturnStack, entries) + offsetof(ReturnStackEntry, slot)));
+    armAsm->Ldr(RAX, a64::MemOperand(RAX));
+    armAsm->Br(RAX);
+
+    armBind(&miss);
+    if (CHECK_JITCOUNTERS)
+        armAdd(&PerformanceMetrics::g_jit_counters.ee_return_misses, 1);
+    armEmitJmp(DispatcherReg);
+
+	return retval;
+}
+
 static const void* _DynGen_DispatcherEvent()
 {
 //	u8* retval = xGetPtr();
@@ -541,6 +785,7 @@ static void _DynGen_Dispatchers()
 	EnterRecompiledCode = _DynGen_EnterRecompiledCode();
 	DispatchBlockDiscard = _DynGen_DispatchBlockDiscard();
 	DispatchPageReset = _DynGen_DispatchPageReset();
+	DispatcherReturn = _DynGen_DispatcherReturn();
 
 	recBlocks.SetJITCompile(JITCompile);
 
@@ -663,18 +908,31 @@ static void recResetRaw()
 	if (s_pInstCache)
 		memset(s_pInstCache, 0, sizeof(EEINST) * s_nInstCacheSize);
 
+	EE::BlockCache::Save();
+	vtlb_SaveFaultHistory();
 	recBlocks.Reset();
 	vtlb_ClearLoadStoreInfo();
 
 	g_branch = 0;
 	g_resetEeScalingStats = true;
 
+	s_nTierCounters = 0;
+	s_hotBlocks.clear();
+	s_pendingTierUps.clear();
+
+	std::memset(&s_returnStack, 0, sizeof(s_returnStack));
+	s_nBlockReturnLink = 0;
+	s_nBlockReturnPredict = false;
+
 	memset(manual_page, 0, sizeof(manual_page));
 	memset(manual_counter, 0, sizeof(manual_counter));
 }
 
 void recShutdown()
 {
+	EE::BlockCache::Close();
+	vtlb_CloseFaultHistory();
+
 	recRAMCopy.deallocate();
 	recLutReserve_RAM.deallocate();
 
@@ -951,17 +1209,34 @@ void SetBranchReg(u32 reg)
 
 	iFlushCall(FLUSH_EVERYTHING);
 
+	if (s_nBlockReturnLink != 0)
+	{
+		recEmitReturnStackPush(s_nBlockReturnLink);
+		s_nBlockReturnLink = 0;
+	}
+
 	iBranchTest();
+	s_nBlockReturnPredict = false;
 }
 
 void SetBranchImm(u32 imm)
 {
+	if (s_nTraceJumps > 0 && recTraceContinue(imm))
+		return;
+
 	g_branch = 1;
 
 	pxAssert(imm);
 
 	// end the current block
 	iFlushCall(FLUSH_EVERYTHING);
+
+	if (s_nBlockReturnLink != 0)
+	{
+		recEmitReturnStackPush(s_nBlockReturnLink);
+		s_nBlockReturnLink = 0;
+	}
+
 //	xMOV(ptr32[&cpuRegs.pc], imm);
     armStore(PTR_CPU(cpuRegs.pc), imm);
 	iBranchTest(imm);
@@ -995,7 +1270,7 @@ u8* recEndThunk()
 bool TrySwapDelaySlot(u32 rs, u32 rt, u32 rd, bool allow_loadstore)
 {
 #if 1
-	if (g_recompilingDelaySlot)
+	if (g_recompilingDelaySlot || s_nBlockTier == 0)
 		return false;
 
 	const u32 opcode_encoded = *(u32*)PSM(pc);
@@ -1478,7 +1753,7 @@ static void iBranchTest(u32 newpc)
 
 		if (newpc == 0xffffffff) {
 //            xJS(DispatcherReg);
-            armEmitJmp(DispatcherReg);
+            armEmitJmp(s_nBlockReturnPredict ? DispatcherReturn : DispatcherReg);
         }
 		else {
 //            recBlocks.Link(HWADDR(newpc), xJcc32(Jcc_Signed));
@@ -1829,7 +2104,8 @@ void recompileNextInstruction(bool delayslot, bool swapped_delay_slot)
 	g_pCurInstInfo++;
 
 	// pc might be past s_nEndBlock if the last instruction in the block is a DI.
-	if (pc <= s_nEndBlock && (g_pCurInstInfo + (s_nEndBlock - pc) / 4 + 1) <= s_pInstCache + s_nInstCacheSize)
+	// Baseline blocks skip the lookahead and evict registers in allocation order instead.
+	if (s_nBlockTier != 0 && pc <= s_nEndBlock && (g_pCurInstInfo + (s_nEndBlock - pc) / 4 + 1) <= s_pInstCache + s_nInstCacheSize)
 	{
 		int count;
 		for (u32 i = 0; i < iREGCNT_GPR; ++i)
@@ -2364,6 +2640,14 @@ static void recRecompile(const u32 startpc)
 		recResetRaw();
 	}
 
+	// Load the fault history first, so that preloaded blocks already take the slow path where needed.
+	if (CHECK_FASTMEMFAULTHISTORY && HWADDR(startpc) == VMManager::Internal::GetCurrentELFEntryPoint())
+		vtlb_OpenFaultHistory(VMManager::GetDiscSerial(), VMManager::GetCurrentCRC());
+
+	// Entering the ELF tosses every block, so this is the point where the persistent cache is warmed.
+	// The preload compiles other blocks, so it waits until this one is finished.
+	const bool preload_cached_blocks = CHECK_EEBLOCKCACHE && HWADDR(startpc) == VMManager::Internal::GetCurrentELFEntryPoint();
+
 //	xSetPtr(recPtr);
     armSetAsmPtr(recPtr, recPtrEnd - recPtr, nullptr);
 //	recPtr = xGetAlignedCallTarget();
@@ -2415,6 +2699,11 @@ static void recRecompile(const u32 startpc)
     }
 
 	g_branch = 0;
+	s_nBlockReturnLink = 0;
+	s_nBlockReturnPredict = false;
+
+	s_nBlockTier = (CHECK_EETIEREDCOMPILE && s_nTierCounters < TIERUP_MAX_COUNTERS &&
+					   s_hotBlocks.find(HWADDR(startpc)) == s_hotBlocks.end()) ? 0 : 1;
 
 	// reset recomp state variables
 	s_nBlockCycles = 0;
@@ -2426,6 +2715,9 @@ static void recRecompile(const u32 startpc)
 	_initX86regs();
 	_initXMMregs();
 
+	if (s_nBlockTier == 0)
+		recEmitTierUpCounter(startpc);
+
 #ifdef TRACE_BLOCKS
 	xFastCall((void*)PreBlockCheck, pc);
 #endif
@@ -2453,6 +2745,11 @@ static void recRecompile(const u32 startpc)
 	i = startpc;
 	s_nEndBlock = 0xffffffff;
 	s_branchTo = -1;
+	s_nTraceJumps = 0;
+
+	// start of the segment being scanned, differs from startpc once we've followed a jump
+	u32 segmentpc = startpc;
+	bool trace_allowed = true;
 
 	// Timeout loop speedhack.
 	// God of War 2 and other games (e.g. NFS series) have these timeout loops which just spin for a few thousand
@@ -2519,6 +2816,19 @@ static void recRecompile(const u32 startpc)
 		//HUH ? PSM ? whut ? THIS IS VIRTUAL ACCESS GOD DAMMIT
 		cpuRegs.code = *(int*)PSM(i);
 
+		// The COP2 analysis passes walk the block linearly, so traces stop short of any COP2 code.
+		if (_Opcode_ == 022 || _Opcode_ == 066 || _Opcode_ == 076)
+		{
+			if (s_nTraceJumps > 0)
+			{
+				willbranch3 = 1;
+				s_nEndBlock = i;
+				break;
+			}
+
+			trace_allowed = false;
+		}
+
 		if (is_timeout_loop)
 		{
 			if ((cpuRegs.code >> 26) == 8 || (cpuRegs.code >> 26) == 9)
@@ -2562,7 +2872,7 @@ static void recRecompile(const u32 startpc)
 				{
 					// branches
 					s_branchTo = (_Imm_ << 2) + i + 4; // _Imm_ * 4
-					if (s_branchTo > startpc && s_branchTo < i)
+					if (s_branchTo > segmentpc && s_branchTo < i)
 						s_nEndBlock = s_branchTo;
 					else
 						s_nEndBlock = i + 8;
@@ -2574,6 +2884,12 @@ static void recRecompile(const u32 startpc)
 			case 2: // J
 			case 3: // JAL
 				s_branchTo = (_InstrucTarget_ << 2) | ((i + 4) & 0xf0000000);
+				if (_Opcode_ == 2 && trace_allowed && recTraceTryFollow(i, s_branchTo))
+				{
+					i = segmentpc = s_branchTo;
+					continue;
+				}
+
 				s_nEndBlock = i + 8;
 				goto StartRecomp;
 
@@ -2587,7 +2903,13 @@ static void recRecompile(const u32 startpc)
 			case 22:
 			case 23:
 				s_branchTo = (_Imm_ << 2) + i + 4; // _Imm_ * 4
-				if (s_branchTo > startpc && s_branchTo < i)
+				if (_Opcode_ == 4 && _Rs_ == _Rt_ && trace_allowed && recTraceTryFollow(i, s_branchTo))
+				{
+					i = segmentpc = s_branchTo;
+					continue;
+				}
+
+				if (s_branchTo > segmentpc && s_branchTo < i)
 					s_nEndBlock = s_branchTo;
 				else
 					s_nEndBlock = i + 8;
@@ -2613,7 +2935,7 @@ static void recRecompile(const u32 startpc)
 					// BC1F, BC1T, BC1FL, BC1TL
 					// BC2F, BC2T, BC2FL, BC2TL
 					s_branchTo = (_Imm_ << 2) + i + 4; // _Imm_ * 4
-					if (s_branchTo > startpc && s_branchTo < i)
+					if (s_branchTo > segmentpc && s_branchTo < i)
 						s_nEndBlock = s_branchTo;
 					else
 						s_nEndBlock = i + 8;
@@ -2628,12 +2950,17 @@ static void recRecompile(const u32 startpc)
 
 StartRecomp:
 
+#ifdef PCSX2_DEVBUILD
+	if (s_nTraceJumps > 0)
+		eeRecPerfLog.Write("Trace @ %08X : %u jumps, size=%d insts", startpc, s_nTraceJumps, (s_nEndBlock - startpc) / 4);
+#endif
+
 	// The idea here is that as long as a loop doesn't write to a register it's already read
 	// (excepting registers initialised with constants or memory loads) or use any instructions
 	// which alter the machine state apart from registers, it will do the same thing on every
 	// iteration.
 	s_nBlockFF = false;
-	if (s_branchTo == startpc)
+	if (s_branchTo == startpc && s_nTraceJumps == 0)
 	{
 		s_nBlockFF = true;
 
@@ -2742,8 +3069,23 @@ StartRecomp:
 		_recClearInst(pcur);
 		pcur->info = 0;
 
+		u32 trace_jump = s_nTraceJumps;
 		for (i = s_nEndBlock; i > startpc; i -= 4)
 		{
+			if (trace_jump > 0 && i == s_traceJumps[trace_jump - 1].target)
+			{
+				// Carry the state at the jump target back to the jump's delay slot, skipping the gap.
+				trace_jump--;
+				const u32 segment_end = s_traceJumps[trace_jump].branchpc + 8;
+				EEINST* pend = s_pInstCache + ((segment_end - startpc) >> 2);
+				*pend = *pcur;
+				for (EEINST* pgap = pend + 1; pgap <= pcur; pgap++)
+					_recClearInst(pgap);
+
+				pcur = pend;
+				i = segment_end;
+			}
+
 			cpuRegs.code = *(int*)PSM(i - 4);
 			pcur[-1] = pcur[0];
 			recBackpropBSC(cpuRegs.code, pcur - 1, pcur);
@@ -2762,6 +3104,10 @@ StartRecomp:
 			COP2FlagHackPass().Run(startpc, s_nEndBlock, s_pInstCache + 1);
 	}
 
+	// COP2 code shares host registers with the VU0 allocator, so those blocks stick to the greedy allocator.
+	if (CHECK_EEREGPINNING && !has_cop2_instructions)
+		_pinHotGPRs(s_pInstCache + 1, (s_nEndBlock - startpc) >> 2);
+
 #ifdef DUMP_BLOCKS
 	ZydisDecoder disas_decoder;
 	ZydisDecoderInit(&disas_decoder, ZYDIS_MACHINE_MODE_LONG_64, ZYDIS_ADDRESS_WIDTH_64);
@@ -2919,8 +3265,40 @@ StartRecomp:
 
 	pxAssert((g_cpuHasConstReg & g_cpuFlushedConstReg) == g_cpuHasConstReg);
 
+	if (CHECK_EEBLOCKCACHE)
+		EE::BlockCache::Record(startpc, s_pCurBlockEx->size);
+
 	s_pCurBlock = nullptr;
 	s_pCurBlockEx = nullptr;
+
+	if (preload_cached_blocks)
+		recPreloadCachedBlocks(startpc);
+}
+
+// Compiles every block recorded for this game during previous sessions whose guest code is
+// still the same, so that the first minutes of gameplay don't keep falling into JITCompile.
+static void recPreloadCachedBlocks(u32 entrypc)
+{
+	const std::vector<u32> cached = EE::BlockCache::Open(VMManager::GetDiscSerial(), VMManager::GetCurrentCRC());
+	if (cached.empty())
+		return;
+
+	Common::Timer timer;
+	u32 compiled = 0;
+	for (const u32 blockpc : cached)
+	{
+		// Stop short of filling the code buffer, a reset would throw away the entry block again.
+		if (recPtr >= recPtrEnd - _64kb || eeRecNeedsReset)
+			break;
+
+		if (blockpc == entrypc || PC_GETBLOCK(blockpc)->GetFnptr() != (uptr)JITCompile)
+			continue;
+
+		recRecompile(blockpc);
+		compiled++;
+	}
+
+	Console.WriteLn(Color_StrongGreen, "(EE BlockCache) Precompiled %u cached blocks in %.2f ms", compiled, timer.GetTimeMilliseconds());
 }
 
 R5900cpu recCpu = {
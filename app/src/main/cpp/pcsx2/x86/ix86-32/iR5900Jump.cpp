@@ -62,6 +62,7 @@ void recJAL()
         armStore(PTR_CPU(cpuRegs.GPR.r[31].UL[1]), 0);
 	}
 
+	recPushReturnAddress(pc + 4);
 	recompileNextInstruction(true, false);
 	if (EmuConfig.Gamefixes.GoemonTlbHack)
 		SetBranchImm(vtlb_V2P(newpc));
@@ -79,6 +80,9 @@ void recJR()
 {
 	EE::Profiler.EmitOp(eeOpcode::JR);
 
+	if (_Rs_ == 31)
+		recPredictReturn();
+
 	SetBranchReg(_Rs_);
 }
 
@@ -172,6 +176,9 @@ void recJALR()
 		}
 	}
 
+	if (_Rd_ == 31)
+		recPushReturnAddress(newpc);
+
 	SetBranchReg(0xffffffff);
 }
 
@@ -7,6 +7,10 @@
 #include "common/Perf.h"
 #include "common/StringUtil.h"
 
+#define XXH_STATIC_LINKING_ONLY 1
+#define XXH_INLINE_ALL 1
+#include <xxhash.h>
+
 alignas(64) vuRegistersPack g_vuRegistersPack;
 VU_Thread& vu1Thread = g_vuRegistersPack.vu1Thread;
 
@@ -58,6 +62,14 @@ void mVUreset(microVU& mVU, bool resetReserve)
 	memset(&mVU.prog.lpState, 0, sizeof(mVU.prog.lpState));
 	mVU.profiler.Reset(mVU.index);
 
+	mVUprintProgStats(mVU);
+	std::memset(&mVU.prog.stats, 0, sizeof(mVU.prog.stats));
+	mVU.progIndex.clear();
+	mVUfreeRetiredProgs(mVU);
+	mVUprogCacheSave(mVU);
+	if (CHECK_VUPROGCACHE)
+		mVUprogCacheOpen(mVU);
+
 	// Program Variables
 	mVU.prog.cleared  =  1;
 	mVU.prog.isSame   = -1;
@@ -92,6 +104,11 @@ void mVUreset(microVU& mVU, bool resetReserve)
 // Free Allocated Resources
 void mVUclose(microVU& mVU)
 {
+	mVUprintProgStats(mVU);
+	mVU.progIndex.clear();
+	mVUfreeRetiredProgs(mVU);
+	mVUprogCacheClose(mVU);
+
 	// Delete Programs and Block Managers
     u32 i, e = (mVU.progSize >> 1); // mVU.progSize / 2
 	for (i = 0; i < e; ++i)
@@ -193,6 +210,77 @@ __ri void mVUcacheProg(microVU& mVU, microProgram& prog)
 	mVUdumpProg(mVU, prog);
 }
 
+// Hashes the whole micro memory, seeded with the start PC so each program list gets its own keys
+static u64 mVUhashMicro(microVU& mVU, u32 startPC)
+{
+	return XXH3_64bits_withSeed(mVU.regs().Micro, mVU.microMemSize, startPC);
+}
+
+// Remembers that prog matched the micro memory with the given hash
+static void mVUindexProg(microVU& mVU, u64 hash, microProgram* prog)
+{
+	// The index only short-cuts the list search, so it's fine to just start over when it gets big
+	if (mVU.progIndex.size() >= mVUprogIndexMax)
+		mVU.progIndex.clear();
+	mVU.progIndex[hash] = prog;
+}
+
+// Drops the least recently used program of a full program list
+static void mVUevictProg(microVU& mVU, microProgramList& list)
+{
+	microProgram* prog = list.back();
+	list.pop_back();
+
+	for (auto it = mVU.progIndex.begin(); it != mVU.progIndex.end();)
+	{
+		if (it->second == prog)
+			it = mVU.progIndex.erase(it);
+		else
+			++it;
+	}
+
+	// Quick references for other start PCs may still point at it if memory hasn't been cleared since
+	const u32 e = mVU.progSize >> 1; // mVU.progSize / 2
+	for (u32 i = 0; i < e; ++i)
+	{
+		if (mVU.prog.quick[i].prog == prog)
+		{
+			mVU.prog.quick[i].block = nullptr;
+			mVU.prog.quick[i].prog = nullptr;
+		}
+	}
+	if (mVU.prog.cur == prog)
+		mVU.prog.cur = nullptr;
+
+	// Blocks of other programs cache JR/JALR targets by program pointer, so the program itself
+	// has to stay allocated until the next reset. Its blocks and ranges can go right away.
+	for (u32 i = 0; i < e; ++i)
+		safe_delete(prog->block[i]);
+	safe_delete(prog->ranges);
+	mVU.progRetired.push_back(prog);
+	mVU.prog.stats.evictions++;
+}
+
+// Releases programs evicted since the last reset
+void mVUfreeRetiredProgs(microVU& mVU)
+{
+	for (microProgram* prog : mVU.progRetired)
+		mVUdeleteProg(mVU, prog);
+	mVU.progRetired.clear();
+}
+
+// Prints program cache statistics since the last reset
+void mVUprintProgStats(microVU& mVU)
+{
+	const microProgStats& s = mVU.prog.stats;
+	if (!s.misses)
+		return;
+
+	DevCon.WriteLn(mVU.index ? Color_Orange : Color_Magenta,
+		"microVU%d: Program cache [quick=%u hash=%u scan=%u miss=%u evict=%u]",
+		mVU.index, s.quickHits, s.hashHits, s.scanHits, s.misses, s.evictions);
+}
+
 // Generate Hash for partial program based on compiled ranges...
 u64 mVUrangesHash(microVU& mVU, microProgram& prog)
 {
@@ -286,41 +374,70 @@ _mVUt __fi void* mVUsearchProg(u32 startPC, uptr pState)
 
 	if (!quick.prog) // If null, we need to search for new program
 	{
-		auto it(list->begin());
-		for (; it != list->end(); ++it)
+		// Try the program which last matched this exact micro memory before walking the list
+		const u64 hash = mVUhashMicro(mVU, regs_start_pc_8);
+		microProgram* found = nullptr;
+		auto idx = mVU.progIndex.find(hash);
+		if (idx != mVU.progIndex.end() && mVUcmpProg(mVU, *idx->second))
 		{
-			bool b = mVUcmpProg(mVU, *it[0]);
-
-			if (b)
+			found = idx->second;
+			mVU.prog.stats.hashHits++;
+		}
+		else
+		{
+			auto it(list->begin());
+			for (; it != list->end(); ++it)
 			{
-				quick.block = it[0]->block[start_pc_8];
-				quick.prog  = it[0];
-				list->erase(it);
-				list->push_front(quick.prog);
-
-				// Sanity check, in case for some reason the program compilation aborted half way through (JALR for example)
-				if (quick.block == nullptr)
+				if (mVUcmpProg(mVU, *it[0]))
 				{
-					void* entryPoint = mVUblockFetch(mVU, startPC, pState);
-					return entryPoint;
+					found = it[0];
+					mVU.prog.stats.scanHits++;
+					break;
 				}
-				return mVUentryGet(mVU, quick.block, startPC, pState);
 			}
 		}
 
+		if (found)
+		{
+			// Keep the list in most recently used order, eviction takes from the back
+			list->erase(std::find(list->begin(), list->end(), found));
+			list->push_front(found);
+			mVUindexProg(mVU, hash, found);
+
+			quick.block = found->block[start_pc_8];
+			quick.prog  = found;
+
+			// Sanity check, in case for some reason the program compilation aborted half way through (JALR for example)
+			if (quick.block == nullptr)
+			{
+				void* entryPoint = mVUblockFetch(mVU, startPC, pState);
+				return entryPoint;
+			}
+			return mVUentryGet(mVU, quick.block, startPC, pState);
+		}
+
+		if (list->size() >= mVUprogListMax)
+			mVUevictProg(mVU, *list);
+
 		// If cleared and program not found, make a new program instance
+		mVU.prog.stats.misses++;
 		mVU.prog.cleared = 0;
 		mVU.prog.isSame  = 1;
 		mVU.prog.cur     = mVUcreateProg(mVU, regs_start_pc_8);
+		mVU.prog.cur->hash = hash;
+		if (CHECK_VUPROGCACHE)
+			mVUprogCachePreload(mVU);
 		void* entryPoint = mVUblockFetch(mVU,  startPC, pState);
 		quick.block      = mVU.prog.cur->block[start_pc_8];
 		quick.prog       = mVU.prog.cur;
 		list->push_front(mVU.prog.cur);
+		mVUindexProg(mVU, hash, mVU.prog.cur);
 		//mVUprintUniqueRatio(mVU);
 		return entryPoint;
 	}
 
 	// If list.quick, then we've already found and recompiled the program ;)
+	mVU.prog.stats.quickHits++;
 	mVU.prog.isSame = -1;
 	mVU.prog.cur = quick.prog;
 	// Because the VU's can now run in sections and not whole programs at once
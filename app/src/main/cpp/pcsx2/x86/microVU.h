@@ -9,6 +9,8 @@
 #include <deque>
 #include <algorithm>
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include "Common.h"
 #include "VU.h"
 #include "MTVU.h"
@@ -52,6 +54,7 @@ struct microProgram
 	std::deque<microRange>* ranges;          // The ranges of the microProgram that have already been recompiled
 	u32 startPC; // Start PC of this program
 	int idx;     // Program index
+	u64 hash;    // Hash of micro memory + start PC the program was created for (program cache key)
 };
 
 typedef std::deque<microProgram*> microProgramList;
@@ -62,6 +65,15 @@ struct microProgramQuick
 	microProgram*      prog;  // The microProgram who is the owner of 'block'
 };
 
+struct microProgStats
+{
+	u32 quickHits;  // Programs found through the quick reference
+	u32 hashHits;   // Programs found through the content hash index
+	u32 scanHits;   // Programs found by walking the start PC's program list
+	u32 misses;     // New programs created
+	u32 evictions;  // Programs dropped from a full program list
+};
+
 struct microProgManager
 {
 	microIR<mProgSize> IRinfo;             // IR information
@@ -76,9 +88,32 @@ struct microProgManager
 	u8*                x86start;           // Start of program's rec-cache
 	u8*                x86end;             // Limit of program's rec-cache
 	microRegInfo       lpState;            // Pipeline state from where program left off (useful for continuing execution)
+	microProgStats     stats;              // Program cache statistics (since last reset)
+};
+
+// A block compiled for a microProgram, kept so it can be compiled again on the next boot
+struct microCachedBlock
+{
+	u32          startPC; // Block start PC (in bytes)
+	u32          pad[3];
+	microRegInfo pState;  // Pipeline state the block was compiled for
+};
+static_assert(sizeof(microCachedBlock) == 112, "microCachedBlock was not 112 bytes");
+
+struct microProgCache
+{
+	std::unordered_map<u64, std::vector<microCachedBlock>> progs; // Program hash -> blocks compiled for it
+	std::string path;      // Cache file for the running game (empty if closed)
+	u32         crc;       // Game the cache was opened for (0 for the BIOS or when closed)
+	bool        dirty;     // Blocks were recorded since the last save
+	bool        replaying; // Cached blocks are being compiled, so don't record them again
+	u32         preloadedProgs;  // Programs found in the cache since it was opened
+	u32         preloadedBlocks; // Blocks compiled from the cache since it was opened
 };
 
-static const uint mVUcacheSafeZone =  3; // Safe-Zone for program recompilation (in megabytes)
+static const uint mVUcacheSafeZone =  3;   // Safe-Zone for program recompilation (in megabytes)
+static const uint mVUprogListMax   = 64;   // Max microPrograms kept per start PC (least recently used are evicted)
+static const uint mVUprogIndexMax  = 4096; // Max entries in the content hash index before it is rebuilt
 
 struct microVU
 {
@@ -98,6 +133,9 @@ struct microVU
 	u32 cacheSize;    // VU Cache Size
 
 	microProgManager               prog;     // Micro Program Data
+	std::unordered_map<u64, microProgram*> progIndex; // Hash of micro memory + start PC -> last matching microProgram
+	microProgCache                 progCache;   // Persistent per-game record of compiled blocks
+	std::vector<microProgram*>     progRetired; // Evicted microPrograms, freed on reset so jump caches can't see a reused address
 	microProfiler                  profiler; // Opcode Profiler
 	std::unique_ptr<microRegAlloc> regAlloc; // Reg Alloc Class
 	std::FILE*                     logFile;  // Log File Pointer
@@ -339,6 +377,13 @@ mVUop(mVUopL);
 // Private Functions
 extern void mVUcacheProg(microVU& mVU, microProgram& prog);
 extern void mVUdeleteProg(microVU& mVU, microProgram*& prog);
+extern void mVUprintProgStats(microVU& mVU);
+extern void mVUfreeRetiredProgs(microVU& mVU);
+extern void mVUprogCacheOpen(microVU& mVU);
+extern void mVUprogCacheRecord(microVU& mVU, u32 startPC, const microRegInfo& pState);
+extern void mVUprogCachePreload(microVU& mVU);
+extern void mVUprogCacheSave(microVU& mVU);
+extern void mVUprogCacheClose(microVU& mVU);
 _mVUt extern void* mVUsearchProg(u32 startPC, uptr pState);
 extern void* mVUexecuteVU0(u32 startPC, u32 cycles);
 extern void* mVUexecuteVU1(u32 startPC, u32 cycles);
@@ -371,5 +416,6 @@ void sortVector(T& v)
 #include "microVU_Flags.inl"
 #include "microVU_Branch.inl"
 #include "microVU_Compile.inl"
+#include "microVU_ProgCache.inl"
 #include "microVU_Execute.inl"
 #include "microVU_Macro.inl"
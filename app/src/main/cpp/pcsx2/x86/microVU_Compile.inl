@@ -751,6 +751,9 @@ void* mVUcompile(microVU& mVU, u32 startPC, uptr pState)
 	u8* thisPtr = armGetCurrentCodePointer();
 	const u32 endCount = (((microRegInfo*)pState)->blockType) ? 1 : (mVU.microMemSize >> 3); // mVU.microMemSize / 8
 
+	if (CHECK_VUPROGCACHE)
+		mVUprogCacheRecord(mVU, startPC, *(microRegInfo*)pState);
+
 	// First Pass
 	iPC = startPC >> 2; // startPC / 4
 	mVUsetupRange(mVU, startPC, 1); // Setup Program Bounds/Range
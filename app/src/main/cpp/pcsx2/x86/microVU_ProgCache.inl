@@ -0,0 +1,178 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "PersistentCache.h"
+#include "VMManager.h"
+
+#include "fmt/format.h"
+
+//------------------------------------------------------------------
+// Micro VU - Persistent Program Cache
+//------------------------------------------------------------------
+// For every microProgram we record the start PC and pipeline state of each block compiled
+// for it, keyed by the same micro memory hash the program index uses. When a later session
+// creates a program for identical micro memory, all of those blocks are compiled up front
+// instead of one JIT exit at a time.
+
+enum : u32
+{
+	mVUprogCacheSignature = 0x47525056, // VPRG
+	mVUprogCacheVersion   = 2,
+	mVUprogCacheMaxBlocks = 1024, // Per program
+};
+
+// Defined in microVU.cpp, which includes this file through microVU.h
+static u64 mVUhashMicro(microVU& mVU, u32 startPC);
+
+struct microCachedProgHeader
+{
+	u64 hash;
+	u32 count;
+	u32 pad;
+};
+
+static bool mVUprogCacheLoad(microVU& mVU)
+{
+	microProgCache& cache = mVU.progCache;
+	PersistentCache::Reader reader;
+	if (!reader.Open(cache.path, mVUprogCacheSignature, mVUprogCacheVersion))
+		return false;
+
+	for (u32 i = 0; i < reader.GetCount(); i++)
+	{
+		microCachedProgHeader prog;
+		if (!reader.Read(&prog) || prog.count > mVUprogCacheMaxBlocks ||
+			!reader.ReadArray(&cache.progs[prog.hash], prog.count))
+		{
+			Console.Warning("microVU%d: Truncated program cache '%s'", mVU.index, cache.path.c_str());
+			cache.progs.clear();
+			return false;
+		}
+	}
+
+	DevCon.WriteLn(mVU.index ? Color_Orange : Color_Magenta, "microVU%d: Loaded %zu cached programs", mVU.index, cache.progs.size());
+	return true;
+}
+
+// Switches to the cache of the running game, the BIOS doesn't get one. Called on reset,
+// which every ELF load goes through, so the lookup stays off the program search path.
+void mVUprogCacheOpen(microVU& mVU)
+{
+	microProgCache& cache = mVU.progCache;
+	const u32 crc = VMManager::GetCurrentCRC();
+	if (crc == cache.crc)
+		return;
+
+	mVUprogCacheClose(mVU);
+	cache.crc = crc;
+	if (crc == 0)
+		return;
+
+	cache.path = PersistentCache::GetGamePath("vurec", VMManager::GetDiscSerial(), crc, fmt::format("_vu{}", mVU.index));
+	mVUprogCacheLoad(mVU);
+}
+
+// Remembers a block compiled for the current program
+void mVUprogCacheRecord(microVU& mVU, u32 startPC, const microRegInfo& pState)
+{
+	microProgCache& cache = mVU.progCache;
+	if (cache.replaying || cache.path.empty() || !mVU.prog.cur)
+		return;
+
+	std::vector<microCachedBlock>& blocks = cache.progs[mVU.prog.cur->hash];
+	if (blocks.size() >= mVUprogCacheMaxBlocks)
+		return;
+
+	for (const microCachedBlock& block : blocks)
+	{
+		if (block.startPC == startPC && !std::memcmp(&block.pState, &pState, sizeof(microRegInfo)))
+			return;
+	}
+
+	// Once the game writes micro memory the program no longer matches its hash, and blocks
+	// compiled from here on would be replayed against memory they weren't built from
+	if (mVUhashMicro(mVU, mVU.prog.cur->startPC) != mVU.prog.cur->hash)
+		return;
+
+	microCachedBlock& block = blocks.emplace_back();
+	std::memset(&block, 0, sizeof(block));
+	block.startPC = startPC;
+	std::memcpy(&block.pState, &pState, sizeof(microRegInfo));
+	cache.dirty = true;
+}
+
+// Compiles every block recorded for the current (freshly created) program
+void mVUprogCachePreload(microVU& mVU)
+{
+	microProgCache& cache = mVU.progCache;
+	if (cache.path.empty())
+		return;
+
+	auto it = cache.progs.find(mVU.prog.cur->hash);
+	if (it == cache.progs.end())
+		return;
+
+	// Compiling overwrites the pipeline state the dispatcher is about to use
+	microRegInfo lpState;
+	std::memcpy(&lpState, &mVU.prog.lpState, sizeof(microRegInfo));
+
+	cache.replaying = true;
+	u32 compiled = 0;
+	for (const microCachedBlock& block : it->second)
+	{
+		// Leave the safe zone for the block which is actually being asked for
+		if (armGetCurrentCodePointer() >= mVU.prog.x86end)
+			break;
+		if ((block.startPC & 7) || block.startPC > mVU.microMemSize - 8)
+			continue;
+
+		microRegInfo pState;
+		std::memcpy(&pState, &block.pState, sizeof(microRegInfo));
+		mVUblockFetch(mVU, block.startPC, (uptr)&pState);
+		compiled++;
+	}
+	cache.replaying = false;
+
+	std::memcpy(&mVU.prog.lpState, &lpState, sizeof(microRegInfo));
+	cache.preloadedProgs++;
+	cache.preloadedBlocks += compiled;
+}
+
+void mVUprogCacheSave(microVU& mVU)
+{
+	microProgCache& cache = mVU.progCache;
+	if (!cache.dirty || cache.path.empty())
+		return;
+
+	PersistentCache::Writer writer;
+	bool ok = writer.Open(cache.path, mVUprogCacheSignature, mVUprogCacheVersion, static_cast<u32>(cache.progs.size()));
+	for (auto it = cache.progs.begin(); ok && it != cache.progs.end(); ++it)
+	{
+		const microCachedProgHeader prog = {it->first, static_cast<u32>(it->second.size()), 0};
+		ok = (writer.Write(prog) && writer.WriteArray(it->second));
+	}
+	if (!ok)
+	{
+		Console.Error("microVU%d: Failed to write program cache '%s'", mVU.index, cache.path.c_str());
+		return;
+	}
+
+	DevCon.WriteLn(mVU.index ? Color_Orange : Color_Magenta, "microVU%d: Saved %zu cached programs [preloaded=%u blocks=%u]",
+		mVU.index, cache.progs.size(), cache.preloadedProgs, cache.preloadedBlocks);
+	cache.dirty = false;
+}
+
+void mVUprogCacheClose(microVU& mVU)
+{
+	microProgCache& cache = mVU.progCache;
+	mVUprogCacheSave(mVU);
+	cache.progs.clear();
+	cache.path.clear();
+	cache.crc = 0;
+	cache.dirty = false;
+	cache.replaying = false;
+	cache.preloadedProgs = 0;
+	cache.preloadedBlocks = 0;
+}
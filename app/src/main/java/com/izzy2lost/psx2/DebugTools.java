@@ -0,0 +1,117 @@
+package com.izzy2lost.psx2;
+
+import android.content.Intent;
+import android.text.TextUtils;
+import android.util.Log;
+import android.widget.Toast;
+
+// Developer tools driven through adb, for things which have no place in the regular UI:
+//   adb shell am start -n com.izzy2lost.psx2/.MainActivity -a com.izzy2lost.psx2.DEBUG_TOOL \
+//       --es tool gsdump --es path /sdcard/dumps/test.gs.zsc
+final class DebugTools {
+    static final String ACTION = "com.izzy2lost.psx2.DEBUG_TOOL";
+    private static final String TAG = "DebugTools";
+
+    private DebugTools() {}
+
+    // Returns true if the intent asked for a debug tool, whether or not it could be run
+    static boolean handleIntent(MainActivity activity, Intent intent) {
+        if (intent == null || !ACTION.equals(intent.getAction()))
+            return false;
+
+        String tool = intent.getStringExtra("tool");
+        if (TextUtils.isEmpty(tool)) {
+            Log.e(TAG, "No tool given");
+            return true;
+        }
+
+        switch (tool) {
+            case "gsdump":
+                bootGSDump(activity, intent);
+                break;
+            case "gsbench":
+                runGSDumpBenchmark(activity, intent);
+                break;
+            case "blockbench":
+                runGSBlockBenchmark(activity, intent);
+                break;
+            case "cdvdtrace":
+                runCdvdTraceReplay(activity, intent);
+                break;
+            default:
+                Log.e(TAG, "Unknown tool: " + tool);
+                break;
+        }
+        return true;
+    }
+
+    // Boots a GS dump, the quick actions drawer can then seek in it
+    private static void bootGSDump(MainActivity activity, Intent intent) {
+        String path = intent.getStringExtra("path");
+        if (TextUtils.isEmpty(path)) {
+            Log.e(TAG, "gsdump: missing path");
+            return;
+        }
+        Log.i(TAG, "gsdump: booting " + path);
+        activity.bootFile(path);
+    }
+
+    // Replays every dump in dump_dir through the SW and Null renderers, optionally comparing with a baseline:
+    //   --es tool gsbench --es dump_dir <dir> --es output_dir <dir> [--es baseline <summary.json>] [--ef threshold 5]
+    private static void runGSDumpBenchmark(MainActivity activity, Intent intent) {
+        String dumpDir = intent.getStringExtra("dump_dir");
+        String outputDir = intent.getStringExtra("output_dir");
+        if (TextUtils.isEmpty(dumpDir) || TextUtils.isEmpty(outputDir)) {
+            Log.e(TAG, "gsbench: missing dump_dir or output_dir");
+            return;
+        }
+        String baseline = intent.getStringExtra("baseline");
+        float threshold = intent.getFloatExtra("threshold", 5.0f);
+
+        activity.runOnEmuThread(() -> {
+            boolean ok = NativeApp.runGSDumpBenchmark(dumpDir, outputDir, baseline != null ? baseline : "", threshold);
+            report(activity, "gsbench", ok);
+        });
+    }
+
+    // Times the GS block swizzle kernels, the baseline can come from a build with GS_BLOCK_NEON_TBL set to 0:
+    //   --es tool blockbench --es output_dir <dir> [--es baseline <gsblock_summary.json>] [--ef threshold 5]
+    private static void runGSBlockBenchmark(MainActivity activity, Intent intent) {
+        String outputDir = intent.getStringExtra("output_dir");
+        if (TextUtils.isEmpty(outputDir)) {
+            Log.e(TAG, "blockbench: missing output_dir");
+            return;
+        }
+        String baseline = intent.getStringExtra("baseline");
+        float threshold = intent.getFloatExtra("threshold", 5.0f);
+
+        // Keep the emulator off the cores while timing
+        activity.runOnEmuThread(() -> {
+            boolean ok = NativeApp.runGSBlockBenchmark(outputDir, baseline != null ? baseline : "", threshold);
+            report(activity, "blockbench", ok);
+        });
+    }
+
+    // Replays a sector trace recorded with CdvdTraceReads against the same image, timings go to the log:
+    //   --es tool cdvdtrace --es iso <image> --es trace <trace>
+    private static void runCdvdTraceReplay(MainActivity activity, Intent intent) {
+        String iso = intent.getStringExtra("iso");
+        String trace = intent.getStringExtra("trace");
+        if (TextUtils.isEmpty(iso) || TextUtils.isEmpty(trace)) {
+            Log.e(TAG, "cdvdtrace: missing iso or trace");
+            return;
+        }
+
+        // The CDVD source is shared with the VM, so the game has to go first
+        activity.runOnEmuThread(() -> report(activity, "cdvdtrace", NativeApp.runCdvdTraceReplay(iso, trace)));
+    }
+
+    private static void report(MainActivity activity, String tool, boolean ok) {
+        String message = tool + (ok ? ": done" : ": failed, check the log");
+        if (ok)
+            Log.i(TAG, message);
+        else
+            Log.e(TAG, message);
+        activity.runOnUiThread(() -> Toast.makeText(activity, message, Toast.LENGTH_LONG).show());
+    }
+}
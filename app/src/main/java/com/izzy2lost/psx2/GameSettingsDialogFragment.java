@@ -392,9 +392,104 @@ public class GameSettingsDialogFragment extends DialogFragment {
             });
         }
 
+        // Compress image button wiring
+        com.google.android.material.button.MaterialButton btnCompress = view.findViewById(R.id.btn_compress_zst);
+        if (btnCompress != null) {
+            btnCompress.setOnClickListener(v -> new MaterialAlertDialogBuilder(ctx,
+                    com.google.android.material.R.style.ThemeOverlay_Material3_MaterialAlertDialog)
+                    .setCustomTitle(UiUtils.centeredDialogTitle(ctx, "Compress Disc Image"))
+                    .setMessage("Write a compressed .zst copy next to your games? The original is kept.")
+                    .setNegativeButton("Cancel", null)
+                    .setPositiveButton("Compress", (d, w) -> compressImage(ctx, gameUri))
+                    .show());
+        }
+
+        // Track hash button wiring, for checking the dump against redump
+        com.google.android.material.button.MaterialButton btnHash = view.findViewById(R.id.btn_verify_hash);
+        if (btnHash != null) {
+            btnHash.setOnClickListener(v -> {
+                btnHash.setEnabled(false);
+                android.widget.Toast.makeText(ctx, "Hashing disc image...", android.widget.Toast.LENGTH_SHORT).show();
+                new Thread(() -> {
+                    String[] lines = NativeApp.hashDiscImages(new String[]{gameUri});
+                    String text = formatTrackHashes(lines);
+                    if (!isAdded()) return;
+                    requireActivity().runOnUiThread(() -> {
+                        btnHash.setEnabled(true);
+                        new MaterialAlertDialogBuilder(ctx,
+                                com.google.android.material.R.style.ThemeOverlay_Material3_MaterialAlertDialog)
+                                .setCustomTitle(UiUtils.centeredDialogTitle(ctx, "Track Hashes"))
+                                .setMessage(text)
+                                .setPositiveButton("OK", null)
+                                .show();
+                    });
+                }).start();
+            });
+        }
+
         return builder.create();
     }
 
+    // Lines are "path|track|type|size|md5" per track, or "path|error|message"
+    private static String formatTrackHashes(String[] lines) {
+        if (lines == null || lines.length == 0) return "No tracks found";
+        StringBuilder sb = new StringBuilder();
+        for (String line : lines) {
+            String[] parts = line.split("\\|");
+            if (sb.length() > 0) sb.append("\n\n");
+            if (parts.length >= 3 && "error".equals(parts[parts.length - 2])) {
+                sb.append("Error: ").append(parts[parts.length - 1]);
+            } else if (parts.length >= 5) {
+                int n = parts.length;
+                sb.append("Track ").append(parts[n - 4]).append(" (").append(parts[n - 3]).append(", ")
+                        .append(parts[n - 2]).append(" bytes)\nMD5: ").append(parts[n - 1]);
+            } else {
+                sb.append(line);
+            }
+        }
+        return sb.toString();
+    }
+
+    // Converts the image to a seekable .zst in the games folder, on a worker thread since it takes a while
+    private static void compressImage(Context ctx, String gameUri) {
+        final Context appCtx = ctx.getApplicationContext();
+        final android.os.Handler ui = new android.os.Handler(android.os.Looper.getMainLooper());
+        try {
+            androidx.documentfile.provider.DocumentFile src = androidx.documentfile.provider.DocumentFile.fromSingleUri(appCtx, Uri.parse(gameUri));
+            String name = (src != null) ? src.getName() : null;
+            if (name == null || name.toLowerCase(java.util.Locale.ROOT).endsWith(".zst")) {
+                android.widget.Toast.makeText(appCtx, "Image is already compressed", android.widget.Toast.LENGTH_SHORT).show();
+                return;
+            }
+            String folderUri = appCtx.getSharedPreferences("app_prefs", Context.MODE_PRIVATE).getString("games_folder_uri", null);
+            androidx.documentfile.provider.DocumentFile folder = (folderUri != null) ? androidx.documentfile.provider.DocumentFile.fromTreeUri(appCtx, Uri.parse(folderUri)) : null;
+            int dot = name.lastIndexOf('.');
+            String outName = (dot > 0 ? name.substring(0, dot) : name) + ".zst";
+            if (folder == null || folder.findFile(outName) != null) {
+                android.widget.Toast.makeText(appCtx, "Cannot create " + outName + " in the games folder", android.widget.Toast.LENGTH_SHORT).show();
+                return;
+            }
+            androidx.documentfile.provider.DocumentFile dst = folder.createFile("application/octet-stream", outName);
+            if (dst == null) {
+                android.widget.Toast.makeText(appCtx, "Cannot create " + outName + " in the games folder", android.widget.Toast.LENGTH_SHORT).show();
+                return;
+            }
+
+            android.widget.Toast.makeText(appCtx, "Compressing " + name + " in background", android.widget.Toast.LENGTH_SHORT).show();
+            new Thread(() -> {
+                boolean ok = NativeApp.convertIsoToZstd(gameUri, dst.getUri().toString(), 9);
+                if (!ok) {
+                    try { dst.delete(); } catch (Throwable ignored) {}
+                }
+                ui.post(() -> android.widget.Toast.makeText(appCtx,
+                        ok ? "Created " + outName + ", rescan the games folder to see it" : "Compressing " + name + " failed",
+                        android.widget.Toast.LENGTH_LONG).show());
+            }).start();
+        } catch (Exception e) {
+            android.widget.Toast.makeText(appCtx, "Compress failed: " + e.getMessage(), android.widget.Toast.LENGTH_SHORT).show();
+        }
+    }
+
     private void saveGameSettings(String gameSerial, String gameCrc,
                                  int blendingAccuracy, int renderer, int resolution,
                                  boolean widescreenPatches, boolean noInterlacingPatches,
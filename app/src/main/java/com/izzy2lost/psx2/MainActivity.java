@@ -358,13 +358,30 @@ public class MainActivity extends AppCompatActivity implements GamesCoverDialogF
         }
     }
 
+    // Boots a file which isn't part of the games list, see DebugTools
+    public void bootFile(String path) {
+        if (TextUtils.isEmpty(path)) return;
+        m_szGamefile = path;
+        restartEmuThread();
+    }
+
+    // Runs a native tool in place of the emulation thread once the current game has shut down, see DebugTools
+    public void runOnEmuThread(Runnable task) {
+        stopEmuThread();
+        m_szGamefile = "";
+        mEmulationThread = new Thread(task);
+        mEmulationThread.start();
+    }
+
     private static final String[] GAME_EXTS = new String[]{
-            ".iso", ".bin", ".img", ".mdf", ".nrg", ".chd", ".cso", ".zso", ".gz"
+            ".iso", ".bin", ".img", ".mdf", ".nrg", ".chd", ".cso", ".zso", ".gz", ".zst"
     };
 
     private static boolean hasGameExt(String name) {
         if (TextUtils.isEmpty(name)) return false;
         String lower = name.toLowerCase(Locale.ROOT);
+        // .zst is also used by GS dumps
+        if (lower.endsWith(".gs.zst")) return false;
         for (String ext : GAME_EXTS) {
             if (lower.endsWith(ext)) return true;
         }
@@ -487,6 +504,9 @@ public class MainActivity extends AppCompatActivity implements GamesCoverDialogF
         }
         updateUiForControllerPresence();
 
+        // Debug tools started through adb replace the normal startup flow
+        boolean debugToolStarted = DebugTools.handleIntent(this, getIntent());
+
         // Show first-run setup wizard if needed
         SharedPreferences prefs = getSharedPreferences("app_prefs", MODE_PRIVATE);
         boolean firstRunDone = prefs.getBoolean("first_run_done", false);
@@ -499,7 +519,7 @@ public class MainActivity extends AppCompatActivity implements GamesCoverDialogF
             // Only auto-open games dialog if this is NOT the first boot after setup
             // (Setup wizard handles opening the games dialog on first completion)
             boolean hasOpenedGamesAfterSetup = prefs.getBoolean("has_opened_games_after_setup", false);
-            if (hasOpenedGamesAfterSetup) {
+            if (hasOpenedGamesAfterSetup && !debugToolStarted) {
                 try {
                     final View decor = (getWindow() != null) ? getWindow().getDecorView() : null;
                     if (decor != null) {
@@ -523,6 +543,13 @@ public class MainActivity extends AppCompatActivity implements GamesCoverDialogF
         addPictureInPictureSupport();
     }
     
+    @Override
+    protected void onNewIntent(Intent intent) {
+        super.onNewIntent(intent);
+        setIntent(intent);
+        DebugTools.handleIntent(this, intent);
+    }
+
     @Override
     protected void onUserLeaveHint() {
         super.onUserLeaveHint();
@@ -1640,9 +1667,7 @@ public class MainActivity extends AppCompatActivity implements GamesCoverDialogF
         }
     }
 
-    private void restartEmuThread() {
-        // Ensure BIOS present before starting/restarting emulation
-        if (!ensureBiosOrPrompt()) return;
+    private void stopEmuThread() {
         NativeApp.shutdown();
         if (mEmulationThread != null) {
             try {
@@ -1651,6 +1676,12 @@ public class MainActivity extends AppCompatActivity implements GamesCoverDialogF
             }
             catch (InterruptedException ignored) {}
         }
+    }
+
+    private void restartEmuThread() {
+        // Ensure BIOS present before starting/restarting emulation
+        if (!ensureBiosOrPrompt()) return;
+        stopEmuThread();
         
         // Apply global renderer setting before starting new game
         SharedPreferences prefs = getSharedPreferences("app_prefs", MODE_PRIVATE);
@@ -2486,6 +2517,15 @@ public class MainActivity extends AppCompatActivity implements GamesCoverDialogF
         } catch (Exception e) {
             android.util.Log.e("DrawerTracking", "Error refreshing drawer settings: " + e.getMessage());
         }
+
+        // Seeking only works for dumps with a frame index
+        try {
+            View btnDumpSeek = findViewById(R.id.right_drawer_btn_gs_dump_seek);
+            if (btnDumpSeek != null) {
+                boolean canSeek = isThread() && NativeApp.getGSDumpFrameCount() > 0;
+                btnDumpSeek.setVisibility(canSeek ? View.VISIBLE : View.GONE);
+            }
+        } catch (Throwable ignored) {}
         
         // Drawer opened, pause the game
         try {
@@ -2593,6 +2633,19 @@ public class MainActivity extends AppCompatActivity implements GamesCoverDialogF
                     });
                 }
 
+                // Seek GS Dump button, only shown while a seekable dump is playing
+                View btnDumpSeek = rightDrawer.findViewById(R.id.right_drawer_btn_gs_dump_seek);
+                if (btnDumpSeek != null) {
+                    btnDumpSeek.setOnClickListener(v -> {
+                        try {
+                            // Close right drawer first
+                            DrawerLayout drawer = findViewById(R.id.drawer_layout);
+                            if (drawer != null) drawer.closeDrawer(androidx.core.view.GravityCompat.END);
+                            showGSDumpSeekDialog();
+                        } catch (Throwable ignored) {}
+                    });
+                }
+
                 // Exit Game button (open games dialog)
                 View btnExitGame = rightDrawer.findViewById(R.id.right_drawer_btn_exit_game);
                 if (btnExitGame != null) {
@@ -2655,6 +2708,29 @@ public class MainActivity extends AppCompatActivity implements GamesCoverDialogF
         } catch (Throwable ignored) {}
     }
 
+    private void showGSDumpSeekDialog() {
+        int frameCount = NativeApp.getGSDumpFrameCount();
+        if (frameCount <= 0) return;
+
+        android.widget.EditText input = new android.widget.EditText(this);
+        input.setInputType(android.text.InputType.TYPE_CLASS_NUMBER);
+        input.setText(String.valueOf(Math.max(NativeApp.getGSDumpFrameNumber(), 0)));
+        input.selectAll();
+
+        new MaterialAlertDialogBuilder(this)
+                .setTitle("Seek GS Dump")
+                .setMessage("Frame (0 - " + (frameCount - 1) + ")")
+                .setView(input)
+                .setNegativeButton("Cancel", null)
+                .setPositiveButton("Seek", (d,w) -> {
+                    try {
+                        int frame = Integer.parseInt(input.getText().toString().trim());
+                        NativeApp.seekGSDump(Math.min(frame, frameCount - 1));
+                    } catch (NumberFormatException ignored) {}
+                })
+                .show();
+    }
+
     // Picture-in-Picture support methods
     
     public void enterPictureInPictureMode() {
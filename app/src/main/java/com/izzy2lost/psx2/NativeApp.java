@@ -174,10 +174,25 @@ public class NativeApp {
 	public static native void onNativeSurfaceDestroyed();
 
     public static native boolean runVMThread(String path);
+    // Replays every GS dump in dumpDir through the SW and Null renderers, results go to outputDir.
+    public static native boolean runGSDumpBenchmark(String dumpDir, String outputDir, String baselinePath, float thresholdPercent);
+    // Times every GS block swizzle kernel in GB/s, the summary goes to outputDir.
+    public static native boolean runGSBlockBenchmark(String outputDir, String baselinePath, float thresholdPercent);
+    // Replays a sector trace recorded with CdvdTraceReads against isoPath, timings go to the log.
+    public static native boolean runCdvdTraceReplay(String isoPath, String tracePath);
+    // Rewrites any supported disc image as a seekable .zst, blocks until done. Level is the zstd level.
+    public static native boolean convertIsoToZstd(String srcPath, String dstPath, int level);
+    // Hashes the images in parallel, blocks until done. Returns "path|track|type|size|md5" per track,
+    // or "path|error|message" for images which couldn't be hashed.
+    public static native String[] hashDiscImages(String[] paths);
 
 	public static native void pause();
 	public static native void resume();
 	public static native boolean isPaused();
+	// Only valid while a GS dump is booted. Frame count is 0 for dumps without a frame index.
+	public static native boolean seekGSDump(int frame);
+	public static native int getGSDumpFrameNumber();
+	public static native int getGSDumpFrameCount();
 	public static native void shutdown();
 
 	public static native boolean saveStateToSlot(int slot);